@@ -0,0 +1,187 @@
+/**
+ * \file AffineGap.c
+ * \brief linear space algorithm of Gotoh that computes only the distance between two genetic sequences with affine gaps
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see AffineGap.h
+ */
+
+#include "AffineGap.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "Scoring.h" /* costs of the operations */
+#include "Tuning.h" /* width of the strips */
+#include "Progress.h" /* count of the cells computed */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+/** \def GOTOH_BASES
+ * \brief number of rows of the profile: one per base ADENINE .. UNKOWN_BASE
+ */
+#define GOTOH_BASES (UNKOWN_BASE - ADENINE + 1)
+
+/*
+ * static double Gotoh_Infinity(size_t m, size_t n)
+ * \brief value of the cells out of the table (E on row 0, F on column 0): larger than every cell and every sum
+ * computed from a cell for sequences of m and n bases (a cell is at most 2 gap_open + indel (m + n), all the bases
+ * deleted then inserted)
+ */
+static double Gotoh_Infinity(size_t m, size_t n)
+{
+   long max_sub = 0 ;
+   for (int x = ADENINE; x <= UNKOWN_BASE; ++x)
+      for (int y = ADENINE; y <= UNKOWN_BASE; ++y)
+         if (_scoring.sub[x][y] > max_sub) max_sub = _scoring.sub[x][y] ;
+   double bound = 2.0 * _scoring.gap_open + (double) _scoring.indel * ((double) m + (double) n) ;
+   return bound + _scoring.gap_open + _scoring.indel + max_sub + 1 ;
+}
+
+/* EditDistance_Gotoh_width : cf .h for specification
+ */
+int EditDistance_Gotoh_width(size_t m, size_t n)
+{
+   double infinity = Gotoh_Infinity( m, n ) ;
+   return (infinity <= INT16_MAX) ? 2 : (infinity <= INT32_MAX) ? 4 : 8 ;
+}
+
+/*
+ * static void Gotoh_Down(void *H, void *E, void *T, const void *P, size_t w, long open, long indel, int width)
+ * \brief first half of a row of a strip of w columns: E(i,.) and min( H(i-1,.-1) + sub, E(i,.) ) in T,
+ * H being the row i-1 (H[0]: the column on the left of the strip), P the costs of the substitutions of x_i
+ *
+ * No cell depends on another one of the row: the loop is vectorized.
+ */
+CELL_KERNEL void Gotoh_Down(void *restrict H, void *restrict E, void *restrict T, const void *restrict P, size_t w,
+                            long open, long indel, int width)
+{
+   for (size_t j = 1; j <= w; ++j)
+   {  long e = Cell_get( E, j, width ) ;
+      long up = Cell_get( H, j, width ) + open ;
+      e = ((up < e) ? up : e) + indel ;
+      Cell_set( E, j, width, e ) ;
+      long diag = Cell_get( H, j-1, width ) + Cell_get( P, j-1, width ) ;
+      Cell_set( T, j, width, (diag < e) ? diag : e ) ;
+   }
+}
+
+/*
+ * static void Gotoh_Strip(const struct PackedSequence *X, size_t m, const void *profile, size_t n, size_t c0, size_t w,
+ *                         void *colH, void *colF, void *rows, long infinity, int width)
+ * \brief sweeps the columns c0+1 .. c0+w of the table row by row
+ * \param profile : profile[b*n + j], the cost of the substitution of the base ADENINE+b by y_(j+1)
+ * \param colH, colF : H(i,c0) and F(i,c0) for i = 0..m, replaced by H(i,c0+w) and F(i,c0+w)
+ * \param rows : 3 (w+1) cells, for the rows H, E and T of the strip
+ *
+ * F is the minimum of the gaps opened on the left, F(i,j) = indel j + min( F(i,c0), min_k H(i,k) - indel k + gap_open ),
+ * c0 <= k < j; as H(i,k) is T(i,k) or F(i,k) and gap_open >= 0, the minimum is the same on T(i,k) (H(i,c0) for k = c0):
+ * each cell only adds one minimum to the chain of dependencies of the scan, instead of an addition and two minima.
+ */
+CELL_KERNEL void Gotoh_Strip(const struct PackedSequence *X, size_t m, const void *profile, size_t n, size_t c0, size_t w,
+                             void *colH, void *colF, void *rows, long infinity, int width)
+{
+   const long open = _scoring.gap_open, indel = _scoring.indel ;
+   char *H = (char *) rows, *E = H + (w+1) * width, *T = E + (w+1) * width ;
+   for (size_t j = 0; j <= w; ++j)
+   {  Cell_set( H, j, width, (c0 + j == 0) ? 0 : open + indel * (long) (c0 + j) ) ; /* row 0 */
+      Cell_set( E, j, width, infinity ) ;
+   }
+   Cell_set( colH, 0, width, Cell_get( H, w, width ) ) ;
+   for (size_t i = 1; i <= m; ++i)
+   {  const char *P = (const char *) profile + ((size_t) (Packed_base( X, i-1 ) - ADENINE) * n + c0) * width ;
+      Gotoh_Down( H, E, T, P, w, open, indel, width ) ;
+      long g = Cell_get( colF, i, width ) ; /* F(i,c0+j) - indel j */
+      long prev = Cell_get( colH, i, width ) ; /* T(i,c0+j-1) - indel (j-1), H(i,c0) for j = 1 */
+      Cell_set( H, 0, width, prev ) ;
+      for (size_t j = 1; j <= w; ++j) /* F(i,j) depends on the cells on its left: scan of the row */
+      {  long t = Cell_get( T, j, width ) ;
+         long gap = prev + open ;
+         g = (gap < g) ? gap : g ;
+         long f = g + indel * (long) j ;
+         Cell_set( H, j, width, (t < f) ? t : f ) ;
+         prev = t - indel * (long) j ;
+      }
+      Cell_set( colH, i, width, Cell_get( H, w, width ) ) ;
+      Cell_set( colF, i, width, g + indel * (long) w ) ;
+      Progress_cells( w ) ;
+   }
+}
+
+/* Gotoh_Strip on cells of 2, 4 and 8 bytes, each compiled for several instruction sets */
+SIMD_CLONES
+static void Gotoh_Strip2(const struct PackedSequence *X, size_t m, const void *profile, size_t n, size_t c0, size_t w,
+                         void *colH, void *colF, void *rows, long infinity)
+{
+   Gotoh_Strip( X, m, profile, n, c0, w, colH, colF, rows, infinity, 2 ) ;
+}
+
+SIMD_CLONES
+static void Gotoh_Strip4(const struct PackedSequence *X, size_t m, const void *profile, size_t n, size_t c0, size_t w,
+                         void *colH, void *colF, void *rows, long infinity)
+{
+   Gotoh_Strip( X, m, profile, n, c0, w, colH, colF, rows, infinity, 4 ) ;
+}
+
+SIMD_CLONES
+static void Gotoh_Strip8(const struct PackedSequence *X, size_t m, const void *profile, size_t n, size_t c0, size_t w,
+                         void *colH, void *colF, void *rows, long infinity)
+{
+   Gotoh_Strip( X, m, profile, n, c0, w, colH, colF, rows, infinity, 8 ) ;
+}
+
+/* EditDistance_Gotoh_Packed : main function, cf .h for specification.
+ * The longest sequence X is on the rows, read base by base in its packed form; the shortest one Y is unpacked
+ * once in the slot 3 to build the profile (slot 0). The slot 1 holds the boundary column, the slot 2 the rows of a strip.
+ */
+long EditDistance_Gotoh_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   const struct PackedSequence *X = (A->length >= B->length) ? A : B ; /* X is the longest sequence, Y the shortest */
+   const struct PackedSequence *Y = (A->length >= B->length) ? B : A ;
+   size_t m = X->length, n = Y->length ;
+   int width = EditDistance_Gotoh_width( m, n ) ;
+   long infinity = (long) Gotoh_Infinity( m, n ) ;
+   size_t tile = _tuning.par_tile ;
+
+   unsigned char *Yb = (unsigned char *) Workspace_get( ws, 3, n + 1 ) ;
+   Packed_unpack( Y, 0, n, Yb ) ;
+   void *profile = Workspace_get( ws, 0, (GOTOH_BASES * n + 1) * width ) ;
+   for (int b = 0; b < GOTOH_BASES; ++b)
+      for (size_t j = 0; j < n; ++j) Cell_set( profile, b * n + j, width, _scoring.sub[ADENINE + b][Yb[j]] ) ;
+   char *colH = (char *) Workspace_get( ws, 1, 2 * (m + 1) * width ) ;
+   char *colF = colH + (m + 1) * width ;
+   for (size_t i = 0; i <= m; ++i) /* column 0 */
+   {  Cell_set( colH, i, width, (i == 0) ? 0 : _scoring.gap_open + _scoring.indel * (long) i ) ;
+      Cell_set( colF, i, width, infinity ) ;
+   }
+   void *rows = Workspace_get( ws, 2, 3 * (tile + 1) * width ) ;
+   PerfCounters_phase( PERF_FILL ) ;
+
+   for (size_t c0 = 0; c0 < n; c0 += tile)
+   {  size_t w = (n - c0 < tile) ? n - c0 : tile ;
+      switch (width)
+      {  case 2 :  Gotoh_Strip2( X, m, profile, n, c0, w, colH, colF, rows, infinity ) ; break ;
+         case 4 :  Gotoh_Strip4( X, m, profile, n, c0, w, colH, colF, rows, infinity ) ; break ;
+         default : Gotoh_Strip8( X, m, profile, n, c0, w, colH, colF, rows, infinity ) ; break ;
+      }
+   }
+   return Cell_get( colH, m, width ) ;
+}
+
+/* EditDistance_Gotoh : cf .h for specification
+ */
+long EditDistance_Gotoh(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_Gotoh_Packed( &X, &Y, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
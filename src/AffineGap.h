@@ -0,0 +1,57 @@
+/**
+ * \file AffineGap.h
+ * \brief linear space algorithm of Gotoh that computes only the distance between two genetic sequences with affine gaps
+ * \version 0.1
+ * \date 17/10/2026
+ */
+
+#include "Globals.h" /* have all the cost definitions */
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/********************************************************************************
+ *  Affine gaps (Gotoh), linear space, by strips of columns
+ */
+/**
+ * \fn long EditDistance_Gotoh(char* A, size_t lengthA, char* B, size_t lengthB);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1], a gap of k bases
+ * costing _scoring.gap_open + k * _scoring.indel (cf Scoring.h)
+ * \param A  : array of char representing a genetic sequence A
+ * \param lengthA :  number of elements in A
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B
+ * \return :  edit distance between A and B with affine gaps
+ *
+ * EditDistance_Gotoh fills the three tables of Gotoh (1982): H(i,j) the distance, E(i,j) the distances ending
+ * by a gap in B (vertical) and F(i,j) the distances ending by a gap in A (horizontal):
+ *    E(i,j) = min( E(i-1,j), H(i-1,j) + gap_open ) + indel
+ *    F(i,j) = min( F(i,j-1), H(i,j-1) + gap_open ) + indel
+ *    H(i,j) = min( H(i-1,j-1) + sub[x_i][y_j], E(i,j), F(i,j) )
+ * As EditDistance_CA, the table is cut in strips of _tuning.par_tile columns (cf Tuning.h), swept row by row,
+ * the rows of the 3 tables in the strip staying in the L1 cache; only the column of H and F on the boundary
+ * of two strips is kept, and the memory used is O(lengthA + lengthB).
+ * E and the candidates of H by the diagonal and by E are computed for a whole row of the strip at once,
+ * in a loop without dependency between the cells that the compiler vectorizes (instruction set chosen at load time);
+ * the costs of the substitutions are read in a profile of the columns (one row per base, Rognes and Seeberg 2000).
+ * F, which depends on the cell on its left, is then computed by a scan of the row.
+ * The cells are on 2, 4 or 8 bytes, the smallest width that holds the distances (cf CellWidth.h),
+ * so that the vectors hold 16, 8 or 4 cells (AVX2).
+ * With gap_open = 0, the distance is the one of the other engines.
+ *
+ * If lengthA < lengthB, the sequences A and B are swapped.
+ */
+long EditDistance_Gotoh(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_Gotoh_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_Gotoh on sequences already packed (cf Packed_init), the buffers being taken
+ * in ws (slots 0 to 3) instead of allocated and freed
+ */
+long EditDistance_Gotoh_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn int EditDistance_Gotoh_width(size_t m, size_t n);
+ * \brief the width in bytes (2, 4 or 8) of the cells of EditDistance_Gotoh for sequences of m and n bases,
+ * with the costs of _scoring
+ */
+int EditDistance_Gotoh_width(size_t m, size_t n);
@@ -0,0 +1,215 @@
+/**
+ * \file Anchored.c
+ * \brief distance between two similar genetic sequences, computed by the DP between anchors (exact matches) and
+ * checked in the band of its bound
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Anchored.h
+ */
+
+#include "Anchored.h"
+#include "LinearSpace.h" /* the DP of the gaps */
+#include "Banded.h" /* the check in the band of the bound */
+#include "Scoring.h" /* costs of the operations */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "characters_to_base.h" /* enum Base */
+
+/** \def ANCHOR_GAP_FRACTION
+ * \brief the anchors are not used if the tables of the gaps have more than 1/ANCHOR_GAP_FRACTION of the cells of the table
+ */
+#define ANCHOR_GAP_FRACTION 4
+
+/**
+ * \struct AnchorSeed
+ * \brief a k-mer of Y in the hash table: its occurrences in Y and in X, and the last one of each
+ */
+struct AnchorSeed
+{  uint64_t kmer ;     /*!< the bases, 2 bits each (ADENINE 0 .. THYMINE 3) */
+   size_t y ;          /*!< position of its last occurrence in Y */
+   size_t x ;          /*!< position of its last occurrence in X */
+   uint32_t count_y ;  /*!< occurrences in Y, 0 for an empty entry */
+   uint32_t count_x ;  /*!< occurrences in X */
+} ;
+
+/**
+ * \struct AnchorSegment
+ * \brief X[x .. x+length-1] = Y[y .. y+length-1]
+ */
+struct AnchorSegment
+{  size_t x, y, length ;
+} ;
+
+/* EditDistance_Anchored_available : cf .h for specification
+ */
+int EditDistance_Anchored_available(void)
+{
+   if (_scoring.gap_open != 0) return 0 ;
+   for (int b = ADENINE; b <= THYMINE; ++b)
+      if (_scoring.sub[b][b] != 0) return 0 ;
+   return 1 ;
+}
+
+/* adds the base i of ps to the k-mer kmer (of run bases since the last N or U); 1 iff it is then a k-mer ending at i */
+static inline int Anchored_Roll(const struct PackedSequence *ps, size_t i, int k, uint64_t mask, uint64_t *kmer, int *run)
+{
+   int b = Packed_base( ps, i ) ;
+   if (b > THYMINE) { *run = 0 ; return 0 ; } /* no seed across a rare base */
+   *kmer = ((*kmer << 2) | (uint64_t) (b - ADENINE)) & mask ;
+   if (*run < k) ++*run ;
+   return *run == k ;
+}
+
+/* the entry of kmer in the table of 2^bits entries: the one of kmer, or the empty one where to insert it */
+static inline struct AnchorSeed *Anchored_Find(struct AnchorSeed *table, int bits, uint64_t kmer)
+{
+   size_t mask = ((size_t) 1 << bits) - 1 ;
+   size_t h = (size_t) ((kmer * 0x9E3779B97F4A7C15ULL) >> (64 - bits)) ;
+   while ((table[h].count_y != 0) && (table[h].kmer != kmer)) h = (h + 1) & mask ;
+   return &table[h] ;
+}
+
+/* the seeds of X and Y: the k-mers that occur once in each, by increasing x; their number in *count */
+static struct AnchorSegment *Anchored_Seeds(const struct PackedSequence *X, const struct PackedSequence *Y, int k, size_t *count)
+{
+   uint64_t mask = (k == 32) ? ~(uint64_t) 0 : ((uint64_t) 1 << (2 * k)) - 1 ;
+   int bits = 4 ;
+   while (((size_t) 1 << bits) < 2 * Y->length) ++bits ; /* load factor <= 1/2 */
+   struct AnchorSeed *table = (struct AnchorSeed *) calloc( (size_t) 1 << bits, sizeof(struct AnchorSeed) ) ;
+   struct AnchorSegment *seeds = (struct AnchorSegment *) malloc( (X->length + 1) * sizeof(struct AnchorSegment) ) ;
+   if ((table == NULL) || (seeds == NULL)) { perror("EditDistance_Anchored: malloc of the seeds"); exit(EXIT_FAILURE); }
+
+   uint64_t kmer = 0 ;
+   int run = 0 ;
+   for (size_t j = 0; j < Y->length; ++j)
+      if (Anchored_Roll( Y, j, k, mask, &kmer, &run ))
+      {  struct AnchorSeed *s = Anchored_Find( table, bits, kmer ) ;
+         s->kmer = kmer ;
+         s->y = j + 1 - k ;
+         ++s->count_y ;
+      }
+   kmer = 0 ;
+   run = 0 ;
+   for (size_t i = 0; i < X->length; ++i)
+      if (Anchored_Roll( X, i, k, mask, &kmer, &run ))
+      {  struct AnchorSeed *s = Anchored_Find( table, bits, kmer ) ;
+         if (s->count_y == 0) continue ;
+         s->x = i + 1 - k ;
+         ++s->count_x ;
+      }
+   /* second pass on X: the seeds by increasing x */
+   *count = 0 ;
+   kmer = 0 ;
+   run = 0 ;
+   for (size_t i = 0; i < X->length; ++i)
+      if (Anchored_Roll( X, i, k, mask, &kmer, &run ))
+      {  struct AnchorSeed *s = Anchored_Find( table, bits, kmer ) ;
+         if ((s->count_y == 1) && (s->count_x == 1))
+            seeds[(*count)++] = (struct AnchorSegment) { s->x, s->y, (size_t) k } ;
+      }
+   free( table ) ;
+   return seeds ;
+}
+
+/* the anchors of X and Y: the longest co-linear chain of the seeds, merged into segments shortened by k bases on
+ * each side, by increasing x and y; their number in *count
+ */
+static struct AnchorSegment *Anchored_Chain(const struct PackedSequence *X, const struct PackedSequence *Y, int k, size_t *count)
+{
+   size_t nseeds ;
+   struct AnchorSegment *seed = Anchored_Seeds( X, Y, k, &nseeds ) ;
+   /* longest chain increasing in y (x increases already), in O(nseeds log nseeds):
+    * tail[l] = the seed ending the chains of l+1 seeds with the smallest y, prev[s] = the seed before s */
+   size_t *tail = (size_t *) malloc( (nseeds + 1) * sizeof(size_t) ) ;
+   size_t *prev = (size_t *) malloc( (nseeds + 1) * sizeof(size_t) ) ;
+   if ((tail == NULL) || (prev == NULL)) { perror("EditDistance_Anchored: malloc of the chain"); exit(EXIT_FAILURE); }
+   size_t length = 0 ;
+   for (size_t s = 0; s < nseeds; ++s)
+   {  size_t lo = 0, hi = length ;
+      while (lo < hi)
+      {  size_t mid = (lo + hi) / 2 ;
+         if (seed[tail[mid]].y < seed[s].y) lo = mid + 1 ; else hi = mid ;
+      }
+      prev[s] = (lo > 0) ? tail[lo - 1] : SIZE_MAX ;
+      tail[lo] = s ;
+      if (lo == length) ++length ;
+   }
+   /* the chain, in the order of x, in tail[0 .. length-1] */
+   size_t s = (length > 0) ? tail[length - 1] : SIZE_MAX ;
+   for (size_t l = length; l > 0; --l) { tail[l - 1] = s ; s = prev[s] ; }
+
+   /* segments: the seeds of a diagonal that overlap or touch are merged, a seed that overlaps the previous segment
+    * on another diagonal is dropped */
+   size_t nsegments = 0 ;
+   struct AnchorSegment *segment = seed ; /* in place: nsegments <= l */
+   for (size_t l = 0; l < length; ++l)
+   {  struct AnchorSegment c = seed[tail[l]] ;
+      struct AnchorSegment *last = (nsegments > 0) ? &segment[nsegments - 1] : NULL ;
+      if ((last != NULL) && (last->y - last->x == c.y - c.x) && (c.x <= last->x + last->length))
+         last->length = c.x + c.length - last->x ;
+      else if ((last == NULL) || ((c.x >= last->x + last->length) && (c.y >= last->y + last->length)))
+         segment[nsegments++] = c ;
+   }
+   free( tail ) ;
+   free( prev ) ;
+
+   /* the margins of k bases on each side are left to the DP of the gaps */
+   *count = 0 ;
+   for (size_t g = 0; g < nsegments; ++g)
+      if (segment[g].length > 2 * (size_t) k)
+         segment[(*count)++] = (struct AnchorSegment) { segment[g].x + k, segment[g].y + k, segment[g].length - 2 * k } ;
+   return segment ;
+}
+
+/* distance between X[0 .. m-1] and Y[0 .. n-1] (bases), 0 or 1 of them possibly empty */
+static long Anchored_Gap(const unsigned char *X, size_t m, const unsigned char *Y, size_t n, struct Workspace *ws)
+{
+   if ((m == 0) || (n == 0)) return _scoring.indel * (long) (m + n) ;
+   return EditDistance_LS_Bases( X, m, Y, n, ws ) ;
+}
+
+/* EditDistance_Anchored_Packed : cf .h for specification
+ */
+long EditDistance_Anchored_Packed(const struct PackedSequence *X, const struct PackedSequence *Y, int k,
+                                  enum Engine engine, long max_distance, int nthreads, struct Workspace *ws)
+{
+   size_t m = X->length, n = Y->length ;
+   if (! EditDistance_Anchored_available() || (m < (size_t) k) || (n < (size_t) k))
+      return Engine_distance( engine, X, Y, max_distance, nthreads, ws ) ;
+
+   size_t count ;
+   struct AnchorSegment *anchor = Anchored_Chain( X, Y, k, &count ) ;
+   double cells = 0 ; /* of the tables of the gaps */
+   for (size_t a = 0, px = 0, py = 0; a <= count; ++a)
+   {  size_t sx = (a < count) ? anchor[a].x : m, sy = (a < count) ? anchor[a].y : n ;
+      cells += (double) (sx - px) * (double) (sy - py) ;
+      if (a < count) { px = sx + anchor[a].length ; py = sy + anchor[a].length ; }
+   }
+   if (cells * ANCHOR_GAP_FRACTION > (double) m * (double) n)
+   {  free( anchor ) ;
+      return Engine_distance( engine, X, Y, max_distance, nthreads, ws ) ;
+   }
+
+   /* the bound: the DP of the gaps, in the slot 1 of ws */
+   unsigned char *Xb = (unsigned char *) Workspace_get( ws, 0, m + 1 ) ;
+   unsigned char *Yb = (unsigned char *) Workspace_get( ws, 3, n + 1 ) ;
+   Packed_unpack( X, 0, m, Xb ) ;
+   Packed_unpack( Y, 0, n, Yb ) ;
+   long bound = 0 ;
+   for (size_t a = 0, px = 0, py = 0; a <= count; ++a)
+   {  size_t sx = (a < count) ? anchor[a].x : m, sy = (a < count) ? anchor[a].y : n ;
+      bound += Anchored_Gap( Xb + px, sx - px, Yb + py, sy - py, ws ) ;
+      if (a < count) { px = sx + anchor[a].length ; py = sy + anchor[a].length ; }
+   }
+   free( anchor ) ;
+
+   /* the check: the distance is at most bound, so exact in its band */
+   if ((max_distance >= 0) && (max_distance < bound)) bound = max_distance ;
+   if ((double) bound / (double) _scoring.indel * 2 + 1 >= (double) ((m < n) ? m : n))
+      return Engine_distance( engine, X, Y, max_distance, nthreads, ws ) ;
+   return Engine_distance( ENGINE_BANDED, X, Y, bound, 1, ws ) ;
+}
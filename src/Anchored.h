@@ -0,0 +1,61 @@
+/**
+ * \file Anchored.h
+ * \brief distance between two similar genetic sequences, computed by the DP between anchors (exact matches) and
+ * checked in the band of its bound
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Two genomes of the same species (eg tests/ba52_recent_omicron.fasta and tests/wuhan_hu_1.fasta) are more than 99%
+ * identical: most of their bases are long exact matches, at the same place on both. EditDistance_Anchored:
+ *    - seeds: finds the k-mers (k bases A, C, G or T) that occur once in each sequence, by a hash table of the k-mers
+ *      of Y;
+ *    - chain: keeps the longest co-linear chain of these seeds (increasing in X and in Y), and merges its seeds
+ *      of the same diagonal into segments of exact matches, the anchors;
+ *    - gaps: computes by EditDistance_LS_Bases the distance between the bases of X and Y between two anchors, each anchor
+ *      being shortened by a margin of k bases on each side, left to the DP of the gaps; the sum of these distances
+ *      (the anchors cost 0) is the cost of one alignment: a bound U on the distance, tight if the anchors are
+ *      on an optimal alignment;
+ *    - check: the distance is at most U, so it is computed exactly by EditDistance_Banded with the bound U, in the
+ *      band of about U/indel diagonals that contains all the alignments of cost <= U.
+ * The table is thus computed on the gaps and on the band only: O((m + n) U / indel) instead of O(m n).
+ * If the anchors do not bound the distance well (few anchors, the gaps cover a quarter of the table, or the band
+ * is as wide as the table), the distance is computed by the engine given, on the whole table.
+ */
+
+#ifndef __ANCHORED_h__
+#define __ANCHORED_h__
+
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "Engine.h" /* the engine of the whole table */
+
+/** \def ANCHOR_K
+ * \brief default length of the seeds (distanceEdition --anchor)
+ */
+#define ANCHOR_K 20
+
+/** \def ANCHOR_K_MAX
+ * \brief longest seeds: a k-mer is a uint64_t of 2 bits per base
+ */
+#define ANCHOR_K_MAX 32
+
+/**
+ * \fn int EditDistance_Anchored_available(void)
+ * \brief 1 iff the costs of _scoring (cf Scoring.h) allow the anchors: linear gaps, and the match of two equal
+ * bases A, C, G or T costs 0
+ */
+int EditDistance_Anchored_available(void) ;
+
+/**
+ * \fn long EditDistance_Anchored_Packed(const struct PackedSequence *X, const struct PackedSequence *Y, int k, enum Engine engine, long max_distance, int nthreads, struct Workspace *ws)
+ * \brief computes the distance between X and Y from the anchors of seeds of k bases (cf above), or with engine (not
+ * ENGINE_AUTO) on the whole table if they do not bound it well, or if the costs do not allow them
+ * \param k : length of the seeds, 8 .. ANCHOR_K_MAX
+ * \param max_distance : if >= 0, DISTANCE_ABOVE_MAX (cf Banded.h) is returned when the distance exceeds it
+ * \param nthreads : number of threads (or processes) of engine
+ * \param ws : scratch buffers and arena of the calling thread
+ */
+long EditDistance_Anchored_Packed(const struct PackedSequence *X, const struct PackedSequence *Y, int k,
+                                  enum Engine engine, long max_distance, int nthreads, struct Workspace *ws) ;
+
+#endif /* __ANCHORED_h__ */
@@ -0,0 +1,73 @@
+/**
+ * \file Arena.c
+ * \brief one contiguous region for the tables of the dynamic programming, reused by successive computations
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Arena.h
+ */
+
+#include "Arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for memset */
+#include <unistd.h> /* for sysconf */
+#include <sys/mman.h> /* for mmap, madvise and munmap */
+
+/* below this number of bytes written by a previous computation, an array asked zeroed is cleared by memset;
+ * above, its whole pages are given back (MADV_DONTNEED) and are zero pages again on the next touch */
+#define ARENA_CLEAR_BY_PAGES (1UL << 20)
+
+void Arena_reserve(struct Arena *arena, size_t bytes)
+{
+   arena->used = 0 ;
+   if (bytes <= arena->size) return ;
+   size_t size = (bytes > 2 * arena->size) ? bytes : 2 * arena->size ; /* amortized growth */
+   size = (size >= ARENA_HUGE_PAGE) ? (size + ARENA_HUGE_PAGE - 1) & ~(ARENA_HUGE_PAGE - 1) : Arena_bytes( size ) ;
+   Arena_release( arena ) ; /* the content is not kept */
+   void *base = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 ) ;
+   if (base == MAP_FAILED) { perror("Arena_reserve: mmap" ); exit(EXIT_FAILURE); }
+#ifdef MADV_HUGEPAGE
+   if (size >= ARENA_HUGE_PAGE) madvise( base, size, MADV_HUGEPAGE ) ; /* only a hint: ignored if THP are disabled */
+#endif
+   arena->base = (char *) base ;
+   arena->size = size ;
+}
+
+/* sets base[begin .. end-1] to 0, knowing that the bytes from arena->dirty are already 0 */
+static void Arena_Clear(struct Arena *arena, size_t begin, size_t end)
+{
+   if (end > arena->dirty) end = arena->dirty ;
+   if (begin >= end) return ;
+   if (end - begin < ARENA_CLEAR_BY_PAGES)
+   {  memset( arena->base + begin, 0, end - begin ) ;
+      return ;
+   }
+   size_t page = (size_t) sysconf( _SC_PAGESIZE ) ;
+   size_t first = (begin + page - 1) & ~(page - 1), last = end & ~(page - 1) ;
+   memset( arena->base + begin, 0, first - begin ) ;
+   if (madvise( arena->base + first, last - first, MADV_DONTNEED ) != 0) memset( arena->base + first, 0, last - first ) ;
+   memset( arena->base + last, 0, end - last ) ;
+}
+
+void *Arena_alloc(struct Arena *arena, size_t bytes, int zero)
+{
+   size_t size = Arena_bytes( bytes ) ;
+   if (size > arena->size - arena->used)
+   {  fprintf( stderr, "Arena_alloc: %zu bytes exceed the %zu bytes reserved\n", size, arena->size - arena->used ) ;
+      exit(EXIT_FAILURE) ;
+   }
+   char *p = arena->base + arena->used ;
+   if (zero) Arena_Clear( arena, arena->used, arena->used + size ) ;
+   arena->used += size ;
+   if (arena->used > arena->dirty) arena->dirty = arena->used ;
+   return p ;
+}
+
+void Arena_release(struct Arena *arena)
+{
+   if (arena->base != NULL) munmap( arena->base, arena->size ) ;
+   arena->base = NULL ;
+   arena->size = arena->used = arena->dirty = 0 ;
+}
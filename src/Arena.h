@@ -0,0 +1,80 @@
+/**
+ * \file Arena.h
+ * \brief one contiguous region for the tables of the dynamic programming, reused by successive computations
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The full table engines used to allocate their table as M+1 rows by malloc, each one initialized by a loop.
+ * An arena is one anonymous mapping (mmap), advised for transparent huge pages (MADV_HUGEPAGE) when it is
+ * large enough: a computation reserves the bytes of all its arrays (Arena_reserve), then takes them one after
+ * the other (Arena_alloc), aligned on cache lines. The pages of a new mapping are zero pages, given on the first
+ * touch: an array that must start at 0 costs no initialization, and a page is placed on the NUMA node of the
+ * thread that first writes it (eg the worker that computes a tile). The mapping is kept for the next
+ * computation (eg of the same worker in batch mode, cf Workspace.h) and only grows; the bytes that a previous
+ * computation wrote are cleared again only for the arrays asked zeroed.
+ * An arena is not shared between computations running at the same time.
+ */
+
+#ifndef __ARENA_h__
+#define __ARENA_h__
+
+#include <stdlib.h> /* for size_t */
+
+/** \def ARENA_ALIGN
+ * \brief alignment of the arrays of an arena (a cache line)
+ */
+#define ARENA_ALIGN 64
+
+/** \def ARENA_HUGE_PAGE
+ * \brief size of a transparent huge page: the mappings of at least this size are rounded to it and advised MADV_HUGEPAGE
+ */
+#define ARENA_HUGE_PAGE (2UL << 20)
+
+/**
+ * \struct Arena
+ * \brief mapping base of size bytes, of which used are taken by the current computation
+ */
+struct Arena
+{  char *base ;   /*!< the mapping (NULL if none) */
+   size_t size ;  /*!< bytes of the mapping */
+   size_t used ;  /*!< bytes taken since Arena_reserve */
+   size_t dirty ; /*!< bytes base[0 .. dirty-1] that may have been written since the mapping (the others are zero) */
+} ;
+
+/**
+ * \def ARENA_INITIALIZER
+ * \brief empty arena (no mapping)
+ */
+#define ARENA_INITIALIZER { NULL, 0, 0, 0 }
+
+/**
+ * \fn size_t Arena_bytes(size_t bytes)
+ * \brief bytes rounded up to ARENA_ALIGN: what an array of bytes bytes takes in an arena
+ */
+static inline size_t Arena_bytes(size_t bytes)
+{
+   return (bytes + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1) ;
+}
+
+/**
+ * \fn void Arena_reserve(struct Arena *arena, size_t bytes)
+ * \brief starts a computation that takes at most bytes bytes (the sum of Arena_bytes of its arrays):
+ * the arrays of the previous computation are given back, and the mapping is replaced by a larger one if needed;
+ * exits on failure
+ */
+void Arena_reserve(struct Arena *arena, size_t bytes) ;
+
+/**
+ * \fn void *Arena_alloc(struct Arena *arena, size_t bytes, int zero)
+ * \brief the next array of bytes bytes of the computation, aligned on ARENA_ALIGN; all its bytes are 0 if zero,
+ * else its content is undefined
+ */
+void *Arena_alloc(struct Arena *arena, size_t bytes, int zero) ;
+
+/**
+ * \fn void Arena_release(struct Arena *arena)
+ * \brief unmaps the arena: it is then empty and may be reused
+ */
+void Arena_release(struct Arena *arena) ;
+
+#endif /* __ARENA_h__ */
@@ -0,0 +1,151 @@
+/**
+ * \file Banded.c
+ * \brief threshold-bounded algorithm that computes the distance between two genetic sequences 
+ * if it does not exceed a given bound
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Banded.h
+ */
+
+#include "Banded.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* CELL_KERNEL */
+#include "Scoring.h" /* costs of the operations */
+#include "Progress.h" /* count of the cells computed */
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <limits.h> 
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+/** \def BAND_INITIAL
+ * \brief number of diagonals added on each side of the band by the first pass
+ */
+#define BAND_INITIAL 64
+
+/** \def OUT_OF_BAND
+ * \brief value of the cells outside the band (larger than any distance, without overflow when adding costs)
+ */
+#define OUT_OF_BAND (LONG_MAX / 4)
+
+/*
+ * static long EditDistance_BandPass(const unsigned char *X, size_t m, const unsigned char *Y, size_t n, long t, long *row, enum ScoringModel model)
+ * \brief computes phi(m,n) if it is <= t, else returns a value > t 
+ * \param X, m : bases of the longest sequence (rows) 
+ * \param Y, n : bases of the shortest sequence (columns), n <= m
+ * \param t : bound, t >= indel * (m-n)
+ * \param row : array of at least t/indel + 3 elements
+ * \param model : model of _scoring, whose costs are used (a constant: the pass is specialized on it)
+ *
+ * Only diagonals lo <= j-i <= hi are computed with lo = n-m-e and hi = e, 
+ * e = (t/indel - (m-n)) / 2: outside, a path costs more than t.
+ * row[o] contains phi(i, i+lo+o), o = 0..hi-lo; row[-1] and row[hi-lo+1] stay out of band.
+ */
+CELL_KERNEL long EditDistance_BandPass(const unsigned char *X, size_t m, const unsigned char *Y, size_t n, long t, long *row,
+                                      enum ScoringModel model)
+{
+   const long indel = Scoring_indel( &_scoring, model ) ;
+   long e = (t / indel - (long) (m - n)) / 2 ;
+   long lo = (long) n - (long) m - e ;
+   long hi = e ;
+   long width = hi - lo + 1 ;
+
+   row[0] = OUT_OF_BAND ; /* row[-1] */
+   row++ ;
+   for (long o = 0; o <= width; ++o) /* row 0: phi(0,j) = indel * j for 0 <= j <= n */
+   {  long j = lo + o ;
+      row[o] = ((j >= 0) && (j <= (long) n) && (o < width)) ? indel * j : OUT_OF_BAND ;
+   }
+
+   for (size_t i = 1; i <= m; ++i)
+   {  enum Base x = X[i-1] ;
+      const long *sub_x = _scoring.sub[x] ;
+      long olo = -lo - (long) i ; /* offset of column j = 0 */
+      long ohi = (long) n - lo - (long) i ; /* offset of column j = n */
+      long first = (olo > 0) ? olo : 0 ;
+      long last = (ohi < width - 1) ? ohi : width - 1 ;
+      long row_min = OUT_OF_BAND ;
+      if (first == olo) /* column j = 0 is in the band */
+      {  row[first] = indel * (long) i ;
+         row_min = row[first] ;
+         first++ ;
+      }
+      else row[first-1] = OUT_OF_BAND ;
+      for (long o = first; o <= last; ++o)
+      {  enum Base y = Y[i + lo + o - 1] ;
+         long min = Scoring_cost( sub_x, model, x, y ) + row[o] ; /* initialization  with cas 1*/
+         { long cas2 = indel + row[o+1] ;      
+           if (cas2 < min) min = cas2 ;
+         }
+         { long cas3 = indel + row[o-1] ;      
+           if (cas3 < min) min = cas3 ; 
+         }
+         row[o] = min ;
+         if (min < row_min) row_min = min ;
+      }
+      if (last < width - 1) row[last+1] = OUT_OF_BAND ; /* beyond column n */
+      Progress_cells( last - first + 1 ) ;
+      if (row_min > t) return row_min ; /* early termination: every path costs more than t */
+   }
+   return row[(long) n - (long) m - lo] ;
+}
+
+/* EditDistance_Banded_Packed : cf .h for specification 
+ */
+long EditDistance_Banded_Packed(const struct PackedSequence *A, const struct PackedSequence *B, long max_distance, struct Workspace *ws)
+{
+   unsigned char *X = (unsigned char *) Workspace_get( ws, 0, A->length + 1 ) ;
+   unsigned char *Y = (unsigned char *) Workspace_get( ws, 1, B->length + 1 ) ;
+   Packed_unpack( A, 0, A->length, X ) ;
+   Packed_unpack( B, 0, B->length, Y ) ;
+   PerfCounters_phase( PERF_FILL ) ;
+   return EditDistance_Banded_Bases( X, A->length, Y, B->length, max_distance, ws ) ;
+}
+
+/* EditDistance_Banded_Bases : cf .h for specification 
+ */
+long EditDistance_Banded_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, long max_distance, struct Workspace *ws)
+{
+   if (m < n) /* X is the longest sequence */
+   {  const unsigned char *aux = X ; X = Y ; Y = aux ;
+      size_t aux_size = m ; m = n ; n = aux_size ;
+   }
+
+   long res = DISTANCE_ABOVE_MAX ;
+   const long indel = _scoring.indel ;
+   long lower = indel * (long) (m - n) ; /* at least m-n insertions */
+   if (lower <= max_distance)
+   {  long t = lower + 2 * indel * BAND_INITIAL ;
+      if (t > max_distance) t = max_distance ;
+      for (;;)
+      {  long *row = (long *) Workspace_get( ws, 2, (t / indel + 3) * sizeof(long) ) ;
+         long d ;
+         switch (_scoring.model) /* one pass per model of the scoring */
+         {  case SCORING_DEFAULT : d = EditDistance_BandPass( X, m, Y, n, t, row, SCORING_DEFAULT ) ; break ;
+            case SCORING_UNIT :    d = EditDistance_BandPass( X, m, Y, n, t, row, SCORING_UNIT ) ; break ;
+            default :              d = EditDistance_BandPass( X, m, Y, n, t, row, SCORING_MATRIX ) ; break ;
+         }
+         if (d <= t) { res = d ; break ; } /* exact: all the paths of cost <= t are in the band */
+         if (t >= max_distance) break ;
+         t = (2 * t < max_distance) ? 2 * t : max_distance ;
+      }
+   }
+   return res ;
+}
+
+/* EditDistance_Banded : cf .h for specification 
+ */
+long EditDistance_Banded(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_Banded_Packed( &X, &Y, max_distance, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
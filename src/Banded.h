@@ -0,0 +1,53 @@
+/**
+ * \file Banded.h
+ * \brief threshold-bounded algorithm that computes the distance between two genetic sequences 
+ * if it does not exceed a given bound
+ * \version 0.1
+ * \date 17/10/2026 
+ */
+
+#include "Globals.h" /* have all the cost definitions */
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/** \def DISTANCE_ABOVE_MAX
+ * \brief value returned by EditDistance_Banded when the distance exceeds the bound (an impossible distance, -1).
+ */
+#define DISTANCE_ABOVE_MAX -1L
+
+/********************************************************************************
+ *  Banded algorithm with early termination (Ukkonen)
+ */
+/**
+ * \fn long EditDistance_Banded(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1] if it is at most max_distance
+ * \param A  : array of char representing a genetic sequence A 
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B 
+ * \param max_distance : bound k on the distance 
+ * \return :  edit distance between A and B if it is <= max_distance, else DISTANCE_ABOVE_MAX
+ *
+ * A path of cost at most t in the table only visits the diagonals j-i in a band of width about 
+ * t/indel around the diagonals 0 and n-m (Ukkonen), indel being the cost of an insertion in _scoring (cf Scoring.h;
+ * the pass is specialized on its model). EditDistance_Banded computes the table 
+ * only inside this band, row by row in linear space, starting with a small bound t and doubling it 
+ * (up to max_distance) while the distance exceeds t.
+ * A pass stops as soon as all the cells of a row exceed t, since the distance is then above t.
+ * For similar sequences, the work is O((lengthA + lengthB) * distance) instead of O(lengthA * lengthB).
+ */
+long EditDistance_Banded(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance);
+
+/**
+ * \fn long EditDistance_Banded_Packed(const struct PackedSequence *A, const struct PackedSequence *B, long max_distance, struct Workspace *ws);
+ * \brief same as EditDistance_Banded on sequences already packed (cf Packed_init), the buffers being taken in ws 
+ * (slots 0 to 2) instead of allocated and freed
+ */
+long EditDistance_Banded_Packed(const struct PackedSequence *A, const struct PackedSequence *B, long max_distance, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_Banded_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, long max_distance, struct Workspace *ws);
+ * \brief same as EditDistance_Banded_Packed on sequences already unpacked (enum Base, cf Packed_unpack), 
+ * the buffer being taken in the slot 2 of ws
+ */
+long EditDistance_Banded_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, long max_distance, struct Workspace *ws);
@@ -0,0 +1,152 @@
+/**
+ * \file Batch.c
+ * \brief batch mode: computation of the pairs of sequences listed in a manifest 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Batch.h
+ */
+
+#include "Batch.h"
+#include "ThreadPool.h"
+#include "FastaIndex.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <err.h> 
+#include <string.h> /* for strtok_r */
+#include <pthread.h>
+
+/** \struct BatchPair
+ * \brief a pair of the manifest, and its output line when computed
+ */
+struct BatchPair 
+{  struct SequenceFile *file[2] ;
+   char *seq[2] ;
+   long length[2] ;
+   char *line ;  /*!< output line, set by the worker */
+   int done ;    /*!< 1 when line is set; protected by Batch.lock */
+} ;
+
+/** \struct Batch
+ * \brief data shared by the main thread and the workers 
+ *
+ * The pair number p is stored in window[p % BATCH_WINDOW] from its reading until its output.
+ */
+struct Batch 
+{  struct PairOptions options ;
+   struct BatchPair window[BATCH_WINDOW] ;
+   struct Workspace *workspace ; /*!< one per worker */
+   pthread_mutex_t lock ;
+   pthread_cond_t completed ;    /*!< signaled when a pair is done */
+} ;
+
+/*
+ * task of a worker: computes the pair number p 
+ */
+static void Batch_Task(void *arg, size_t p, int worker)
+{
+   struct Batch *batch = (struct Batch *) arg ;
+   struct BatchPair *pair = &batch->window[p % BATCH_WINDOW] ;
+   char *line = Pair_compute( &batch->options, pair->file, pair->seq, pair->length, &batch->workspace[worker] ) ;
+   pthread_mutex_lock( &batch->lock ) ;
+   pair->line = line ;
+   pair->done = 1 ;
+   pthread_cond_signal( &batch->completed ) ;
+   pthread_mutex_unlock( &batch->lock ) ;
+}
+
+/*
+ * prints the output of the pairs printed, printed+1, ... that are done and returns the number of 
+ * pairs printed; waits for the pairs < wait_until that are not done.
+ */
+static size_t Batch_Flush(struct Batch *batch, size_t printed, size_t submitted, size_t wait_until)
+{
+   size_t first = printed ;
+   while (printed < submitted)
+   {  struct BatchPair *pair = &batch->window[printed % BATCH_WINDOW] ;
+      pthread_mutex_lock( &batch->lock ) ;
+      if (printed < wait_until) 
+         while (! pair->done) pthread_cond_wait( &batch->completed, &batch->lock ) ;
+      int done = pair->done ;
+      pthread_mutex_unlock( &batch->lock ) ;
+      if (! done) break ;
+      fputs( pair->line, stdout ) ;
+      free( pair->line ) ;
+      ++printed ;
+   }
+   if (printed > first) fflush( stdout ) ;
+   return printed ;
+}
+
+/*
+ * parses a number of the manifest 
+ */
+static long Batch_Number(const char *token, const char *name, size_t line_number)
+{
+   char *end ;
+   long value = strtol( token, &end, 10 ) ;
+   if ((*end != '\0') || (value < 0)) errx(1, "%s:%zu: invalid position or length: %s", name, line_number, token) ;
+   return value ;
+}
+
+/* Batch_run : cf .h for specification 
+ */
+void Batch_run(FILE *manifest, const char *name, const struct PairOptions *options, int nthreads)
+{
+   struct Batch *batch = (struct Batch *) malloc( sizeof(struct Batch) ) ;
+   if (batch == NULL) { perror("Batch_run: malloc" ); exit(EXIT_FAILURE); }
+   batch->options = *options ;
+   batch->options.nthreads = 1 ; /* the parallelism is between the pairs */
+   batch->options.mem_limit /= nthreads ; /* the memory budget is shared by the pairs computed at the same time */
+   batch->workspace = (struct Workspace *) calloc( nthreads, sizeof(struct Workspace) ) ;
+   if (batch->workspace == NULL) { perror("Batch_run: malloc of workspaces" ); exit(EXIT_FAILURE); }
+   pthread_mutex_init( &batch->lock, NULL ) ;
+   pthread_cond_init( &batch->completed, NULL ) ;
+   struct ThreadPool *pool = ThreadPool_create( nthreads ) ;
+
+   size_t submitted = 0, printed = 0 ;
+   char *buffer = NULL ;
+   size_t buffer_size = 0 ;
+   size_t line_number = 0 ;
+   while (getline( &buffer, &buffer_size, manifest ) != -1)
+   {  ++line_number ;
+      char *token[6], *save ;
+      int ntokens = 0 ;
+      for (char *t = strtok_r( buffer, " \t\r\n", &save ); t != NULL; t = strtok_r( NULL, " \t\r\n", &save ))
+      {  if ((ntokens == 0) && (t[0] == '#')) break ; /* comment */
+         if (ntokens == 6) errx(1, "%s:%zu: more than 6 fields", name, line_number) ;
+         token[ntokens++] = t ;
+      }
+      if (ntokens == 0) continue ; /* empty line or comment */
+      int regions = (ntokens == 2) && FastaIndex_is_region( token[0] ) && FastaIndex_is_region( token[1] ) ;
+      if ((ntokens != 6) && !regions) 
+         errx(1, "%s:%zu: 6 fields expected: file_1 begin_1 length_1 file_2 begin_2 length_2 "
+                 "(or 2 regions file_1:record_1[:start_1-end_1] file_2:record_2[:start_2-end_2])", name, line_number) ;
+
+      if (submitted - printed == BATCH_WINDOW) /* the window is full: waits for the oldest pair */
+         printed = Batch_Flush( batch, printed, submitted, printed + 1 ) ;
+      struct BatchPair *pair = &batch->window[submitted % BATCH_WINDOW] ;
+      for (int i = 0; (i < 2) && regions; ++i) 
+         pair->seq[i] = FastaIndex_region( token[i], &pair->file[i], &pair->length[i], 0 ) ;
+      for (int i = 0; (i < 2) && !regions; ++i) 
+      {  pair->file[i] = SequenceFile_open( token[3*i] ) ;
+         pair->length[i] = Batch_Number( token[3*i+2], name, line_number ) ;
+         pair->seq[i] = SequenceFile_sequence( pair->file[i], Batch_Number( token[3*i+1], name, line_number ), &pair->length[i], 0 ) ;
+      }
+      pair->line = NULL ;
+      pair->done = 0 ;
+      ThreadPool_submit( pool, Batch_Task, batch, submitted ) ;
+      ++submitted ;
+      printed = Batch_Flush( batch, printed, submitted, 0 ) ;
+   }
+   free( buffer ) ;
+   printed = Batch_Flush( batch, printed, submitted, submitted ) ;
+
+   ThreadPool_destroy( pool ) ;
+   for (int w = 0; w < nthreads; ++w) Workspace_release( &batch->workspace[w] ) ;
+   free( batch->workspace ) ;
+   pthread_mutex_destroy( &batch->lock ) ;
+   pthread_cond_destroy( &batch->completed ) ;
+   free( batch ) ;
+}
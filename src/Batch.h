@@ -0,0 +1,43 @@
+/**
+ * \file Batch.h
+ * \brief batch mode: computation of the pairs of sequences listed in a manifest 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Each line of the manifest gives a pair as the 6 arguments of the command line: 
+ *    file_1 begin_1 length_1 file_2 begin_2 length_2 
+ * or the 2 regions file_1:record_1[:start_1-end_1] file_2:record_2[:start_2-end_2] (cf FastaIndex.h),
+ * separated by spaces or tabulations; empty lines and lines starting by '#' are ignored.
+ */
+
+#ifndef __BATCH_h__
+#define __BATCH_h__
+
+#include <stdio.h> /* for FILE */
+
+#include "Pair.h" 
+
+/**
+ * \def BATCH_WINDOW
+ * \brief maximal number of pairs read from the manifest whose output is not yet printed
+ */
+#define BATCH_WINDOW 1024
+
+/**
+ * \fn void Batch_run(FILE *manifest, const char *name, const struct PairOptions *options, int nthreads)
+ * \brief prints on stdout the output line of each pair of the manifest, in the order of the manifest
+ * \param manifest : the manifest, read until its end (eg stdin)
+ * \param name : name of the manifest, for the error messages
+ * \param options : what is computed for each pair (options->nthreads is ignored: each pair is computed by one thread)
+ * \param nthreads : number of worker threads
+ *
+ * The pairs are computed in parallel by a pool of nthreads workers while the manifest is read: 
+ * each file is mapped once for all the pairs (cf SequenceFile_open) and each worker reuses its 
+ * scratch buffers (struct Workspace) from a pair to the next one.
+ * The main thread reads the manifest and prints the output lines as soon as all the previous 
+ * ones are printed: the output is streamed, with at most BATCH_WINDOW pairs in progress.
+ * Exits with an error message if a line of the manifest is not a valid pair.
+ */
+void Batch_run(FILE *manifest, const char *name, const struct PairOptions *options, int nthreads) ;
+
+#endif /* __BATCH_h__ */
@@ -1,150 +1,299 @@
-#include "Needleman-Wunsch-itmemo.h"
+#include "CacheAware.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "Tuning.h" /* sides of the blocks and tiles */
+#include "Progress.h" /* count of the cells computed */
 
 #include <math.h>
 #include <stdio.h>  
 #include <stdlib.h> 
 #include <string.h> /* for strchr */
+#include <stdatomic.h>
 // #include <ctype.h> /* for toupper */
 
 #include "characters_to_base.h" /* mapping from char to base */
 
 
 /*
- * CACHE DEFINITIONS 
- * they will be set up for the run in the valgrind call
-*/
-#define SIZE_Z 4096
-#define SIZE_L 64
+ * BLOCK AND TILE DEFINITIONS
+ * the side of the blocks of EditDistance_CA (_tuning.ca_block) and the minimal side of the tiles of 
+ * EditDistance_CA_Par (_tuning.par_tile, large enough to amortize the scheduling of a tile) are set for 
+ * the caches of the machine (cf Tuning.h); the side of the tiles is increased if needed so that there 
+ * are at most PAR_MAX_TILES tiles.
+ */
+#define PAR_MAX_TILES (1UL << 26)
 
-/* EditDistance_CA : It is the main function, performs the calculations
- * in an iterative manner. It dones so by filling up a table that represents
- * the insertions, deletions or substitions, giving the costs of .h
+/* CA_Fill : fills the table edit_dist[0..totalRows][0..totalCols] of cells of width bytes (cf CellWidth.h)
+ * by blocks and returns its last cell; specialized on width by each call of EditDistance_CA_Packed
  */
-long EditDistance_CA(char* A, size_t lengthA, char* B, size_t lengthB) {
+CELL_KERNEL long CA_Fill(const struct PackedSequence *X, const unsigned char *Yb, void **edit_dist, 
+                         size_t totalRows, size_t totalCols, int width) {
 
-    _init_base_match();
+    // just insertions and deletions for the first row and column
+    for(size_t col=0; col<totalCols+1; col++) Cell_set(edit_dist[0], col, width, INSERTION_COST * (long)col);
+    for(size_t row=0; row<totalRows+1; row++) Cell_set(edit_dist[row], 0, width, INSERTION_COST * (long)row);
+    PerfCounters_phase(PERF_FILL);
 
-    // make sure A is the longest substring (by changing A and B if necessary)
-    if(lengthA<lengthB) {
-        char *aux = B;
-        B = A;
-        A = aux;
+    // the block size, sqrt(Z/2) for a cache of Z bytes by default (cf Tuning.h)
+    size_t K = _tuning.ca_block;
 
-        size_t aux_size = lengthA;
-        lengthA = lengthB;
-        lengthB = aux_size;
-    }
+    // the 2 outer loops are the blocking parts
+    for(size_t i=0; i<totalCols; i+=K) {
+        size_t endA = (i+K < totalCols) ? i+K : totalCols;
 
-    // create the list that will contain the elements
-    long** edit_dist = (long**)malloc( (lengthB+1) * sizeof(long*));
-    for(int i=0; i<lengthA+1; i++) {
-        // lengthB + 1 = number os columns
-        edit_dist[i] = (long*)malloc( (lengthA+1) * sizeof(long));
-        for(int j=0; j<lengthA+1; j++)
-            edit_dist[i][j] = 0;
-    }
+        for(size_t j=0; j<totalRows; j+=K) {
+            size_t endB = (j+K < totalRows) ? j+K : totalRows;
 
-    //rows and cols to ignore the chars that are not bases
-    int row = 1, col = 1;
-    // just insertions and deletions for the first row and column
-    for(int i=1; i<lengthA+1; i++) {
-        // for the row
-        if(isBase(A[i-1])) {
-            // if it is a base, calculate the cost of insertion
-            edit_dist[0][col] = INSERTION_COST * col;
-            // printf("col[%d] -> %zu\n", col, edit_dist[0][col]);
-            col++;
-            // otherwise, don't add anything to the value
+            // the 2 inner loops are the logic part
+            for(size_t k=i; k<endA; k++) {
+                enum Base x = Packed_base(X, k);
+                for(size_t l=j; l<endB; l++) {
+                    // initialization  with cas 1
+                    long min = ( (x == UNKOWN_BASE) ?  
+                                    SUBSTITUTION_UNKNOWN_COST : 
+                                    ( (x == Yb[l]) ? 0 : SUBSTITUTION_COST ) )
+                                + Cell_get(edit_dist[l], k, width);
+                    {
+                        long cas2 = INSERTION_COST + Cell_get(edit_dist[l+1], k, width) ;      
+                        if (cas2 < min) min = cas2 ;
+                    }
+                    { 
+                        long cas3 = INSERTION_COST + Cell_get(edit_dist[l], k+1, width);      
+                        if (cas3 < min) min = cas3 ; 
+                    }
+                    Cell_set(edit_dist[l+1], k+1, width, min);
+                }
+            }
+            Progress_cells((endA - i) * (endB - j));
         }
     }
-    for(int i=1; i<lengthB+1; i++) {
-        // for the column
-        if(isBase(B[i-1])) {
-            //printf("%c", B[i-1]);
-            edit_dist[row][0] = INSERTION_COST * row;
-            // printf("row[%d] -> %zu\n", row, edit_dist[row][0]);
-            row++;
-        }
+    return Cell_get(edit_dist[totalRows], totalCols, width);
+}
+
+/* EditDistance_CA_Packed : It is the main function, performs the calculations
+ * in an iterative manner. It dones so by filling up a table that represents
+ * the insertions, deletions or substitions, giving the costs of .h
+ * The sequences are packed (cf Packed.h): the loops run on the bases only,
+ * without any test isBase per cell. The table is one array of the arena of ws (cf Arena.h),
+ * of cells of the smallest width that holds the distances (cf CellWidth.h).
+ */
+long EditDistance_CA_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws) {
+
+    // make sure X is the longest sequence (by changing A and B if necessary)
+    const struct PackedSequence *X = A, *Y = B;
+    if(A->length < B->length) {
+        X = B;
+        Y = A;
+    }
+    size_t totalCols = X->length;
+    size_t totalRows = Y->length;
+    int width = Cell_width(totalCols, totalRows);
+
+    // the bases of Y, read for each column of a block, and the table edit_dist[row][col], 
+    // row = 0..totalRows and col = 0..totalCols, rows after rows in the arena
+    Arena_reserve(&ws->arena, Arena_bytes(totalRows + 1) + Arena_bytes((totalRows+1) * sizeof(void*))
+                              + Arena_bytes((totalRows+1) * (totalCols+1) * width));
+    unsigned char *Yb = (unsigned char*)Arena_alloc(&ws->arena, totalRows + 1, 0);
+    Packed_unpack(Y, 0, totalRows, Yb);
+    void** edit_dist = (void**)Arena_alloc(&ws->arena, (totalRows+1) * sizeof(void*), 0);
+    edit_dist[0] = Arena_alloc(&ws->arena, (totalRows+1) * (totalCols+1) * width, 0);
+    for(size_t i=1; i<totalRows+1; i++) edit_dist[i] = (char*)edit_dist[i-1] + (totalCols+1) * width;
+
+    long res;
+    switch(width) {
+        case 2 :  res = CA_Fill(X, Yb, edit_dist, totalRows, totalCols, 2); break;
+        case 4 :  res = CA_Fill(X, Yb, edit_dist, totalRows, totalCols, 4); break;
+        default : res = CA_Fill(X, Yb, edit_dist, totalRows, totalCols, 8);
     }
+    PerfCounters_phase(PERF_TEARDOWN);
+    return res;
+}
 
-    // get the limits (ignoring what is not a base)
-    int totalRows = row-1;
-    int totalCols = col-1;
+/* EditDistance_CA : packs the bases (the chars that are not bases are skipped once for all)
+ * and calls EditDistance_CA_Packed with a workspace of its own
+ */
+long EditDistance_CA(char* A, size_t lengthA, char* B, size_t lengthB) {
+    struct PackedSequence PA, PB;
+    Packed_init(&PA, A, lengthA);
+    Packed_init(&PB, B, lengthB);
+    struct Workspace ws = WORKSPACE_INITIALIZER;
+    long res = EditDistance_CA_Packed(&PA, &PB, &ws);
+    Workspace_release(&ws);
+    Packed_free(&PA);
+    Packed_free(&PB);
+    return res;
+}
 
-    // printf("row: %zu\ncol: %zu\n", totalRows, totalCols);
 
-    // for(int i=0; i<totalRows+1;i++) {
-    //     for(int j=0; j<totalCols+1; j++) {
-    //         printf("%zu ", edit_dist[i][j]);
-    //     }
-    //     printf("\n");
-    // }
+/*****************************************************************************/
+/* Parallel tiled wavefront */
 
-    // divide by the number os bytes that the data type occupies
-    // in this case, as char is only 1, this line won't make much effect
-    int Z = SIZE_Z / sizeof(char);
-    int L = SIZE_L / sizeof(char);
+/** \struct CA_ParContext
+ * \brief data shared by all the tiles of EditDistance_CA_Par
+ *
+ * Tile (ti,tj) computes rows r0+1..r1 of X and columns c0+1..c1 of Y, with r0 = ti*K and c0 = tj*K.
+ * Before its computation, top[tj][0..c1-c0] = phi(r0, c0..c1) and left[ti][0..r1-r0] = phi(r0..r1, c0);
+ * the tile overwrites them with phi(r1, c0..c1) and phi(r0..r1, c1): the inputs of the tile below 
+ * and of the tile on the right. The tiles of the first row (column) of tiles initialize top[tj] (left[ti]) 
+ * themselves: the pages of a boundary are first touched by a worker that uses it (cf Arena.h).
+ */
+struct CA_ParContext
+{
+    const struct PackedSequence *X ; /*!< bases of the longest sequence (rows), read in their packed form */
+    unsigned char *Y ; /*!< bases of the shortest sequence (columns) */
+    size_t m ;         /*!< number of bases in X */
+    size_t n ;         /*!< number of bases in Y */
+    size_t K ;         /*!< side of a tile */
+    size_t TI ;        /*!< number of rows of tiles */
+    size_t TJ ;        /*!< number of columns of tiles */
+    int width ;        /*!< width of the cells of the boundaries, in bytes (cf CellWidth.h) */
+    void **top ;       /*!< top[tj]: horizontal boundary of column of tiles tj (K+1 cells) */
+    void **left ;      /*!< left[ti]: vertical boundary of row of tiles ti (K+1 cells) */
+    atomic_uchar *deps ; /*!< deps[ti*TJ+tj]: number of dependencies of tile (ti,tj) already completed */
+    struct ThreadPool *pool ;
+} ;
 
-    // initialize the block size to sqrt(Z/2)
-    int K = pow(Z/2, 0.5);
+static void CA_ParTile(void *arg, size_t index, int worker) ;
 
-    // the 2 outer loops are the blocking parts
-    int mid_col, mid_row;
+/* 
+ * A dependency of tile (ti,tj) is completed: submits it if it was the last one. 
+ */
+static void CA_ParRelease(struct CA_ParContext *c, size_t ti, size_t tj)
+{
+   unsigned char expected = (ti > 0) + (tj > 0) ;
+   size_t index = ti * c->TJ + tj ;
+   if (atomic_fetch_add( &c->deps[index], 1 ) + 1 == expected) 
+      ThreadPool_submit( c->pool, CA_ParTile, c, index ) ;
+}
 
-    col = 1;
-    for(int i=0; i<lengthA; i+=K) {
-        int endA = (i+K < lengthA) ? i+K : lengthA;
+/* 
+ * Computes rows r0+1..r1 of the columns c0+1..c0+w on boundaries of cells of width bytes (cf EditDistance_CA_Tile);
+ * specialized on width by EditDistance_CA_Tile
+ */
+CELL_KERNEL void CA_TileCells(const struct PackedSequence *X, const unsigned char *Yt, size_t r0, size_t r1, size_t w,
+                              void *row, void *col, int width)
+{
+   Cell_set( col, 0, width, Cell_get( row, w, width ) ) ; /* phi(r0, c0+w) */
+   for (size_t i = r0 + 1; i <= r1; ++i)
+   {  enum Base x = Packed_base( X, i-1 ) ;
+      long diag = Cell_get( row, 0, width ) ;
+      long left = Cell_get( col, i-r0, width ) ;
+      Cell_set( row, 0, width, left ) ;
+      for (size_t j = 1; j <= w; ++j)
+      {  long up = Cell_get( row, j, width ) ;
+         long min = /* initialization  with cas 1*/
+                   ( (x == UNKOWN_BASE) ?  SUBSTITUTION_UNKNOWN_COST 
+                          : ( (x == Yt[j-1]) ? 0 : SUBSTITUTION_COST ) 
+                   )
+                   + diag ; 
+         { long cas2 = INSERTION_COST + up ;      
+           if (cas2 < min) min = cas2 ;
+         }
+         { long cas3 = INSERTION_COST + left ;      
+           if (cas3 < min) min = cas3 ; 
+         }
+         Cell_set( row, j, width, min ) ;
+         left = min ;
+         diag = up ;
+      }
+      Cell_set( col, i-r0, width, left ) ;
+   }
+   Progress_cells( (r1 - r0) * w ) ;
+}
 
-        row = 1;
-        for(int j=0; j<lengthB; j+=K) {
-            int endB = (j+K < lengthB) ? j+K : lengthB;
+/* EditDistance_CA_Tile : cf .h for specification
+ */
+void EditDistance_CA_Tile(const struct PackedSequence *X, const unsigned char *Yt, size_t r0, size_t r1, size_t w,
+                          void *row, void *col, int width)
+{
+   switch (width)
+   {  case 2 :  CA_TileCells( X, Yt, r0, r1, w, row, col, 2 ) ; break ;
+      case 4 :  CA_TileCells( X, Yt, r0, r1, w, row, col, 4 ) ; break ;
+      default : CA_TileCells( X, Yt, r0, r1, w, row, col, 8 ) ;
+   }
+}
 
-            mid_col = col;
-            // the 2 inner loops are the logic part
-            for(int k=i; k<endA; k++) {
-                // if A[k] is not a base, no need to enter the loop
-                if(!isBase(A[k])) continue;
-
-                mid_row = row;
-                for(int l=j; l<endB; l++) {
-
-                    // printf("A[k]:%c | B[l]:%c | i:%d | j:%d | k:%d | l:%d\n",A[k],B[l],i,j,k,l);
-
-                    if(isBase(A[k]) && isBase(B[l])) {
-                        // initialization  with cas 1
-                        long min = isUnknownBase(A[k]) ?  
-                                        SUBSTITUTION_UNKNOWN_COST : 
-                                        ( isSameBase(A[k], B[l]) ? 0 : SUBSTITUTION_COST )
-                                    + edit_dist[mid_row-1][mid_col-1];
-                        {
-                            long cas2 = INSERTION_COST + edit_dist[mid_row][mid_col-1] ;      
-                            if (cas2 < min) min = cas2 ;
-                        }
-                        { 
-                            long cas3 = INSERTION_COST + edit_dist[mid_row-1][mid_col];      
-                            if (cas3 < min) min = cas3 ; 
-                        }
-                        // printf("  MIN: %d\n", min);
-                        edit_dist[mid_row][mid_col] = min;
-                        mid_row++;
-                    }
-                }
-                if(isBase(A[k])) mid_col++;
-            }
-            row = mid_row;
-        }
-        col = mid_col;
-    }
+/* 
+ * Computes tile index = ti*TJ+tj in place in top[tj] and left[ti] 
+ */
+static void CA_ParTile(void *arg, size_t index, int worker)
+{
+   (void) worker ;
+   struct CA_ParContext *c = (struct CA_ParContext *) arg ;
+   size_t ti = index / c->TJ ;
+   size_t tj = index % c->TJ ;
+   size_t r0 = ti * c->K, r1 = (r0 + c->K < c->m) ? r0 + c->K : c->m ;
+   size_t c0 = tj * c->K, c1 = (c0 + c->K < c->n) ? c0 + c->K : c->n ;
+   void *row = c->top[tj] ;   /* row[j] = phi(r0, c0+j), replaced by phi(r1, c0+j) */
+   void *col = c->left[ti] ;  /* col[i-r0] = phi(i, c0), replaced by phi(i, c1) */
+   if (ti == 0) /* phi(0, c0..c1) */
+      for (size_t j = 0; j <= c1 - c0; ++j) Cell_set( row, j, c->width, INSERTION_COST * (long) (c0 + j) ) ;
+   if (tj == 0) /* phi(r0..r1, 0) */
+      for (size_t i = 0; i <= r1 - r0; ++i) Cell_set( col, i, c->width, INSERTION_COST * (long) (r0 + i) ) ;
+   EditDistance_CA_Tile( c->X, c->Y + c0, r0, r1, c1 - c0, row, col, c->width ) ;
+
+   if (ti + 1 < c->TI) CA_ParRelease( c, ti+1, tj ) ;
+   if (tj + 1 < c->TJ) CA_ParRelease( c, ti, tj+1 ) ;
+}
+
+/* EditDistance_CA_Par_Packed : cf .h for specification 
+ */
+long EditDistance_CA_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws)
+{
+   if (A->length < B->length) /* X is the longest sequence, Y the shortest */
+   {  const struct PackedSequence *aux = B ; B = A ; A = aux ;
+   }
 
-    // printf("row: %zu\ncol: %zu\n", totalRows, totalCols);
+   struct CA_ParContext ctx ;
+   ctx.X = A ;
+   ctx.m = A->length ;
+   ctx.n = B->length ;
+   if ((ctx.m == 0) || (ctx.n == 0)) /* only insertions */
+      return INSERTION_COST * (long) (ctx.m + ctx.n) ;
+   ctx.K = _tuning.par_tile ;
+   while ( ((ctx.m + ctx.K - 1) / ctx.K) * ((ctx.n + ctx.K - 1) / ctx.K) > PAR_MAX_TILES ) ctx.K *= 2 ;
+   ctx.TI = (ctx.m + ctx.K - 1) / ctx.K ;
+   ctx.TJ = (ctx.n + ctx.K - 1) / ctx.K ;
 
-    // for(int i=0; i<totalRows+1;i++) {
-    //     for(int j=0; j<totalCols+1; j++) {
-    //         printf("%zu ", edit_dist[i][j]);
-    //     }
-    //     printf("\n");
-    // }
+   {  /* The bases of Y, the boundaries, each one on its own cache lines (initialized by the tiles), 
+       * and the counters of dependencies (zero pages), in the arena */
+      ctx.width = Cell_width( ctx.m, ctx.n ) ;
+      size_t bytes = (ctx.K + 1) * ctx.width ;
+      struct Arena *arena = &ws->arena ;
+      Arena_reserve( arena, Arena_bytes( ctx.n + 1 ) + Arena_bytes( ctx.TJ * sizeof(void *) ) + Arena_bytes( ctx.TI * sizeof(void *) )
+                            + (ctx.TI + ctx.TJ) * Arena_bytes( bytes ) + Arena_bytes( ctx.TI * ctx.TJ * sizeof(atomic_uchar) ) ) ;
+      ctx.Y = (unsigned char *) Arena_alloc( arena, ctx.n + 1, 0 ) ;
+      Packed_unpack( B, 0, ctx.n, ctx.Y ) ;
+      ctx.top = (void **) Arena_alloc( arena, ctx.TJ * sizeof(void *), 0 ) ;
+      ctx.left = (void **) Arena_alloc( arena, ctx.TI * sizeof(void *), 0 ) ;
+      for (size_t tj = 0; tj < ctx.TJ; ++tj) ctx.top[tj] = Arena_alloc( arena, bytes, 0 ) ;
+      for (size_t ti = 0; ti < ctx.TI; ++ti) ctx.left[ti] = Arena_alloc( arena, bytes, 0 ) ;
+      ctx.deps = (atomic_uchar *) Arena_alloc( arena, ctx.TI * ctx.TJ * sizeof(atomic_uchar), 1 ) ;
+   }
 
-    return edit_dist[totalRows][totalCols];
+   PerfCounters_phase( PERF_FILL ) ;
+   ctx.pool = ThreadPool_create( nthreads ) ;
+   ThreadPool_submit( ctx.pool, CA_ParTile, &ctx, 0 ) ;
+   ThreadPool_wait( ctx.pool ) ;
+   ThreadPool_destroy( ctx.pool ) ;
 
+   long res = Cell_get( ctx.top[ctx.TJ-1], ctx.n - (ctx.TJ-1) * ctx.K, ctx.width ) ;
+   PerfCounters_phase( PERF_TEARDOWN ) ;
+   return res ;
+}
+
+/* EditDistance_CA_Par : cf .h for specification 
+ */
+long EditDistance_CA_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads)
+{
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   long res = EditDistance_CA_Par_Packed( &X, &Y, nthreads, &ws ) ;
+   Workspace_release( &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   return res ;
 }
@@ -6,6 +6,8 @@
  */
 
 #include "Globals.h" /* have all the cost definitions */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "Workspace.h" /* the arena of the tables */
 
 /********************************************************************************
  *  Iterative cache aware algorithm 
@@ -25,5 +27,57 @@
  * 
  * If lengthA < lengthB, the sequences A and B are swapped.
  *
+ * The sequences are packed once before the computation (cf Packed.h): the loops run on 
+ * the bases only, without testing for each cell whether the chars are bases.
  */
 long EditDistance_CA(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_CA_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_CA on sequences already packed (cf Packed_init); the table is one array of
+ * the arena of ws (cf Arena.h), reused by the next computations with ws
+ */
+long EditDistance_CA_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_CA_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1] with nthreads threads
+ * \param A  : array of char representing a genetic sequence A 
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B 
+ * \param nthreads : number of worker threads (if <= 0: number of processors online)
+ * \return :  edit distance between A and B 
+ *
+ * EditDistance_CA_Par is the parallel tiled wavefront version of EditDistance_CA.
+ * The table is cut in tiles of _tuning.par_tile x _tuning.par_tile bases (cf Tuning.h); a tile is ready as soon as the tile above 
+ * and the tile on its left are computed, so tiles on the same anti-diagonal run concurrently.
+ * Each tile counts its completed dependencies; the tile that completes the last one submits it 
+ * to a pool of threads (cf ThreadPool.h).
+ * Only the boundaries of the tiles are stored: the bottom row of the last computed tile of each 
+ * column of tiles and the right column of the last computed tile of each row of tiles, so the 
+ * memory used is O(lengthA + lengthB).
+ *
+ * If lengthA < lengthB, the sequences A and B are swapped.
+ */
+long EditDistance_CA_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads);
+
+/**
+ * \fn long EditDistance_CA_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws);
+ * \brief same as EditDistance_CA_Par on sequences already packed (cf Packed_init); 
+ * the longest one is read in its packed form by the tiles, and the boundaries are in the arena of ws
+ */
+long EditDistance_CA_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws);
+
+/**
+ * \fn void EditDistance_CA_Tile(const struct PackedSequence *X, const unsigned char *Yt, size_t r0, size_t r1, size_t w, void *row, void *col, int width);
+ * \brief computes the tile of the rows r0+1..r1 (bases X[r0 .. r1-1]) and of the columns c0+1..c0+w (bases Yt[0 .. w-1])
+ * on its boundaries, of cells of width bytes (cf CellWidth.h), with the costs of Globals.h
+ * \param row : row[j] = phi(r0, c0+j), j = 0..w, replaced by phi(r1, c0+j)
+ * \param col : col[i-r0] = phi(i, c0), i = r0+1..r1, replaced by phi(i, c0+w), i = r0..r1
+ *
+ * The tile of EditDistance_CA_Par, and of the stripes of EditDistance_Striped (cf Striped.h); the rows of the tile
+ * stay in the L1 cache.
+ */
+void EditDistance_CA_Tile(const struct PackedSequence *X, const unsigned char *Yt, size_t r0, size_t r1, size_t w,
+                          void *row, void *col, int width);
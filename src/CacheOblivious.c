@@ -13,9 +13,16 @@
 
 // #include "Needleman-Wunsch-recmemo.h"
 #include "CacheOblivious.h"
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "ThreadPool.h" /* work stealing pool of EditDistance_CO_Par */
+#include "Tuning.h" /* side of the leaf blocks */
+#include "Progress.h" /* count of the cells computed */
 #include <stdio.h>  
 #include <stdlib.h> 
 #include <math.h>
+#include <stdatomic.h>
 #include <string.h> /* for strchr */
 // #include <ctype.h> /* for toupper */
 
@@ -23,155 +30,338 @@
 
 /*****************************************************************************/
 
-#define Z 4096
-#define BLOCK_SIZE pow(Z/2, 0.5)
-#define S 200
+/** \def S
+ * \brief maximal side of the leaf blocks, for their buffers on the stack; the side used is c->leaf (cf Tuning.h)
+ */
+#define S TUNING_CO_LEAF_MAX
 
-/* Context of the memoization : passed to all recursive calls */
-/** \def NOT_YET_COMPUTED
- * \brief default value for memoization of minimal distance (defined as an impossible value for a distance, -1).
+/** \def CO_PAR_GRAIN
+ * \brief a block of EditDistance_CO_Par with both sides at most CO_PAR_GRAIN leaf sides is one task, computed by the
+ * sequential recursion: a few leaf blocks per side, so that a task amortizes its scheduling
  */
-#define NOT_YET_COMPUTED -1L 
+#define CO_PAR_GRAIN 4
 
+/* Context of the memoization : passed to all recursive calls */
 /** \struct NW_MemoContext
  * \brief data for memoization of recursive Needleman-Wunsch algorithm 
 */
 struct NW_MemoContext 
 {
-    char *X ; /*!< the longest genetic sequences */
-    char *Y ; /*!< the shortest genetic sequences */
-    size_t M; /*!< length of X */
-    size_t N; /*!< length of Y,  N <= M */
-    long **memo; /*!< memoization table to store memo[0..M][0..N] (including stopping conditions phi(M,j) and phi(i,N) */
+    unsigned char *X ; /*!< the bases (enum Base) of the longest genetic sequences */
+    unsigned char *Y ; /*!< the bases (enum Base) of the shortest genetic sequences */
+    size_t M; /*!< number of bases in X */
+    size_t N; /*!< number of bases in Y,  N <= M */
+    size_t leaf; /*!< maximal side of the leaf blocks, at most TUNING_CO_LEAF_MAX */
+    int width; /*!< width of the cells of memo, in bytes (cf CellWidth.h) */
+    void **memo; /*!< memoization table to store memo[0..M][0..N] (including stopping conditions phi(M,j) and phi(i,N) */
 } ;
 
+/** \def LEAF_CELL
+ * \brief type of the cells of a leaf block: offsets from the cell phi(end_1, end_2) of the block.
+ * In a block of at most S x S cells, |phi(i,j) - phi(end_1,end_2)| <= INSERTION_COST * 2S: 16 bits are enough,
+ * whatever the lengths of the sequences, and a vector holds 4 times more cells than with long.
+ */
+#define LEAF_CELL int16_t
+_Static_assert( INSERTION_COST * 2 * S + SUBSTITUTION_COST + SUBSTITUTION_UNKNOWN_COST <= INT16_MAX, 
+                "the offsets of a leaf block must fit in LEAF_CELL" ) ;
+
+/*
+ * static void EditDistance_Leaf_Diagonal(LEAF_CELL *cur, const LEAF_CELL *prev1, const LEAF_CELL *prev2, const unsigned char *x, const unsigned char *y, size_t lo, size_t hi)
+ * \brief computes the cells lo..hi of an anti-diagonal of a leaf block
+ * cur[p], prev1[p] and prev2[p] are the cells of row p on the anti-diagonals d, d+1 and d+2;
+ * x[p] and y[p] are the bases of X and Y that meet in cell p of anti-diagonal d.
+ * The cells of an anti-diagonal are independent: the loop is vectorized.
+ */
+SIMD_CLONES
+static void EditDistance_Leaf_Diagonal(LEAF_CELL *restrict cur, const LEAF_CELL *restrict prev1, const LEAF_CELL *restrict prev2,
+                                       const unsigned char *restrict x, const unsigned char *restrict y, 
+                                       size_t lo, size_t hi)
+{
+   for (size_t p = lo; p <= hi; ++p)
+   {  /* substitution cost without branch: UNKNOWN_COST if x[p] is N, else COST if x[p] != y[p], else 0 */
+      LEAF_CELL unknown = (x[p] == UNKOWN_BASE) ;
+      LEAF_CELL min = /* initialization  with cas 1*/
+                unknown * SUBSTITUTION_UNKNOWN_COST + ((1 - unknown) & (x[p] != y[p])) * SUBSTITUTION_COST 
+                + prev2[p+1] ;
+      LEAF_CELL cas2 = INSERTION_COST + prev1[p+1] ;
+      LEAF_CELL cas3 = INSERTION_COST + prev1[p] ;
+      min = (cas2 < min) ? cas2 : min ;
+      min = (cas3 < min) ? cas3 : min ;
+      cur[p] = min ;
+   }
+}
+
+/*
+ * static void EditDistance_Leaf_CO(struct NW_MemoContext *c, size_t begin_1, size_t begin_2, size_t end_1, size_t end_2, int width)
+ * \brief computes phi(i,j) for begin_1 <= i < end_1 and begin_2 <= j < end_2 (a leaf block of at most c->leaf x c->leaf cells)
+ * 
+ * The block is extended with the row end_1 and the column end_2, already computed, and is swept by 
+ * anti-diagonals d = p+q (p = i-begin_1, q = j-begin_2) from the bottom-right corner to the top-left one,
+ * on offsets from base = phi(end_1, end_2) (cf LEAF_CELL).
+ * Only the first row and the first column of the block are stored back in c->memo: they are the only 
+ * cells read by the blocks above and on the left. Specialized on the width of the cells of c->memo.
+ */
+CELL_KERNEL void EditDistance_Leaf_CO(struct NW_MemoContext *c, size_t begin_1, size_t begin_2, size_t end_1, size_t end_2, int width)
+{
+   size_t h = end_1 - begin_1 ;
+   size_t w = end_2 - begin_2 ;
+   LEAF_CELL buf[3][S+2] ; /* 3 rotating anti-diagonals, indexed by p = 0..h */
+   LEAF_CELL *cur = buf[0], *prev1 = buf[1], *prev2 = buf[2] ;
+   unsigned char yr[2*S+1] ; /* yr[w-1-q] = Y[begin_2+q] for 0 <= q < w, so that Y[begin_2+d-p] = yr[w-1-d+p] */
+   const unsigned char *x = c->X + begin_1 ;
+   long base = Cell_get( c->memo[end_1], end_2, width ) ;
+
+   for (size_t q = 0; q < w; ++q) yr[S + w-1-q] = c->Y[begin_2+q] ;
+
+   for (size_t d = h + w + 1; d-- > 0; )
+   {  /* interior cells of anti-diagonal d: max(0,d-w+1) <= p <= min(h-1,d) */
+      size_t lo = (d + 1 > w) ? d + 1 - w : 0 ;
+      size_t hi = (d < h) ? d : h - 1 ;
+      if ((d < h + w - 1) && (lo <= hi)) 
+         EditDistance_Leaf_Diagonal( cur, prev1, prev2, x, yr + S + w-1-d, lo, hi ) ;
+      /* cells of anti-diagonal d on the extended row p = h and column q = w */
+      if ((d >= h) && (d - h <= w)) cur[h] = (LEAF_CELL) (Cell_get( c->memo[end_1], begin_2 + d-h, width ) - base) ;
+      if ((d >= w) && (d - w <= h)) cur[d-w] = (LEAF_CELL) (Cell_get( c->memo[begin_1 + d-w], end_2, width ) - base) ;
+      /* first column q = 0 and first row p = 0 of the block */
+      if ((d < h) && (w > 0)) Cell_set( c->memo[begin_1 + d], begin_2, width, base + cur[d] ) ;
+      if ((d < w) && (h > 0)) Cell_set( c->memo[begin_1], begin_2 + d, width, base + cur[0] ) ;
+
+      LEAF_CELL *aux = prev2 ; prev2 = prev1 ; prev1 = cur ; cur = aux ;
+   }
+   Progress_cells( h * w ) ;
+}
+
 /*
- *  static long EditDistance_NW_RecMemo(struct NW_MemoContext *c, size_t i, size_t j) 
- * \brief  EditDistance_NW_RecMemo :  Private (static)  recursive function with memoization \
- * direct implementation of Needleman-Wursch extended to manage FASTA sequences (cf TP description)
+ *  static long EditDistance_Rec_CO(struct NW_MemoContext *c, size_t begin_1, size_t begin_2, size_t end_1, size_t end_2) 
+ * \brief  EditDistance_Rec_CO :  Private (static)  cache oblivious recursive function \
+ * computes phi(i,j) for begin_1 <= i < end_1 and begin_2 <= j < end_2, phi(end_1, .) and phi(., end_2) being known
  * \param c : data passed for recursive calls that includes the memoization array 
- * \param i : starting position of the left sequence :  c->X[ i .. c->M ] 
- * \param j : starting position of the right sequence :  c->Y[ j .. c->N ] 
+ * \param begin_1, end_1 : rows of the block, in the longest sequence c->X
+ * \param begin_2, end_2 : columns of the block, in the shortest sequence c->Y
+ *
+ * The largest dimension of the block is cut in two halves, the bottom (or right) one being computed first.
  */ 
 static long EditDistance_Rec_CO(struct NW_MemoContext *c, size_t begin_1, size_t begin_2, size_t end_1, size_t end_2) 
-/* compute and returns phi(i,j) using data in c -allocated and initialized by EditDistance_NW_Rec */
 {
     size_t n_1 = end_1 - begin_1;
     size_t n_2 = end_2 - begin_2;
 
-    if((n_1<S) && (n_2<S)) {
-
-        // printf("begin1:%d begin2:%d\n", begin_1, begin_2);
-
-        for(int i=end_1; i>=(int)begin_1; i--) {    
-            for(int j=end_2; j>=(int)begin_2; j--) {
-
-                // printf("i:%02zu | j:%02zu | I:%02zu | J:%02zu | K1:%02zu | K2:%02zu\n", i,j,begin_1,begin_2,end_1,end_2);
-
-                long res ;
-                char Xi = c->X[i] ;
-                char Yj = c->Y[j] ;
-                if (i == c->M) /* Reach end of X */
-                {  if (j == c->N) res = 0;  /* Reach end of Y too */
-                    else res = (isBase(Yj) ? INSERTION_COST : 0) + c->memo[i][j+1];
-                    //+ EditDistance_NW_RecMemo(c, i, j+1) ;
-                }
-                else if (j == c->N) /* Reach end of Y but not end of X */
-                {  res = (isBase(Xi) ? INSERTION_COST : 0) + c->memo[i+1][j];
-                    //+ EditDistance_NW_RecMemo(c, i+1, j) ;
-                }
-                else if (! isBase(Xi))  /* skip ccharacter in Xi that is not a base */
-                {  ManageBaseError( Xi ) ;
-                    res = c->memo[i+1][j];
-                    //res = EditDistance_Rec_CO(c, i+1, j, K1, K2) ;
-                }
-                else if (! isBase(Yj))  /* skip ccharacter in Yj that is not a base */
-                {  ManageBaseError( Yj ) ;
-                    res = c->memo[i][j+1];
-                    // EditDistance_Rec_CO(c, i, j+1, K1, K2) ;
-                }
-                else  
-                {  /* Note that stopping conditions (i==M) and (j==N) are already stored in c->memo (cf EditDistance_NW_Rec) */ 
-                    long min = /* initialization  with cas 1*/
-                            ( isUnknownBase(Xi) ?  SUBSTITUTION_UNKNOWN_COST 
-                                    : ( isSameBase(Xi, Yj) ? 0 : SUBSTITUTION_COST ) 
-                            )
-                            + c->memo[i+1][j+1];
-                            //+ EditDistance_NW_RecMemo(c, i+1, j+1) ; 
-                    { long cas2 = INSERTION_COST + c->memo[i+1][j];
-                        //+ EditDistance_NW_RecMemo(c, i+1, j) ;      
-                    if (cas2 < min) min = cas2 ;
-                    }
-                    { long cas3 = INSERTION_COST + c->memo[i][j+1];
-                        //+ EditDistance_NW_RecMemo(c, i, j+1) ;      
-                    if (cas3 < min) min = cas3 ; 
-                    }
-                    res = min ;
-                }
-                c->memo[i][j] = res;
-            }
+    if((n_1<=c->leaf) && (n_2<=c->leaf)) {
+        switch(c->width) {
+            case 2 :  EditDistance_Leaf_CO(c, begin_1, begin_2, end_1, end_2, 2); break;
+            case 4 :  EditDistance_Leaf_CO(c, begin_1, begin_2, end_1, end_2, 4); break;
+            default : EditDistance_Leaf_CO(c, begin_1, begin_2, end_1, end_2, 8);
         }
     }
     else {
         if(n_1>n_2){
-            // printf("N1>N2 -> begin:%zu, end:%zu\n",begin_1,end_1);
             EditDistance_Rec_CO(c, (begin_1+end_1)/2, begin_2, end_1, end_2);
             EditDistance_Rec_CO(c, begin_1, begin_2, (begin_1+end_1)/2, end_2);
         }
         else {
-            // printf("N2>N1 -> begin:%zu, end:%zu\n",begin_2,end_2);
             EditDistance_Rec_CO(c, begin_1, (begin_2+end_2)/2, end_1, end_2);
             EditDistance_Rec_CO(c, begin_1, begin_2,end_1, (begin_2+end_2)/2);
         }
     }
 
-    return c->memo[0][0];
+    return Cell_get(c->memo[begin_1], begin_2, c->width);
 }
 
-/* EditDistance_NW_Rec :  is the main function to call, cf .h for specification 
- * It allocates and initailizes data (NW_MemoContext) for memoization and call the 
- * recursivefunction EditDistance_NW_RecMemo 
- * See .h file for documentation
+/** \struct CO_ParFrame
+ * \brief a block of the parallel recursion, waiting for its quadrants
+ *
+ * The block begin_1..end_1-1 x begin_2..end_2-1 is cut at row cut_1 and column cut_2 (cut_1 = begin_1 if the rows 
+ * are not cut, cut_2 = begin_2 if the columns are not cut). Its quadrants are computed by anti-diagonals of 
+ * quadrants, from the bottom-right one: stage 0 is the bottom-right quadrant, stage 1 the top-right and 
+ * bottom-left ones, concurrently, stage 2 the top-left one. 
  */
-long EditDistance_CO(char* A, size_t lengthA, char* B, size_t lengthB)
+struct CO_ParFrame
 {
-   _init_base_match() ;
-   struct NW_MemoContext ctx;
-   if (lengthA >= lengthB) /* X is the longest sequence, Y the shortest */
-   {  ctx.X = A ;
-      ctx.M = lengthA ;
-      ctx.Y = B ;
-      ctx.N = lengthB ;
+    struct NW_MemoContext *c ;     /*!< the table, shared by all the blocks */
+    struct ThreadPool *pool ;      /*!< the pool that runs the blocks */
+    struct CO_ParFrame *parent ;   /*!< the block of which this block is a quadrant, NULL for the whole table */
+    size_t begin_1, begin_2, end_1, end_2 ; /*!< the block */
+    size_t cut_1, cut_2 ;          /*!< the cuts of the block in quadrants */
+    int stage ;                    /*!< next stage of quadrants to run (3: completed) */
+    atomic_int pending ;           /*!< quadrants of the running stage not yet completed */
+} ;
+
+static void EditDistance_CO_ParTask(void *arg, size_t index, int worker) ;
+
+/* submits the block begin_1..end_1-1 x begin_2..end_2-1, a quadrant of parent (NULL for the whole table) */
+static void EditDistance_CO_ParSpawn(struct NW_MemoContext *c, struct ThreadPool *pool, struct CO_ParFrame *parent, 
+                                     size_t begin_1, size_t begin_2, size_t end_1, size_t end_2)
+{
+   struct CO_ParFrame *f = (struct CO_ParFrame *) malloc( sizeof(struct CO_ParFrame) ) ;
+   if (f == NULL) { perror("EditDistance_CO_Par: malloc of a block" ); exit(EXIT_FAILURE); }
+   f->c = c ;
+   f->pool = pool ;
+   f->parent = parent ;
+   f->begin_1 = f->cut_1 = begin_1 ;
+   f->begin_2 = f->cut_2 = begin_2 ;
+   f->end_1 = end_1 ;
+   f->end_2 = end_2 ;
+   f->stage = 0 ;
+   atomic_init( &f->pending, 0 ) ;
+   ThreadPool_submit( pool, EditDistance_CO_ParTask, f, 0 ) ;
+}
+
+/*
+ * The previous stage of f is completed: submits the quadrants of its next non empty stage or, if there is none, 
+ * completes f, and its parent if f was the last quadrant of its stage (the caller is the last quadrant of f). 
+ * The quadrants of a stage are counted in f->pending before the first one is submitted: f may be completed 
+ * by another worker as soon as they are, and must not be read after.
+ */
+static void EditDistance_CO_ParNext(struct CO_ParFrame *f)
+{
+   while (f != NULL)
+   {  size_t rows[2][2] = { { f->cut_1, f->end_1 }, { f->begin_1, f->cut_1 } } ; /* bottom, top */
+      size_t cols[2][2] = { { f->cut_2, f->end_2 }, { f->begin_2, f->cut_2 } } ; /* right, left */
+      for ( ; f->stage <= 2; ++f->stage)
+      {  int count = 0 ;
+         for (int a = 0; a <= 1; ++a)
+         {  int b = f->stage - a ;
+            count += (b >= 0) && (b <= 1) && (rows[a][0] < rows[a][1]) && (cols[b][0] < cols[b][1]) ;
+         }
+         if (count == 0) continue ;
+         int stage = f->stage++ ;
+         atomic_store( &f->pending, count ) ;
+         struct NW_MemoContext *c = f->c ;
+         struct ThreadPool *pool = f->pool ;
+         for (int a = 0; a <= 1; ++a)
+         {  int b = stage - a ;
+            if ((b >= 0) && (b <= 1) && (rows[a][0] < rows[a][1]) && (cols[b][0] < cols[b][1]))
+               EditDistance_CO_ParSpawn( c, pool, f, rows[a][0], cols[b][0], rows[a][1], cols[b][1] ) ;
+         }
+         return ;
+      }
+      /* f is completed */
+      struct CO_ParFrame *parent = f->parent ;
+      free( f ) ;
+      f = ((parent != NULL) && (atomic_fetch_sub( &parent->pending, 1 ) == 1)) ? parent : NULL ;
+   }
+}
+
+/*
+ * Task of the block arg (a CO_ParFrame): computed by the sequential recursion if both its sides are at most 
+ * CO_PAR_GRAIN leaf sides, else cut in quadrants (each side larger than that in two halves) whose first stage is submitted.
+ */
+static void EditDistance_CO_ParTask(void *arg, size_t index, int worker)
+{
+   (void) index ; (void) worker ;
+   struct CO_ParFrame *f = (struct CO_ParFrame *) arg ;
+   size_t n_1 = f->end_1 - f->begin_1 ;
+   size_t n_2 = f->end_2 - f->begin_2 ;
+   size_t grain = CO_PAR_GRAIN * f->c->leaf ;
+   if ((n_1 <= grain) && (n_2 <= grain))
+   {  EditDistance_Rec_CO( f->c, f->begin_1, f->begin_2, f->end_1, f->end_2 ) ;
+      f->stage = 3 ;
    }
    else
-   {  ctx.X = B ;
-      ctx.M = lengthB ;
-      ctx.Y = A ;
-      ctx.N = lengthA ;
+   {  if (n_1 > grain) f->cut_1 = (f->begin_1 + f->end_1) / 2 ;
+      if (n_2 > grain) f->cut_2 = (f->begin_2 + f->end_2) / 2 ;
    }
-   size_t M = ctx.M ;
-   size_t N = ctx.N ;
-   {  /* Allocation and initialization of ctx.memo to NOT_YET_COMPUTED*/
-      /* Note: memo is of size (N+1)*(M+1) but is stored as (M+1) distinct arrays each with (N+1) continuous elements 
-       * It would have been possible to allocate only one big array memezone of (M+1)*(N+1) elements 
-       * and then memo as an array of (M+1) pointers, the memo[i] being the address of memzone[i*(N+1)].
+   EditDistance_CO_ParNext( f ) ;
+}
+
+/* 
+ * Unpacks the bases of A and B, allocates and initializes data (NW_MemoContext) in the arena of ws 
+ */
+static void EditDistance_CO_Init(struct NW_MemoContext *c, const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   struct NW_MemoContext ctx;
+   const struct PackedSequence *X = (A->length >= B->length) ? A : B ; /* X is the longest sequence, Y the shortest */
+   const struct PackedSequence *Y = (A->length >= B->length) ? B : A ;
+   size_t M = ctx.M = X->length ;
+   size_t N = ctx.N = Y->length ;
+   int width = ctx.width = Cell_width( M, N ) ;
+   ctx.leaf = (_tuning.co_leaf < S) ? _tuning.co_leaf : S ;
+   {  /* Allocation of the bases, unpacked for the vector lanes, and of ctx.memo in the arena: one array memzone 
+       * of (M+1)*(N+1) cells of width bytes, and memo as an array of (M+1) pointers, the memo[i] being the address of memzone[i*(N+1)].
+       * Initialization of the stopping conditions phi(M,j) and phi(i,N) only: the other cells are computed
        */ 
-      ctx.memo = (long **) malloc ( (M+1) * sizeof(long *)) ;
-      if (ctx.memo == NULL) { perror("EditDistance_NW_Rec: malloc of ctx_memo" ); exit(EXIT_FAILURE); }
-      for (int i=0; i <= M; ++i) 
-      {  ctx.memo[i] = (long*) malloc( (N+1) * sizeof(long));
-         if (ctx.memo[i] == NULL) { perror("EditDistance_NW_Rec: malloc of ctx_memo[i]" ); exit(EXIT_FAILURE); }
-         for (int j=0; j<=N; ++j) ctx.memo[i][j] = NOT_YET_COMPUTED ;
+      struct Arena *arena = &ws->arena ;
+      Arena_reserve( arena, Arena_bytes( M + 1 ) + Arena_bytes( N + 1 ) + Arena_bytes( (M+1) * sizeof(void *) )
+                            + Arena_bytes( (M+1) * (N+1) * width ) ) ;
+      ctx.X = (unsigned char *) Arena_alloc( arena, M + 1, 0 ) ;
+      ctx.Y = (unsigned char *) Arena_alloc( arena, N + 1, 0 ) ;
+      Packed_unpack( X, 0, M, ctx.X ) ;
+      Packed_unpack( Y, 0, N, ctx.Y ) ;
+      ctx.memo = (void **) Arena_alloc( arena, (M+1) * sizeof(void *), 0 ) ;
+      char *memzone = (char *) Arena_alloc( arena, (M+1) * (N+1) * width, 0 ) ;
+      for (size_t i=0; i <= M; ++i) 
+      {  ctx.memo[i] = memzone + i * (N+1) * width ;
+         Cell_set( ctx.memo[i], N, width, INSERTION_COST * (long) (M - i) ) ;
       }
+      for (size_t j=0; j <= N; ++j) Cell_set( ctx.memo[M], j, width, INSERTION_COST * (long) (N - j) ) ;
    }    
+   *c = ctx ;
+}
+
+/* EditDistance_CO_Packed :  is the main function to call, cf .h for specification 
+ * It initializes the table (EditDistance_CO_Init) and calls the recursive function EditDistance_Rec_CO 
+ * See .h file for documentation
+ */
+long EditDistance_CO_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   struct NW_MemoContext ctx;
+   EditDistance_CO_Init( &ctx, A, B, ws ) ;
 
-   /* Compute phi(0,0) = ctx.memo[0][0] by calling the recursive function EditDistance_NW_RecMemo */
-   long res = EditDistance_Rec_CO( &ctx, 0, 0, M, N ) ;
+   /* Compute phi(0,0) = ctx.memo[0][0] by calling the recursive function EditDistance_Rec_CO */
+   PerfCounters_phase( PERF_FILL ) ;
+   long res = ((ctx.M == 0) || (ctx.N == 0)) ? Cell_get( ctx.memo[0], 0, ctx.width ) : EditDistance_Rec_CO( &ctx, 0, 0, ctx.M, ctx.N ) ;
+   PerfCounters_phase( PERF_TEARDOWN ) ;
+   return res ;
+}
 
-   { /* Deallocation of ctx.memo */
-      for (int i=0; i <= M; ++i) free( ctx.memo[i] ) ;
-      free( ctx.memo ) ;
+/* EditDistance_CO_Par_Packed : cf .h for specification 
+ * The whole table is the first block of the pool: the blocks submit their quadrants, stage by stage (cf CO_ParFrame)
+ */
+long EditDistance_CO_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws)
+{
+   struct NW_MemoContext ctx;
+   EditDistance_CO_Init( &ctx, A, B, ws ) ;
+
+   PerfCounters_phase( PERF_FILL ) ;
+   if ((ctx.M > 0) && (ctx.N > 0))
+   {  struct ThreadPool *pool = ThreadPool_create( nthreads ) ;
+      EditDistance_CO_ParSpawn( &ctx, pool, NULL, 0, 0, ctx.M, ctx.N ) ;
+      ThreadPool_wait( pool ) ;
+      ThreadPool_destroy( pool ) ;
    }
+   long res = Cell_get( ctx.memo[0], 0, ctx.width ) ;
+   PerfCounters_phase( PERF_TEARDOWN ) ;
    return res ;
 }
 
+/* EditDistance_CO : cf .h for specification 
+ * Chars that are not bases are skipped once for all by the packing, then EditDistance_CO_Packed is called 
+ * with a workspace of its own
+ */
+long EditDistance_CO(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct PackedSequence PA, PB ;
+   Packed_init( &PA, A, lengthA ) ;
+   Packed_init( &PB, B, lengthB ) ;
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   long res = EditDistance_CO_Packed( &PA, &PB, &ws ) ;
+   Workspace_release( &ws ) ;
+   Packed_free( &PA ) ;
+   Packed_free( &PB ) ;
+   return res ;
+}
+
+/* EditDistance_CO_Par : cf .h for specification 
+ */
+long EditDistance_CO_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads)
+{
+   struct PackedSequence PA, PB ;
+   Packed_init( &PA, A, lengthA ) ;
+   Packed_init( &PB, B, lengthB ) ;
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   long res = EditDistance_CO_Par_Packed( &PA, &PB, nthreads, &ws ) ;
+   Workspace_release( &ws ) ;
+   Packed_free( &PA ) ;
+   Packed_free( &PB ) ;
+   return res ;
+}
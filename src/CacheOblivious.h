@@ -6,6 +6,8 @@
  */
 
 #include "Globals.h" /* have all the cost definitions */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "Workspace.h" /* the arena of the table */
 
 /********************************************************************************
  *  Iterative cache aware algorithm 
@@ -25,5 +27,34 @@
  * 
  * If lengthA < lengthB, the sequences A and B are swapped.
  *
+ * The chars that are not bases are skipped once before the computation. The leaf blocks 
+ * (of at most _tuning.co_leaf bases per side, cf Tuning.h) are swept by anti-diagonals whose cells are computed with SIMD 
+ * instructions (SSE4.1, AVX2 or AVX-512, selected at load time), on 16 bits offsets from a cell
+ * of the block; the cells of the table are on 2, 4 or 8 bytes (cf CellWidth.h).
  */
 long EditDistance_CO(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_CO_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_CO on sequences already packed (cf Packed_init); the table is one array of
+ * the arena of ws (cf Arena.h), reused by the next computations with ws
+ */
+long EditDistance_CO_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_CO_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads);
+ * \brief same as EditDistance_CO with nthreads threads (if <= 0: number of processors online)
+ *
+ * The recursion cuts a block in four quadrants instead of two halves: once the bottom-right quadrant is 
+ * computed, the top-right and bottom-left ones are independent and run concurrently, then the top-left one.
+ * Each block is a task of a work stealing pool (cf ThreadPool.h) that submits its quadrants and is completed 
+ * by the last one of them (no thread waits for a block). A block with both sides at most 4 leaf sides is one task, 
+ * computed by the sequential recursion of EditDistance_CO: the leaf blocks and the locality are the same.
+ */
+long EditDistance_CO_Par(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads);
+
+/**
+ * \fn long EditDistance_CO_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws);
+ * \brief same as EditDistance_CO_Par on sequences already packed (cf Packed_init); the table is in the arena of ws
+ */
+long EditDistance_CO_Par_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Workspace *ws);
@@ -0,0 +1,73 @@
+/**
+ * \file CellWidth.h
+ * \brief width of the cells of the tables: 2, 4 or 8 bytes, the smallest one that holds every distance of the table
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * A cell phi(i,j) of the table of sequences of m and n bases is at most indel * (m + n) (all the bases
+ * deleted then inserted): an int16_t is enough for short sequences, an int32_t for less than about 1 G bases,
+ * a long beyond. The engines choose the width once (Cell_width) and call a kernel written once with Cell_get and
+ * Cell_set on a width given as a constant: the kernels are CELL_KERNEL (always inlined), so the compiler makes
+ * one copy per width, without any test per cell, eg
+ *    switch (Cell_width( m, n )) { case 2 : res = Kernel( ..., 2 ) ; ... }
+ * Halving the cells doubles the part of the table held by the caches, and the number of lanes of a vector.
+ */
+
+#ifndef __CELL_WIDTH_h__
+#define __CELL_WIDTH_h__
+
+#include <stdint.h>
+#include "Scoring.h" /* _scoring.indel */
+
+/** \def CELL_KERNEL
+ * \brief a kernel on cells of a width given as a constant by its caller: inlined in each caller, specialized on the width
+ */
+#if defined(__GNUC__)
+#define CELL_KERNEL static inline __attribute__((always_inline))
+#else
+#define CELL_KERNEL static inline
+#endif
+
+/** \def SIMD_CLONES
+ * \brief compiles a function for several instruction sets (AVX-512 with the byte and word lanes of Skylake, AVX-512,
+ * AVX2, SSE4.1 and generic x86-64), the best one for the processor being chosen at load time
+ */
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__clang__)
+#define SIMD_CLONES __attribute__((target_clones("arch=skylake-avx512", "avx512f", "avx2", "sse4.1", "default")))
+#else
+#define SIMD_CLONES
+#endif
+
+/**
+ * \fn static inline int Cell_width(size_t m, size_t n)
+ * \brief the width in bytes (2, 4 or 8) of the cells of a table of sequences of m and n bases
+ */
+static inline int Cell_width(size_t m, size_t n)
+{
+   double bound = (double) _scoring.indel * ((double) m + (double) n) ;
+   return (bound <= INT16_MAX) ? 2 : (bound <= INT32_MAX) ? 4 : 8 ;
+}
+
+/**
+ * \fn static inline long Cell_get(const void *cells, size_t k, int width)
+ * \brief the cell k of the array cells of cells of width bytes
+ */
+static inline long Cell_get(const void *cells, size_t k, int width)
+{
+   return (width == 2) ? (long) ((const int16_t *) cells)[k]
+        : (width == 4) ? (long) ((const int32_t *) cells)[k]
+        : ((const long *) cells)[k] ;
+}
+
+/**
+ * \fn static inline void Cell_set(void *cells, size_t k, int width, long value)
+ * \brief sets the cell k of the array cells of cells of width bytes to value (that fits in the width)
+ */
+static inline void Cell_set(void *cells, size_t k, int width, long value)
+{
+   if (width == 2) ((int16_t *) cells)[k] = (int16_t) value ;
+   else if (width == 4) ((int32_t *) cells)[k] = (int32_t) value ;
+   else ((long *) cells)[k] = value ;
+}
+
+#endif /* __CELL_WIDTH_h__ */
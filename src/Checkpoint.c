@@ -0,0 +1,258 @@
+/**
+ * \file Checkpoint.c
+ * \brief checkpoints of the frontier of a long computation of a distance, written by a thread, to resume it
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Checkpoint.h
+ */
+
+#include "Checkpoint.h"
+#include "Scoring.h" /* the costs, part of the identity of a computation */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <err.h>
+#include <errno.h>
+#include <inttypes.h> /* for PRIu64 */
+#include <signal.h> /* for sigaction */
+#include <string.h> /* for memcpy, strcmp and strncpy */
+#include <time.h> /* for clock_gettime */
+#include <unistd.h> /* for fsync, unlink and _exit */
+
+struct Checkpoint *_checkpoint = NULL ;
+
+/** \def CHECKPOINT_MAGIC
+ * \brief first 8 bytes of a checkpoint file (the last 2 ones: version of the format)
+ */
+#define CHECKPOINT_MAGIC "EDCKPT01"
+
+/**
+ * \struct CheckpointHeader
+ * \brief beginning of a checkpoint file, followed by the 2 arrays of the frontier
+ */
+struct CheckpointHeader
+{  char magic[8] ;          /*!< CHECKPOINT_MAGIC */
+   char engine[16] ;        /*!< name of the engine, '\0' terminated */
+   uint64_t identity[5] ;   /*!< bases of X and Y, FNV-1a of the bases of X and Y, FNV-1a of the costs */
+   uint64_t position ;      /*!< position of the frontier (row, anti-diagonal ...) */
+   uint64_t bytes[2] ;      /*!< sizes of the arrays */
+   uint64_t checksum ;      /*!< FNV-1a of the arrays */
+} ;
+
+/* FNV-1a hash of the bytes data[0 .. size-1], continuing from hash (FNV offset basis for a new hash) */
+#define FNV_BASIS 14695981039346656037ULL
+static uint64_t Checkpoint_Fnv(uint64_t hash, const void *data, size_t size)
+{
+   const unsigned char *p = (const unsigned char *) data ;
+   for (size_t k = 0; k < size; ++k) hash = (hash ^ p[k]) * 1099511628211ULL ;
+   return hash ;
+}
+
+/* FNV-1a hash of the bases of ps (enum Base, one byte each), unpacked by chunks */
+static uint64_t Checkpoint_HashBases(const struct PackedSequence *ps)
+{
+   unsigned char chunk[4096] ;
+   uint64_t hash = FNV_BASIS ;
+   for (size_t k = 0; k < ps->length; k += sizeof(chunk))
+   {  size_t count = (ps->length - k < sizeof(chunk)) ? ps->length - k : sizeof(chunk) ;
+      Packed_unpack( ps, k, count, chunk ) ;
+      hash = Checkpoint_Fnv( hash, chunk, count ) ;
+   }
+   return hash ;
+}
+
+/* signal received by Checkpoint_Signal (SIGTERM or SIGINT), 0 if none */
+static volatile sig_atomic_t _signal = 0 ;
+static struct sigaction _previous[2] ; /* actions of SIGTERM and SIGINT before Checkpoint_start */
+
+/* on SIGTERM or SIGINT: a last checkpoint, after which the writer exits */
+static void Checkpoint_Signal(int sig)
+{
+   _signal = sig ;
+   if (_checkpoint != NULL) atomic_store( &_checkpoint->requested, 1 ) ;
+}
+
+/* the absolute time (CLOCK_REALTIME, cf pthread_cond_timedwait) interval seconds from now */
+static struct timespec Checkpoint_Deadline(double interval)
+{
+   struct timespec t ;
+   clock_gettime( CLOCK_REALTIME, &t ) ;
+   long ns = t.tv_nsec + (long) ((interval - (double) (long) interval) * 1e9) ;
+   t.tv_sec += (time_t) interval + ns / 1000000000L ;
+   t.tv_nsec = ns % 1000000000L ;
+   return t ;
+}
+
+/* writes the buffer of c in c->tmp, then renames it to c->path; warns on failure (the previous checkpoint stays) */
+static void Checkpoint_Write(struct Checkpoint *c)
+{
+   FILE *f = fopen( c->tmp, "wb" ) ;
+   if (f == NULL) { warn("checkpoint %s", c->tmp) ; return ; }
+   int ok = (fwrite( c->buffer, 1, c->size, f ) == c->size) && (fflush( f ) == 0) && (fsync( fileno( f ) ) == 0) ;
+   ok = (fclose( f ) == 0) && ok ;
+   if (! ok || (rename( c->tmp, c->path ) != 0))
+   {  warn("checkpoint %s", c->path) ;
+      unlink( c->tmp ) ;
+   }
+}
+
+/* the writer thread: requests a checkpoint every interval seconds and writes the ones saved by the engine */
+static void *Checkpoint_Writer(void *arg)
+{
+   struct Checkpoint *c = (struct Checkpoint *) arg ;
+   pthread_mutex_lock( &c->lock ) ;
+   struct timespec deadline = Checkpoint_Deadline( c->interval ) ;
+   while (! c->stop)
+   {  if (c->ready) /* the engine does not touch the buffer until ready is reset */
+      {  pthread_mutex_unlock( &c->lock ) ;
+         Checkpoint_Write( c ) ;
+         if (_signal != 0)
+         {  warnx("signal %d: checkpoint written in %s (continue with --resume)", (int) _signal, c->path) ;
+            _exit(128 + _signal) ;
+         }
+         pthread_mutex_lock( &c->lock ) ;
+         c->ready = 0 ;
+         deadline = Checkpoint_Deadline( c->interval ) ;
+      }
+      else if (pthread_cond_timedwait( &c->cond, &c->lock, &deadline ) == ETIMEDOUT)
+      {  atomic_store( &c->requested, 1 ) ;
+         deadline = Checkpoint_Deadline( c->interval ) ;
+      }
+   }
+   pthread_mutex_unlock( &c->lock ) ;
+   return NULL ;
+}
+
+/* Checkpoint_init : cf .h for specification
+ */
+void Checkpoint_init(struct Checkpoint *c, const char *path, double interval, int resume)
+{
+   memset( c, 0, sizeof(*c) ) ;
+   size_t size = strlen( path ) + 5 ;
+   c->path = strdup( path ) ;
+   c->tmp = (char *) malloc( size ) ;
+   if ((c->path == NULL) || (c->tmp == NULL)) { perror("Checkpoint_init: malloc"); exit(EXIT_FAILURE); }
+   snprintf( c->tmp, size, "%s.tmp", path ) ;
+   c->interval = interval ;
+   c->resume = resume ;
+   atomic_init( &c->requested, 0 ) ;
+   pthread_mutex_init( &c->lock, NULL ) ;
+   pthread_cond_init( &c->cond, NULL ) ;
+}
+
+/* Checkpoint_start : cf .h for specification
+ */
+void Checkpoint_start(struct Checkpoint *c, const char *engine, const struct PackedSequence *X, const struct PackedSequence *Y)
+{
+   uint64_t costs = Checkpoint_Fnv( FNV_BASIS, _scoring.sub, sizeof(_scoring.sub) ) ;
+   costs = Checkpoint_Fnv( costs, &_scoring.indel, sizeof(_scoring.indel) ) ;
+   costs = Checkpoint_Fnv( costs, &_scoring.gap_open, sizeof(_scoring.gap_open) ) ;
+   c->identity[0] = X->length ;
+   c->identity[1] = Y->length ;
+   c->identity[2] = Checkpoint_HashBases( X ) ;
+   c->identity[3] = Checkpoint_HashBases( Y ) ;
+   c->identity[4] = costs ;
+   memset( c->engine, 0, sizeof(c->engine) ) ;
+   strncpy( c->engine, engine, sizeof(c->engine) - 1 ) ;
+   atomic_store( &c->requested, 0 ) ;
+   c->ready = 0 ;
+   c->stop = 0 ;
+   _signal = 0 ;
+   if (pthread_create( &c->writer, NULL, Checkpoint_Writer, c ) != 0) { perror("Checkpoint_start: pthread_create"); exit(EXIT_FAILURE); }
+   c->running = 1 ;
+   struct sigaction action ;
+   memset( &action, 0, sizeof(action) ) ;
+   action.sa_handler = Checkpoint_Signal ;
+   sigemptyset( &action.sa_mask ) ;
+   sigaction( SIGTERM, &action, &_previous[0] ) ;
+   sigaction( SIGINT, &action, &_previous[1] ) ;
+}
+
+/* Checkpoint_restore : cf .h for specification
+ */
+uint64_t Checkpoint_restore(struct Checkpoint *c, void *a, size_t a_bytes, void *b, size_t b_bytes)
+{
+   if (! c->resume) return 0 ;
+   FILE *f = fopen( c->path, "rb" ) ;
+   if (f == NULL)
+   {  if (errno != ENOENT) err(1, "checkpoint %s", c->path) ;
+      warnx("no checkpoint %s: the computation starts from the beginning", c->path) ;
+      return 0 ;
+   }
+   struct CheckpointHeader header ;
+   if ((fread( &header, sizeof(header), 1, f ) != 1) || (memcmp( header.magic, CHECKPOINT_MAGIC, 8 ) != 0))
+      errx(1, "%s is not a checkpoint of distanceEdition", c->path) ;
+   header.engine[sizeof(header.engine) - 1] = '\0' ;
+   if ((strcmp( header.engine, c->engine ) != 0) || (memcmp( header.identity, c->identity, sizeof(c->identity) ) != 0))
+      errx(1, "checkpoint %s is not of this computation (engine %s, sequences of %" PRIu64 " and %" PRIu64 " bases: "
+              "other engine, sequences or costs)", c->path, header.engine, header.identity[0], header.identity[1]) ;
+   if ((header.bytes[0] != a_bytes) || (header.bytes[1] != b_bytes)
+       || (fread( a, 1, a_bytes, f ) != a_bytes) || (fread( b, 1, b_bytes, f ) != b_bytes)
+       || (Checkpoint_Fnv( Checkpoint_Fnv( FNV_BASIS, a, a_bytes ), b, b_bytes ) != header.checksum))
+      errx(1, "checkpoint %s is corrupted", c->path) ;
+   fclose( f ) ;
+   fprintf( stderr, "checkpoint %s: %s resumed at %" PRIu64 "\n", c->path, c->engine, header.position ) ;
+   return header.position ;
+}
+
+/* Checkpoint_save : cf .h for specification
+ */
+void Checkpoint_save(struct Checkpoint *c, uint64_t position, const void *a, size_t a_bytes, const void *b, size_t b_bytes)
+{
+   pthread_mutex_lock( &c->lock ) ;
+   if (! c->ready) /* else the writer is still writing the previous one */
+   {  size_t size = sizeof(struct CheckpointHeader) + a_bytes + b_bytes ;
+      if (size > c->capacity)
+      {  unsigned char *buffer = (unsigned char *) realloc( c->buffer, size ) ;
+         if (buffer == NULL) { perror("Checkpoint_save: realloc"); exit(EXIT_FAILURE); }
+         c->buffer = buffer ;
+         c->capacity = size ;
+      }
+      struct CheckpointHeader header ;
+      memcpy( header.magic, CHECKPOINT_MAGIC, 8 ) ;
+      memcpy( header.engine, c->engine, sizeof(header.engine) ) ;
+      memcpy( header.identity, c->identity, sizeof(header.identity) ) ;
+      header.position = position ;
+      header.bytes[0] = a_bytes ;
+      header.bytes[1] = b_bytes ;
+      header.checksum = Checkpoint_Fnv( Checkpoint_Fnv( FNV_BASIS, a, a_bytes ), b, b_bytes ) ;
+      memcpy( c->buffer, &header, sizeof(header) ) ;
+      if (a_bytes > 0) memcpy( c->buffer + sizeof(header), a, a_bytes ) ;
+      if (b_bytes > 0) memcpy( c->buffer + sizeof(header) + a_bytes, b, b_bytes ) ;
+      c->size = size ;
+      c->ready = 1 ;
+      pthread_cond_signal( &c->cond ) ;
+   }
+   atomic_store( &c->requested, 0 ) ;
+   pthread_mutex_unlock( &c->lock ) ;
+}
+
+/* Checkpoint_finish : cf .h for specification
+ */
+void Checkpoint_finish(struct Checkpoint *c)
+{
+   if (! c->running) return ;
+   pthread_mutex_lock( &c->lock ) ;
+   c->stop = 1 ;
+   pthread_cond_signal( &c->cond ) ;
+   pthread_mutex_unlock( &c->lock ) ;
+   pthread_join( c->writer, NULL ) ;
+   c->running = 0 ;
+   sigaction( SIGTERM, &_previous[0], NULL ) ;
+   sigaction( SIGINT, &_previous[1], NULL ) ;
+   unlink( c->path ) ;
+   unlink( c->tmp ) ;
+}
+
+/* Checkpoint_free : cf .h for specification
+ */
+void Checkpoint_free(struct Checkpoint *c)
+{
+   Checkpoint_finish( c ) ;
+   pthread_mutex_destroy( &c->lock ) ;
+   pthread_cond_destroy( &c->cond ) ;
+   free( c->path ) ;
+   free( c->tmp ) ;
+   free( c->buffer ) ;
+}
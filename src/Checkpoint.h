@@ -0,0 +1,109 @@
+/**
+ * \file Checkpoint.h
+ * \brief checkpoints of the frontier of a long computation of a distance, written by a thread, to resume it
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * A distance between sequences of tens of millions of bases takes hours even in linear space. With a checkpoint
+ * (distanceEdition --checkpoint=file), the linear space engines (ls and diff) save their frontier at regular
+ * intervals: the row of the table and its number for ls, the differences of the last column and row and the number
+ * of the anti-diagonal for diff. A run preempted then restarted with --resume continues from the last checkpoint.
+ *
+ * The compute thread never waits for the disk: a writer thread requests a checkpoint every interval seconds
+ * (Checkpoint_requested, one load per row or anti-diagonal), the engine copies its frontier in a buffer
+ * (Checkpoint_save, a memcpy under a mutex that the writer does not hold while writing), and the writer writes
+ * the buffer in file.tmp then renames it to file, so that the file is always a complete checkpoint.
+ * On SIGTERM or SIGINT (eg the drain of a node), a last checkpoint is written before the program exits.
+ *
+ * A checkpoint file is a header (the magic "EDCKPT01", the engine, the number of bases and the FNV-1a hash of the
+ * bases of both sequences, a hash of the costs, the position and the sizes of the 2 arrays of the frontier, a hash
+ * of the arrays), followed by the arrays, in the byte order of the machine that wrote it. It is removed when
+ * the distance is computed.
+ */
+
+#ifndef __CHECKPOINT_h__
+#define __CHECKPOINT_h__
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/**
+ * \struct Checkpoint
+ * \brief a checkpoint file and its writer thread
+ */
+struct Checkpoint
+{  char *path ;              /*!< the checkpoint file */
+   char *tmp ;               /*!< path.tmp, written then renamed to path */
+   double interval ;         /*!< seconds between two checkpoints */
+   int resume ;              /*!< 1 if the computation continues from path (--resume) */
+   unsigned char *buffer ;   /*!< the last checkpoint: header and arrays */
+   size_t size ;             /*!< bytes of the checkpoint in buffer */
+   size_t capacity ;         /*!< bytes allocated for buffer */
+   uint64_t identity[5] ;    /*!< bases of the sequences, hashes of their bases and of the costs */
+   char engine[16] ;         /*!< name of the engine */
+   atomic_int requested ;    /*!< 1 if the engine must call Checkpoint_save */
+   int ready ;               /*!< 1 if buffer is to be written */
+   int stop ;                /*!< 1 when the writer must stop */
+   int running ;             /*!< 1 between Checkpoint_start and Checkpoint_finish */
+   pthread_mutex_t lock ;    /*!< protects buffer, size, ready and stop */
+   pthread_cond_t cond ;     /*!< signals ready or stop to the writer */
+   pthread_t writer ;        /*!< the writer thread */
+} ;
+
+/**
+ * \var _checkpoint
+ * \brief the checkpoint of the engines, NULL if none (the default); used by EditDistance_LS_Packed and
+ * EditDistance_Diff_Packed, for one pair at a time
+ */
+extern struct Checkpoint *_checkpoint ;
+
+/**
+ * \fn void Checkpoint_init(struct Checkpoint *c, const char *path, double interval, int resume)
+ * \brief a checkpoint in path every interval seconds, continuing from path if resume
+ */
+void Checkpoint_init(struct Checkpoint *c, const char *path, double interval, int resume) ;
+
+/**
+ * \fn void Checkpoint_start(struct Checkpoint *c, const char *engine, const struct PackedSequence *X, const struct PackedSequence *Y)
+ * \brief starts the writer thread for the computation of engine on X (rows) and Y (columns), with the costs of _scoring
+ */
+void Checkpoint_start(struct Checkpoint *c, const char *engine, const struct PackedSequence *X, const struct PackedSequence *Y) ;
+
+/**
+ * \fn uint64_t Checkpoint_restore(struct Checkpoint *c, void *a, size_t a_bytes, void *b, size_t b_bytes)
+ * \brief with --resume, reads the frontier of the file in a[0 .. a_bytes-1] and b[0 .. b_bytes-1] and returns its position;
+ * 0 (a and b unchanged) without --resume or if there is no file; exits if the file is not a checkpoint of the same
+ * computation (other engine, sequences or costs) or is corrupted
+ */
+uint64_t Checkpoint_restore(struct Checkpoint *c, void *a, size_t a_bytes, void *b, size_t b_bytes) ;
+
+/**
+ * \fn static inline int Checkpoint_requested(struct Checkpoint *c)
+ * \brief 1 if the engine must save its frontier by Checkpoint_save
+ */
+static inline int Checkpoint_requested(struct Checkpoint *c)
+{
+   return atomic_load_explicit( &c->requested, memory_order_relaxed ) ;
+}
+
+/**
+ * \fn void Checkpoint_save(struct Checkpoint *c, uint64_t position, const void *a, size_t a_bytes, const void *b, size_t b_bytes)
+ * \brief copies the frontier a, b of the engine at position (its meaning is the engine's) for the writer thread
+ */
+void Checkpoint_save(struct Checkpoint *c, uint64_t position, const void *a, size_t a_bytes, const void *b, size_t b_bytes) ;
+
+/**
+ * \fn void Checkpoint_finish(struct Checkpoint *c)
+ * \brief stops the writer thread and removes the checkpoint file: the distance is computed
+ */
+void Checkpoint_finish(struct Checkpoint *c) ;
+
+/**
+ * \fn void Checkpoint_free(struct Checkpoint *c)
+ * \brief frees the memory of c
+ */
+void Checkpoint_free(struct Checkpoint *c) ;
+
+#endif /* __CHECKPOINT_h__ */
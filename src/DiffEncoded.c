@@ -0,0 +1,291 @@
+/**
+ * \file DiffEncoded.c
+ * \brief linear space algorithms on narrow lanes that compute only the distance between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see DiffEncoded.h
+ */
+
+#include "DiffEncoded.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "Checkpoint.h" /* checkpoints of the differences */
+#include "Progress.h" /* count of the cells computed */
+#include "CellWidth.h" /* SIMD_CLONES */
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <stdint.h> 
+#include <string.h> /* for memset */
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+/*
+ * Unpacks the bases of A and B in the slots 0 and 1 of ws: X receives the longest sequence, Y the shortest one.
+ */
+static void Diff_UnpackBases(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws,
+                             unsigned char **X, size_t *m, unsigned char **Y, size_t *n)
+{
+   if (A->length < B->length) 
+   {  const struct PackedSequence *aux = B ; B = A ; A = aux ;
+   }
+   *m = A->length ;
+   *n = B->length ;
+   *X = (unsigned char *) Workspace_get( ws, 0, *m + 1 ) ;
+   *Y = (unsigned char *) Workspace_get( ws, 1, *n + 1 ) ;
+   Packed_unpack( A, 0, *m, *X ) ;
+   Packed_unpack( B, 0, *n, *Y ) ;
+}
+
+#if DIFF_ENCODING_LEGAL
+
+/*
+ * static void Diff_Diagonal(int8_t *dv, int8_t *dh, const unsigned char *x, const unsigned char *y, size_t count)
+ * \brief computes count cells of an anti-diagonal; the k-th one reads and updates dv[k] and dh[k], 
+ * it substitutes x[k] by y[k].
+ */
+SIMD_CLONES
+static void Diff_Diagonal(int8_t *restrict dv, int8_t *restrict dh, 
+                          const unsigned char *restrict x, const unsigned char *restrict y, size_t count)
+{
+   for (size_t k = 0; k < count; ++k)
+   {  int8_t unknown = (x[k] == UNKOWN_BASE) ;
+      int8_t z = unknown * SUBSTITUTION_UNKNOWN_COST + ((1 - unknown) & (x[k] != y[k])) * SUBSTITUTION_COST ;
+      int8_t a = dv[k], b = dh[k] ;
+      int8_t cas2 = a + INSERTION_COST ;
+      int8_t cas3 = b + INSERTION_COST ;
+      z = (cas2 < z) ? cas2 : z ;
+      z = (cas3 < z) ? cas3 : z ;
+      dv[k] = z - b ;
+      dh[k] = z - a ;
+   }
+}
+
+/*
+ * static long Diff_Sweep(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws,
+ *                        struct Checkpoint *checkpoint)
+ * \brief EditDistance_Diff_Bases, the differences dv and dh and the number of the next anti-diagonal being saved
+ * in checkpoint if it is not NULL when its writer requests it, and restored with --resume (cf Checkpoint.h).
+ *
+ * Cell (i,j), 1 <= i <= m, 1 <= j <= n, is on anti-diagonal d = i+j. 
+ * dv[i] is the vertical difference of row i for the last computed column;
+ * dh and Y are stored reversed (index n-j) so that, along an anti-diagonal, 
+ * dv[i], dh[n-j], X[i-1] and Y[j-1] are all at consecutive addresses.
+ */
+static long Diff_Sweep(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws,
+                       struct Checkpoint *checkpoint)
+{
+   if ((m == 0) || (n == 0)) return INSERTION_COST * (long) (m + n) ;
+
+   int8_t *dv = (int8_t *) Workspace_get( ws, 2, m + 1 ) ;   /* dv[1..m] */
+   int8_t *dh = (int8_t *) Workspace_get( ws, 3, 2 * (n + 1) ) ;   /* dh[n-j], j = 1..n */
+   unsigned char *Yr = (unsigned char *) (dh + n + 1) ; /* Yr[n-j] = Y[j-1] */
+   for (size_t i = 0; i <= m; ++i) dv[i] = INSERTION_COST ; /* phi(i,0) = INSERTION_COST * i */
+   for (size_t k = 0; k <= n; ++k) dh[k] = INSERTION_COST ; /* phi(0,j) = INSERTION_COST * j */
+   for (size_t j = 1; j <= n; ++j) Yr[n-j] = Y[j-1] ;
+   size_t d0 = 2 ;
+   if (checkpoint != NULL)
+   {  size_t d = (size_t) Checkpoint_restore( checkpoint, dv, m + 1, dh, n + 1 ) ;
+      if (d > d0) d0 = d ;
+      uint64_t cells = 0 ; /* the cells of the anti-diagonals 2 .. d0-1 */
+      for (d = 2; d < d0; ++d) cells += ((d - 1 < m) ? d - 1 : m) - ((d > n + 1) ? d - n : 1) + 1 ;
+      Progress_cells( cells ) ;
+   }
+
+   for (size_t d = d0; d <= m + n; ++d)
+   {  if ((checkpoint != NULL) && Checkpoint_requested( checkpoint ))
+         Checkpoint_save( checkpoint, d, dv, m + 1, dh, n + 1 ) ;
+      size_t ilo = (d > n + 1) ? d - n : 1 ;
+      size_t ihi = (d - 1 < m) ? d - 1 : m ;
+      size_t k = n + ilo - d ; /* = n - j for i = ilo */
+      Diff_Diagonal( dv + ilo, dh + k, X + ilo - 1, Yr + k, ihi - ilo + 1 ) ;
+      Progress_cells( ihi - ilo + 1 ) ;
+   }
+
+   /* phi(m,n) = phi(0,n) + sum of the vertical differences of the last column */
+   long res = INSERTION_COST * (long) n ;
+   for (size_t i = 1; i <= m; ++i) res += dv[i] ;
+
+   return res ;
+}
+
+/* EditDistance_Diff_Bases : cf .h for specification
+ */
+long EditDistance_Diff_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws)
+{
+   return Diff_Sweep( X, m, Y, n, ws, NULL ) ;
+}
+
+/* EditDistance_Diff_Packed : cf .h for specification 
+ */
+long EditDistance_Diff_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   unsigned char *X, *Y ;
+   size_t m, n ;
+   Diff_UnpackBases( A, B, ws, &X, &m, &Y, &n ) ;
+   PerfCounters_phase( PERF_FILL ) ; /* with the initialization of the differences */
+   if (_checkpoint == NULL) return Diff_Sweep( X, m, Y, n, ws, NULL ) ;
+   if (A->length >= B->length) Checkpoint_start( _checkpoint, "diff", A, B ) ;
+   else Checkpoint_start( _checkpoint, "diff", B, A ) ;
+   long res = Diff_Sweep( X, m, Y, n, ws, _checkpoint ) ;
+   Checkpoint_finish( _checkpoint ) ;
+   return res ;
+}
+
+/* EditDistance_Diff : cf .h for specification 
+ */
+long EditDistance_Diff(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_Diff_Packed( &X, &Y, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
+
+#endif /* DIFF_ENCODING_LEGAL */
+
+/** \def WORD_BITS
+ * \brief number of bases of the pattern per block (bits in a uint64_t)
+ */
+#define WORD_BITS 64
+
+/*
+ * static int BitPar_Block(uint64_t *VP, uint64_t *VN, uint64_t Eq, int hin)
+ * \brief advances one block of 64 cells of a column by one text base 
+ * \param VP, VN : positive and negative vertical differences of the block, updated
+ * \param Eq : bit k is set iff the base of the text matches base k of the block 
+ * \param hin : horizontal difference (+1, 0 or -1) entering at the top of the block
+ * \return the horizontal difference leaving at the bottom of the block
+ */
+static inline int BitPar_Block(uint64_t *VP, uint64_t *VN, uint64_t Eq, int hin)
+{
+   uint64_t Pv = *VP, Mv = *VN ;
+   uint64_t hin_neg = (hin < 0) ;
+   uint64_t hin_pos = (hin > 0) ;
+   uint64_t Xv = Eq | Mv ;
+   Eq |= hin_neg ;
+   uint64_t Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq ;
+   uint64_t Ph = Mv | ~(Xh | Pv) ;
+   uint64_t Mh = Pv & Xh ;
+   int hout = (int) (Ph >> (WORD_BITS-1)) - (int) (Mh >> (WORD_BITS-1)) ;
+   Ph = (Ph << 1) | hin_pos ;
+   Mh = (Mh << 1) | hin_neg ;
+   *VP = Mh | ~(Xv | Ph) ;
+   *VN = Ph & Xv ;
+   return hout ;
+}
+
+/*
+ * static int BitPar_Column(uint64_t *VP, uint64_t *VN, const uint64_t *Peq, size_t nb, enum Base x)
+ * \brief advances the column of the table by the text base x (all the blocks, from the top)
+ * \return phi(i+1, 64*nb) - phi(i, 64*nb)
+ */
+static inline int BitPar_Column(uint64_t *VP, uint64_t *VN, const uint64_t *Peq, size_t nb, enum Base x)
+{
+   const uint64_t *Eq = (x == UNKOWN_BASE) ? NULL : Peq + x*nb ;
+   int h = 1 ; /* phi(i+1,0) - phi(i,0) */
+   for (size_t b = 0; b < nb; ++b) h = BitPar_Block( &VP[b], &VN[b], (Eq == NULL) ? 0 : Eq[b], h ) ;
+   return h ;
+}
+
+/*
+ * Initial column phi(0,j) = j of the nb blocks of VP and VN 
+ */
+static void BitPar_Init(uint64_t *VP, uint64_t *VN, size_t nb)
+{
+   for (size_t b = 0; b < nb; ++b) 
+   {  VP[b] = ~(uint64_t) 0 ;
+      VN[b] = 0 ;
+   }
+}
+
+/*
+ * phi(m, n) from score = phi(m, 64*nb): removes the vertical differences of the padding positions n .. 64*nb-1 
+ */
+static long BitPar_Unpad(const uint64_t *VP, const uint64_t *VN, size_t nb, size_t n, long score)
+{
+   for (size_t j = n; j < nb * WORD_BITS; ++j)
+   {  uint64_t bit = (uint64_t) 1 << (j % WORD_BITS) ;
+      if (VP[nb-1] & bit) score-- ;
+      if (VN[nb-1] & bit) score++ ;
+   }
+   return score ;
+}
+
+/* EditDistance_BitPar_Bases : cf .h for specification.
+ * The pattern Y is on the vertical axis, split in nb blocks of 64 bases (the last one is padded 
+ * with positions that match no base); the text X is read base by base.
+ * Peq[c*nb + b] has bit k set iff base 64*b+k of Y is c. An unknown base N matches nothing.
+ */
+long EditDistance_BitPar_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws)
+{
+   if ((m == 0) || (n == 0)) return (long) (m + n) ;
+   if (m < n) /* the pattern is the shortest sequence */
+   {  const unsigned char *aux = X ; X = Y ; Y = aux ;
+      size_t aux_size = m ; m = n ; n = aux_size ;
+   }
+
+   size_t nb = (n + WORD_BITS - 1) / WORD_BITS ;
+   uint64_t *Peq = (uint64_t *) Workspace_get( ws, 2, (UNKOWN_BASE+1) * nb * sizeof(uint64_t) ) ;
+   uint64_t *VP = (uint64_t *) Workspace_get( ws, 3, 2 * nb * sizeof(uint64_t) ) ;
+   uint64_t *VN = VP + nb ;
+   memset( Peq, 0, (UNKOWN_BASE+1) * nb * sizeof(uint64_t) ) ;
+   for (size_t j = 0; j < n; ++j)
+      if (Y[j] != UNKOWN_BASE) Peq[Y[j]*nb + j/WORD_BITS] |= (uint64_t) 1 << (j % WORD_BITS) ;
+   BitPar_Init( VP, VN, nb ) ;
+
+   long score = (long) (nb * WORD_BITS) ; /* phi(i, 64*nb) for the current text base i */
+   for (size_t i = 0; i < m; ++i) 
+   {  score += BitPar_Column( VP, VN, Peq, nb, X[i] ) ;
+      Progress_cells( n ) ;
+   }
+   return BitPar_Unpad( VP, VN, nb, n, score ) ;
+}
+
+/* EditDistance_BitPar_Packed : cf .h for specification.
+ * Same as EditDistance_BitPar_Bases, Peq being computed from the packed words of the pattern 
+ * (Packed_match: the 64 bits of a block at once) and the text being read in its packed form.
+ */
+long EditDistance_BitPar_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   const struct PackedSequence *X = (A->length >= B->length) ? A : B ; /* the pattern Y is the shortest sequence */
+   const struct PackedSequence *Y = (A->length >= B->length) ? B : A ;
+   size_t m = X->length, n = Y->length ;
+   if ((m == 0) || (n == 0)) return (long) (m + n) ;
+
+   size_t nb = (n + WORD_BITS - 1) / WORD_BITS ;
+   uint64_t *Peq = (uint64_t *) Workspace_get( ws, 2, (UNKOWN_BASE+1) * nb * sizeof(uint64_t) ) ;
+   uint64_t *VP = (uint64_t *) Workspace_get( ws, 3, 2 * nb * sizeof(uint64_t) ) ;
+   uint64_t *VN = VP + nb ;
+   for (int c = ADENINE; c <= URACILE; ++c)
+      for (size_t b = 0; b < nb; ++b) Peq[c*nb + b] = Packed_match( Y, b, c ) ;
+   BitPar_Init( VP, VN, nb ) ;
+   PerfCounters_phase( PERF_FILL ) ;
+
+   long score = (long) (nb * WORD_BITS) ;
+   for (size_t i = 0; i < m; ++i) 
+   {  score += BitPar_Column( VP, VN, Peq, nb, Packed_base( X, i ) ) ;
+      Progress_cells( n ) ;
+   }
+   return BitPar_Unpad( VP, VN, nb, n, score ) ;
+}
+
+/* EditDistance_BitPar : cf .h for specification 
+ */
+long EditDistance_BitPar(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_BitPar_Packed( &X, &Y, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file DiffEncoded.h
+ * \brief linear space algorithms on narrow lanes that compute only the distance between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Which kernel may be used depends on the costs: the ones defined in Globals.h for the difference recurrence
+ * (cf DIFF_ENCODING_LEGAL), the ones of _scoring for the bit-parallel algorithm (cf Scoring.h).
+ */
+
+#include "Globals.h" /* have all the cost definitions */
+#include "Scoring.h" /* costs chosen at run time */
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/********************************************************************************
+ *  Difference recurrence on 8 bits lanes 
+ */
+#if DIFF_ENCODING_LEGAL
+/**
+ * \fn long EditDistance_Diff(char* A, size_t lengthA, char* B, size_t lengthB);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1]
+ * \param A  : array of char representing a genetic sequence A 
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B 
+ * \return :  edit distance between A and B 
+ *
+ * EditDistance_Diff does not store the values phi(i,j) of the table but the differences 
+ * dv(i,j) = phi(i,j) - phi(i-1,j) and dh(i,j) = phi(i,j) - phi(i,j-1), which lie in 
+ * [-INSERTION_COST, INSERTION_COST] (Suzuki-Kasahara difference recurrence): 
+ *    z = min( substitution cost, dv(i,j-1) + INSERTION_COST, dh(i-1,j) + INSERTION_COST )
+ *    dv(i,j) = z - dh(i-1,j)   and   dh(i,j) = z - dv(i,j-1)
+ * They are stored in int8_t and the table is swept by anti-diagonals, so 32 (AVX2) 
+ * or 64 (AVX-512) cells are computed by each vector instruction.
+ * The memory used is lengthA + lengthB bytes for the differences, plus the bases.
+ *
+ * Only available if DIFF_ENCODING_LEGAL.
+ */
+long EditDistance_Diff(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_Diff_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_Diff on sequences already packed (cf Packed_init), the buffers being taken in ws 
+ * instead of allocated and freed (the bases are unpacked in one byte each in the slots 0 and 1, for the vector lanes)
+ */
+long EditDistance_Diff_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_Diff_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
+ * \brief same as EditDistance_Diff_Packed on sequences already unpacked (enum Base, cf Packed_unpack), 
+ * the buffers being taken in the slots 2 and 3 of ws
+ */
+long EditDistance_Diff_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
+#endif
+
+/********************************************************************************
+ *  Bit-parallel algorithm of Myers/Hyyro 
+ */
+/**
+ * \fn long EditDistance_BitPar(char* A, size_t lengthA, char* B, size_t lengthB);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1]
+ * \param A  : array of char representing a genetic sequence A 
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B 
+ * \return :  edit distance between A and B 
+ *
+ * EditDistance_BitPar encodes the vertical differences of a column of the table (+1, 0 or -1) 
+ * in two bit vectors and computes a new column with a few logical and arithmetic operations 
+ * on 64 bits words (Myers 1999, blocks of Hyyro 2003): 64 cells per operation.
+ * The shortest sequence is the "pattern", split in blocks of 64 bases.
+ *
+ * Computes the Levenshtein distance (all the operations cost 1, N matching nothing): only valid if UNIT_COST
+ * and _scoring is the default one, or if _scoring.model is SCORING_UNIT (cf Engine_available).
+ */
+long EditDistance_BitPar(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_BitPar_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_BitPar on sequences already packed (cf Packed_init), the buffers being taken in the 
+ * slots 2 and 3 of ws; the match masks of the pattern are computed 64 bases at a time on the packed words (cf Packed_match)
+ */
+long EditDistance_BitPar_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_BitPar_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
+ * \brief same as EditDistance_BitPar_Packed on sequences already unpacked (enum Base, cf Packed_unpack), 
+ * the buffers being taken in the slots 2 and 3 of ws
+ */
+long EditDistance_BitPar_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
@@ -0,0 +1,259 @@
+/**
+ * \file Engine.c
+ * \brief the engines built in the binary and the choice of an engine under a memory budget
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Engine.h
+ */
+
+#include "Engine.h"
+
+#include "Needleman-Wunsch-recmemo.h" // full table, recursive with memoization
+#include "Needleman-Wunsch-itmemo.h" // full table, iterative
+#include "CacheOblivious.h" // full table, cache oblivious recursion, sequential or parallel
+#include "CacheAware.h" // full table by tiles, and parallel tiled wavefront on the boundaries of the tiles
+#include "LinearSpace.h" // one row
+#include "DiffEncoded.h" // one row of differences on 8 bits, or bit-parallel
+#include "Banded.h" // band around the diagonal
+#include "AffineGap.h" // rows of the tables of Gotoh, affine gaps
+#include "Striped.h" // pipeline of processes by stripes of columns
+#include "Wavefront.h" // wavefronts of the costs (WFA)
+#include "characters_to_base.h" /* enum Base */
+#include "PerfCounters.h" /* marks of the entry and exit of the engines */
+#include "Progress.h" /* reports of the progress of the engines */
+#include "CellWidth.h" /* width of the cells of the tables */
+#include "Tuning.h" /* side of the tiles */
+#include "Scoring.h" /* costs of the operations, for the engines available */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for strcmp */
+#include <math.h> /* for sqrt */
+#include <unistd.h> /* for sysconf */
+
+/** \struct EngineSpec
+ * \brief name and estimated speed of an engine
+ */
+struct EngineSpec
+{  const char *name ;
+   double rate ;      /*!< cells per ns, on one core (measured on random sequences of 1 to 30 kbases) */
+   double overhead ;  /*!< fixed time of a call, in ns per thread (creation of the threads) */
+} ;
+
+static const struct EngineSpec _engines[ENGINE_COUNT] =
+{  [ENGINE_AUTO]   = { "auto",   0,    0 },
+   [ENGINE_NW_REC] = { "rec",    0.01, 0 },
+   [ENGINE_NW_IT]  = { "it",     0.04, 0 },
+   [ENGINE_CO]     = { "co",     0.07, 0 },
+   [ENGINE_CA]     = { "ca",     0.05, 0 },
+   [ENGINE_CO_PAR] = { "co-par", 0.07, 1e5 },
+   [ENGINE_TILED]  = { "tiled",  0.35, 1e5 },
+   [ENGINE_LS]     = { "ls",     0.25, 0 },
+   [ENGINE_DIFF]   = { "diff",   3.5,  0 },
+   [ENGINE_BITPAR] = { "bitpar", 5.0,  0 },
+   [ENGINE_BANDED] = { "banded", 0.3,  0 },
+   [ENGINE_GOTOH]  = { "gotoh",  0.2,  0 },
+   [ENGINE_STRIPED] = { "striped", 0.35, 1e6 },
+   [ENGINE_WFA]    = { "wfa",    0.05, 0 },   /* cells of the wavefronts per ns, with their extensions */
+} ;
+
+/** \def ENGINE_WFA_TRY
+ * \brief the attempt of ENGINE_WFA in auto mode costs at most 1/ENGINE_WFA_TRY of the estimated time of the engine chosen
+ */
+#define ENGINE_WFA_TRY 4
+
+enum Engine Engine_parse(const char *name)
+{
+   int e = 0 ;
+   while ((e < ENGINE_COUNT) && (strcmp( _engines[e].name, name ) != 0)) ++e ;
+   return (enum Engine) e ;
+}
+
+const char *Engine_name(enum Engine engine)
+{
+   return _engines[engine].name ;
+}
+
+int Engine_available(enum Engine engine, long max_distance)
+{
+   int scoring = (_scoring.model == SCORING_DEFAULT) ; /* the costs of Globals.h, compiled in all the engines */
+   int linear = (_scoring.gap_open == 0) ;
+   switch (engine)
+   {  case ENGINE_DIFF :   return scoring && DIFF_ENCODING_LEGAL ;
+      case ENGINE_BITPAR : return (scoring && UNIT_COST) || (_scoring.model == SCORING_UNIT) ;
+      case ENGINE_BANDED : return linear && (max_distance >= 0) ;
+      case ENGINE_LS :     return linear ;
+      case ENGINE_GOTOH :  return 1 ;
+      case ENGINE_WFA :    return EditDistance_WFA_available() ;
+      case ENGINE_COUNT :  return 0 ;
+      default :            return scoring ;
+   }
+}
+
+/* diagonals on each side of the diagonal 0 reached by the wavefronts of the costs up to max_distance (-1: any), m >= n */
+static double Engine_Diagonals(size_t m, long max_distance)
+{
+   double d = (max_distance < 0) ? (double) m : (double) (max_distance / _scoring.indel) ;
+   return (d < (double) m) ? d : (double) m ;
+}
+
+/* wavefronts kept by EditDistance_WFA: those of the costs s-max(x, indel) .. s, x being its substitution cost */
+static double Engine_Wavefronts(void)
+{
+   long x = EditDistance_WFA_mismatch() ;
+   return (double) ((x > _scoring.indel) ? x : _scoring.indel) + 1 ;
+}
+
+/* Engine_footprint : cf .h for specification.
+ * With m >= n (the engines swap the sequences): the chars rebuilt for the engine on chars, the bases unpacked
+ * (1 byte per base), and the table, rows or boundaries of each engine.
+ */
+size_t Engine_footprint(enum Engine engine, size_t m, size_t n, long max_distance)
+{
+   if (m < n) { size_t aux = m ; m = n ; n = aux ; }
+   double width = Cell_width( m, n ) ; /* bytes per cell, cf CellWidth.h (the recursive engine is on long) */
+   double cells = (double) (m + 1) * (double) (n + 1) ;
+   double table = cells * width + (double) (m + 1) * sizeof(void *) ;
+   size_t tile = _tuning.par_tile ;
+   double bytes ;
+   switch (engine)
+   {  case ENGINE_NW_REC : bytes = cells * sizeof(long) + (double) (m + 1) * sizeof(void *) + 2.0 * (m + n) + 64.0 * (m + n) ; break ; /* and the frames of the recursion */
+      case ENGINE_NW_IT :
+      case ENGINE_CO :
+      case ENGINE_CA :
+      case ENGINE_CO_PAR : bytes = table + 1.0 * (m + n) ; break ;
+      case ENGINE_TILED :  bytes = 1.0 * (m + n) + width * (m + n + 2.0 * tile) + (double) (m / tile + 1) * (double) (n / tile + 1) ; break ;
+      case ENGINE_LS :     bytes = (n + 1) + width * (n + 1) ; break ;
+      case ENGINE_DIFF :   bytes = 2.0 * (m + 1) + 3.0 * (n + 1) ; break ;
+      case ENGINE_BITPAR : bytes = 8.0 * (UNKOWN_BASE + 3) * (n / 64 + 1) ; break ;
+      case ENGINE_BANDED : bytes = (m + 1) + (n + 1) + 8.0 * ((max_distance < 0 ? 0 : max_distance) / _scoring.indel + 3) ; break ;
+      case ENGINE_STRIPED : bytes = 1.0 * (n + 1) + width * (n + n / tile + 1 + 2.0 * (tile + 1)) ; break ; /* in all the workers */
+      case ENGINE_WFA :    bytes = 2.0 * sizeof(long) * Engine_Wavefronts() * (2.0 * Engine_Diagonals( m, max_distance ) + 1) ; break ; /* 2 slots once grown */
+      case ENGINE_GOTOH :  bytes = (n + 1) + EditDistance_Gotoh_width( m, n ) * ((UNKOWN_BASE - ADENINE + 1.0) * n + 2.0 * (m + 1) + 3.0 * (tile + 1)) ; break ;
+      default :            bytes = 0 ;
+   }
+   return (bytes >= (double) SIZE_MAX) ? SIZE_MAX : (size_t) bytes ;
+}
+
+/* cells of the table computed by engine; for the banded engine, those of the widest band (max_distance);
+ * for the wavefronts, those of the costs up to max_distance (at most the table)
+ */
+static double Engine_Cells(enum Engine engine, size_t m, size_t n, long max_distance)
+{
+   if ((engine == ENGINE_WFA) && (max_distance >= 0))
+   {  double cells = (double) max_distance * (double) max_distance / (double) _scoring.indel + max_distance + 1 ;
+      return (cells < (double) m * (double) n) ? cells : (double) m * (double) n ;
+   }
+   if (engine != ENGINE_BANDED) return (double) m * (double) n ;
+   double band = 2.0 * (max_distance / _scoring.indel) + 1 ;
+   double width = (double) ((m < n) ? m : n) + 1 ;
+   return (double) ((m > n) ? m : n) * ((band < width) ? band : width) ;
+}
+
+/* estimated time (ns) of engine: the cells computed at its rate, plus its overhead.
+ * The cells of the banded engine are those of the widest band, twice (the bound is doubled up to max_distance).
+ */
+static double Engine_Time(enum Engine engine, size_t m, size_t n, long max_distance, int nthreads)
+{
+   double cells = (double) (m + 1) * (double) (n + 1) ;
+   double threads = ((engine == ENGINE_TILED) || (engine == ENGINE_CO_PAR) || (engine == ENGINE_STRIPED)) ? nthreads : 1 ;
+   if (engine == ENGINE_BANDED) cells = 2.0 * Engine_Cells( engine, m, n, max_distance ) ;
+   return cells / (_engines[engine].rate * threads) + _engines[engine].overhead * threads ;
+}
+
+/* Engine_wavefront_bound : cf .h for specification.
+ * The wavefronts of the costs up to s have about s^2/indel cells: s = sqrt(indel * rate * time / ENGINE_WFA_TRY).
+ */
+long Engine_wavefront_bound(enum Engine engine, size_t m, size_t n, long max_distance, int nthreads)
+{
+   double time = Engine_Time( engine, m, n, max_distance, nthreads ) / ENGINE_WFA_TRY ;
+   return (long) sqrt( (double) _scoring.indel * _engines[ENGINE_WFA].rate * time ) ;
+}
+
+enum Engine Engine_select(size_t m, size_t n, long max_distance, int nthreads, size_t mem_limit)
+{
+   enum Engine best = ENGINE_AUTO ;
+   double best_time = 0 ;
+   for (int e = ENGINE_AUTO + 1; e < ENGINE_COUNT; ++e)
+   {  if (! Engine_available( e, max_distance ) || (e == ENGINE_STRIPED) || (e == ENGINE_WFA)) continue ; /* striped: processes, on demand; wfa: tried first */
+      if (((e == ENGINE_TILED) || (e == ENGINE_CO_PAR)) && (nthreads < 2)) continue ;
+      if ((mem_limit != 0) && (Engine_footprint( e, m, n, max_distance ) > mem_limit)) continue ;
+      double t = Engine_Time( e, m, n, max_distance, nthreads ) ;
+      if ((best == ENGINE_AUTO) || (t < best_time)) { best = e ; best_time = t ; }
+   }
+   return best ;
+}
+
+/* the chars "ACGTUN" of the bases of ps, for the engine on chars (allocated by malloc) */
+static char *Engine_Chars(const struct PackedSequence *ps)
+{
+   static const char chars[UNKOWN_BASE + 1] = { '?', 'A', 'C', 'G', 'T', 'U', 'N' } ;
+   char *S = (char *) malloc( ps->length + 1 ) ;
+   if (S == NULL) { perror("Engine_distance: malloc of chars" ); exit(EXIT_FAILURE); }
+   for (size_t k = 0; k < ps->length; ++k) S[k] = chars[Packed_base( ps, k )] ;
+   S[ps->length] = '\0' ;
+   return S ;
+}
+
+/* the distance by engine, as Engine_distance; if attempt, a distance above max_distance gives up the run: only the
+ * cells of engine up to max_distance are counted and the progress is stopped without its last report
+ */
+static long Engine_Run(enum Engine engine, const struct PackedSequence *X, const struct PackedSequence *Y, long max_distance, int nthreads,
+                       struct Workspace *ws, int attempt)
+{
+   long res ;
+   Progress_start( Engine_name( engine ), Engine_Cells( engine, X->length, Y->length, max_distance ) ) ;
+   PerfCounters_phase( PERF_ALLOC ) ;
+   switch (engine)
+   {  case ENGINE_NW_REC :
+      {  char *A = Engine_Chars( X ) ;
+         char *B = Engine_Chars( Y ) ;
+         res = EditDistance_NW_Rec_Arena(A, X->length, B, Y->length, &ws->arena) ;
+         Progress_cells( (uint64_t) X->length * Y->length ) ; /* the recursion does not count its cells */
+         free( A ) ;
+         free( B ) ;
+         break ;
+      }
+      case ENGINE_NW_IT :  res = EditDistance_NW_It_Packed(X, Y, ws) ; break ;
+      case ENGINE_CO :     res = EditDistance_CO_Packed(X, Y, ws) ; break ;
+      case ENGINE_CA :     res = EditDistance_CA_Packed(X, Y, ws) ; break ;
+      case ENGINE_CO_PAR : res = EditDistance_CO_Par_Packed(X, Y, nthreads, ws) ; break ;
+      case ENGINE_TILED :  res = EditDistance_CA_Par_Packed(X, Y, nthreads, ws) ; break ;
+#if DIFF_ENCODING_LEGAL
+      case ENGINE_DIFF :   res = EditDistance_Diff_Packed(X, Y, ws) ; break ;
+#endif
+      case ENGINE_BITPAR : res = EditDistance_BitPar_Packed(X, Y, ws) ; break ;
+      case ENGINE_BANDED : res = EditDistance_Banded_Packed(X, Y, max_distance, ws) ; break ;
+      case ENGINE_GOTOH :  res = EditDistance_Gotoh_Packed(X, Y, ws) ; break ;
+      case ENGINE_STRIPED : res = EditDistance_Striped_Packed(X, Y, nthreads, ws) ; break ;
+      case ENGINE_WFA :    res = EditDistance_WFA_Packed(X, Y, max_distance, ws) ; break ;
+      default :            res = EditDistance_LS_Packed(X, Y, ws) ;
+   }
+   PerfCounters_phase( PERF_OUTSIDE ) ;
+   int above = (res == DISTANCE_ABOVE_MAX) || ((max_distance >= 0) && (res > max_distance)) ;
+   if (_perf_enabled)
+      PerfCounters_cells( (attempt && above) ? Engine_Cells( engine, X->length, Y->length, max_distance ) : (double) X->length * (double) Y->length ) ;
+   if (_progress_enabled)
+   {  if (attempt && above) Progress_stop() ;
+      else Progress_finish() ;
+   }
+   return above ? DISTANCE_ABOVE_MAX : res ;
+}
+
+long Engine_distance(enum Engine engine, const struct PackedSequence *X, const struct PackedSequence *Y, long max_distance, int nthreads, struct Workspace *ws)
+{
+   return Engine_Run( engine, X, Y, max_distance, nthreads, ws, 0 ) ;
+}
+
+long Engine_wavefront_try(const struct PackedSequence *X, const struct PackedSequence *Y, long bound, struct Workspace *ws)
+{
+   return Engine_Run( ENGINE_WFA, X, Y, bound, 1, ws, 1 ) ;
+}
+
+size_t Engine_memory(void)
+{
+   long pages = sysconf( _SC_PHYS_PAGES ) ;
+   long page_size = sysconf( _SC_PAGESIZE ) ;
+   return ((pages <= 0) || (page_size <= 0)) ? 0 : (size_t) pages * (size_t) page_size ;
+}
@@ -0,0 +1,114 @@
+/**
+ * \file Engine.h
+ * \brief the engines built in the binary, their memory footprint and speed, and the choice of an engine under a memory budget
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * All the engines that compute the distance are built in the binary. For a pair of sequences of m and n bases
+ * (known exactly once the sequences are packed, whatever the density of chars that are not bases), Engine_select
+ * estimates the footprint and the time of each engine and chooses the fastest one whose footprint fits in the budget:
+ * the full table engines (O(mn) memory) only for small pairs, the linear space and tiled engines for the others.
+ * The speeds are the throughputs measured on one core (cells per ns), cf Engine.c.
+ */
+
+#ifndef __ENGINE_h__
+#define __ENGINE_h__
+
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/**
+ * \enum Engine
+ * \brief the engines that compute the distance (the names are those of --engine)
+ */
+enum Engine
+{  ENGINE_AUTO = 0, /*!< "auto": the fastest engine that fits in the memory budget (cf Engine_select) */
+   ENGINE_NW_REC,   /*!< "rec": EditDistance_NW_Rec, recursive with memoization, full table */
+   ENGINE_NW_IT,    /*!< "it": EditDistance_NW_It, iterative, full table */
+   ENGINE_CO,       /*!< "co": EditDistance_CO, cache oblivious, full table */
+   ENGINE_CA,       /*!< "ca": EditDistance_CA, cache aware (tiles), full table */
+   ENGINE_CO_PAR,   /*!< "co-par": EditDistance_CO_Par, parallel cache oblivious (quadrants), full table */
+   ENGINE_TILED,    /*!< "tiled": EditDistance_CA_Par, parallel tiled wavefront, boundaries of the tiles only */
+   ENGINE_LS,       /*!< "ls": EditDistance_LS, one row */
+   ENGINE_DIFF,     /*!< "diff": EditDistance_Diff, one row of differences on 8 bits (if DIFF_ENCODING_LEGAL) */
+   ENGINE_BITPAR,   /*!< "bitpar": EditDistance_BitPar, bit-parallel (if all the costs are 1) */
+   ENGINE_BANDED,   /*!< "banded": EditDistance_Banded, band around the diagonal (needs a bound, --max-distance) */
+   ENGINE_GOTOH,    /*!< "gotoh": EditDistance_Gotoh, one row per table of Gotoh by strips (the only one with affine gaps) */
+   ENGINE_STRIPED,  /*!< "striped": EditDistance_Striped, pipeline of processes by stripes of columns (never chosen by auto) */
+   ENGINE_WFA,      /*!< "wfa": EditDistance_WFA, wavefronts of the costs, for similar sequences (tried first by auto, cf Engine_wavefront_bound) */
+   ENGINE_COUNT     /*!< number of values of enum Engine */
+} ;
+
+/**
+ * \fn enum Engine Engine_parse(const char *name)
+ * \brief the engine of name name ("auto", "rec", "it", "co", "ca", "co-par", "tiled", "ls", "diff", "bitpar", "banded", "gotoh", "striped" or "wfa"),
+ * or ENGINE_COUNT if there is none
+ */
+enum Engine Engine_parse(const char *name) ;
+
+/**
+ * \fn const char *Engine_name(enum Engine engine)
+ * \brief the name of engine, as given to Engine_parse
+ */
+const char *Engine_name(enum Engine engine) ;
+
+/**
+ * \fn int Engine_available(enum Engine engine, long max_distance)
+ * \brief 1 if engine may compute a distance with the costs of _scoring and the bound max_distance (-1 if none), else 0
+ * (with other costs than the ones of Globals.h, only ENGINE_LS, ENGINE_BANDED, ENGINE_GOTOH and, for unit costs,
+ * ENGINE_BITPAR and ENGINE_WFA; with affine gaps, only ENGINE_GOTOH)
+ */
+int Engine_available(enum Engine engine, long max_distance) ;
+
+/**
+ * \fn size_t Engine_footprint(enum Engine engine, size_t m, size_t n, long max_distance)
+ * \brief estimates the memory (in bytes) allocated by engine for sequences of m and n bases,
+ * besides the packed sequences and the stacks of the threads
+ */
+size_t Engine_footprint(enum Engine engine, size_t m, size_t n, long max_distance) ;
+
+/**
+ * \fn enum Engine Engine_select(size_t m, size_t n, long max_distance, int nthreads, size_t mem_limit)
+ * \brief the engine of least estimated time for sequences of m and n bases, among those available (cf Engine_available)
+ * whose footprint is at most mem_limit bytes (0: no limit); ENGINE_AUTO if none fits
+ * \param nthreads : number of threads for the pair; only ENGINE_CO_PAR and ENGINE_TILED use more than one
+ */
+enum Engine Engine_select(size_t m, size_t n, long max_distance, int nthreads, size_t mem_limit) ;
+
+/**
+ * \fn long Engine_wavefront_bound(enum Engine engine, size_t m, size_t n, long max_distance, int nthreads)
+ * \brief the largest distance up to which ENGINE_WFA is tried before engine, for sequences of m and n bases:
+ * its cost, O(s^2/indel) for a distance s, is then at most a fraction of the estimated time of engine,
+ * so that the auto mode runs ENGINE_WFA bounded by it first, and engine only if the distance is above
+ */
+long Engine_wavefront_bound(enum Engine engine, size_t m, size_t n, long max_distance, int nthreads) ;
+
+/**
+ * \fn long Engine_distance(enum Engine engine, const struct PackedSequence *X, const struct PackedSequence *Y, long max_distance, int nthreads, struct Workspace *ws)
+ * \brief computes the distance between X and Y with engine (not ENGINE_AUTO)
+ * \param max_distance : if >= 0, DISTANCE_ABOVE_MAX (cf Banded.h) is returned when the distance exceeds it
+ * \param nthreads : number of threads of ENGINE_CO_PAR and ENGINE_TILED, of processes of ENGINE_STRIPED
+ * \param ws : scratch buffers and arena of the calling thread
+ *
+ * The recursive engine on chars (rec) is given the chars of the bases ("ACGTUN"), rebuilt from the packed sequences.
+ * The tables of the full table engines and the boundaries of the tiled one are in the arena of ws (cf Arena.h).
+ * The call is a phase of the hardware counters, if they are open (cf PerfCounters.h), of X->length * Y->length cells,
+ * and, if the progress is open, its cells are reported by the thread of Progress_start (cf Progress.h).
+ */
+long Engine_distance(enum Engine engine, const struct PackedSequence *X, const struct PackedSequence *Y, long max_distance, int nthreads, struct Workspace *ws) ;
+
+/**
+ * \fn long Engine_wavefront_try(const struct PackedSequence *X, const struct PackedSequence *Y, long bound, struct Workspace *ws)
+ * \brief the attempt of ENGINE_WFA bounded by bound (cf Engine_wavefront_bound) of the auto mode: as
+ * Engine_distance( ENGINE_WFA, X, Y, bound, 1, ws ), but if the distance is above bound (DISTANCE_ABOVE_MAX), only the
+ * cells of the wavefronts are counted and the progress has no last report, the engine run next computes the distance
+ */
+long Engine_wavefront_try(const struct PackedSequence *X, const struct PackedSequence *Y, long bound, struct Workspace *ws) ;
+
+/**
+ * \fn size_t Engine_memory(void)
+ * \brief the physical memory of the machine, in bytes: the default memory budget
+ */
+size_t Engine_memory(void) ;
+
+#endif /* __ENGINE_h__ */
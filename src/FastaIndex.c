@@ -0,0 +1,235 @@
+/**
+ * \file FastaIndex.c
+ * \brief index of the records of a FASTA file (.fai)
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see FastaIndex.h
+ */
+
+#include "FastaIndex.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <err.h> 
+#include <errno.h> 
+#include <string.h> 
+#include <ctype.h> /* for isspace */
+#include <sys/stat.h> /* for the date of the index */
+
+static void FastaIndex_Sort(struct FastaIndex *index) ;
+
+/* adds an entry to index, whose entries array has *capacity elements */
+static struct FastaIndexEntry *FastaIndex_Add(struct FastaIndex *index, size_t *capacity)
+{
+   if (index->count == *capacity)
+   {  *capacity = (*capacity == 0) ? 16 : 2 * *capacity ;
+      index->entries = (struct FastaIndexEntry *) realloc( index->entries, *capacity * sizeof(struct FastaIndexEntry) ) ;
+      if (index->entries == NULL) { perror("FastaIndex: malloc of entries" ); exit(EXIT_FAILURE); }
+   }
+   return &index->entries[index->count++] ;
+}
+
+static struct FastaIndex *FastaIndex_New(void)
+{
+   struct FastaIndex *index = (struct FastaIndex *) calloc( 1, sizeof(struct FastaIndex) ) ;
+   if (index == NULL) { perror("FastaIndex: malloc" ); exit(EXIT_FAILURE); }
+   return index ;
+}
+
+/* FastaIndex_build : cf .h for specification.
+ * The lines of a record are read one by one; after a line shorter than the first one 
+ * (or an empty line), the record must end.
+ */
+struct FastaIndex *FastaIndex_build(struct SequenceFile *file)
+{
+   struct FastaIndex *index = FastaIndex_New() ;
+   size_t capacity = 0 ;
+   char *end = file->data + file->length ;
+   char *c = file->data ;
+   while (c < end)
+   {  if ((*c == '\n') || (*c == '\r')) { ++c ; continue ; } /* empty line between records */
+      if (*c != '>') 
+         errx(1, "%s: not a FASTA file: header line starting by '>' expected at byte %ld", file->name, (long) (c - file->data)) ;
+      struct FastaIndexEntry *e = FastaIndex_Add( index, &capacity ) ;
+      char *name = c + 1 ;
+      while ((c < end) && !isspace( (unsigned char) *c )) ++c ;
+      e->name = strndup( name, c - name ) ;
+      if (e->name == NULL) { perror("FastaIndex: strdup" ); exit(EXIT_FAILURE); }
+      c = (char *) memchr( c, '\n', end - c ) ;
+      c = (c == NULL) ? end : c + 1 ;
+      e->offset = (long) (c - file->data) ;
+      e->length = e->line_bases = e->line_bytes = 0 ;
+      int last_line = 0 ; /* a line shorter than the first one was read */
+      while ((c < end) && (*c != '>'))
+      {  char *eol = (char *) memchr( c, '\n', end - c ) ;
+         long bytes = (eol == NULL) ? (long) (end - c) : (long) (eol - c) + 1 ;
+         long bases = (eol == NULL) ? bytes : bytes - 1 ;
+         if ((bases > 0) && (c[bases-1] == '\r')) --bases ;
+         if ((bases == 0) && (e->line_bytes == 0)) /* empty line before the sequence */
+            e->offset += bytes ;
+         else if (bases > 0)
+         {  if (e->line_bytes == 0) /* first line */
+            {  e->line_bases = bases ;
+               e->line_bytes = bytes ;
+            }
+            else if (last_line || (bases > e->line_bases))
+               errx(1, "%s: record %s: lines of different lengths, the file cannot be indexed", file->name, e->name) ;
+            e->length += bases ;
+         }
+         if ((e->line_bytes != 0) && ((bases != e->line_bases) || (bytes != e->line_bytes))) last_line = 1 ;
+         c += bytes ;
+      }
+   }
+   FastaIndex_Sort( index ) ;
+   return index ;
+}
+
+int FastaIndex_save(const struct FastaIndex *index, const char *name)
+{
+   FILE *f = fopen( name, "w" ) ;
+   if (f == NULL) return -1 ;
+   for (size_t r = 0; r < index->count; ++r)
+   {  const struct FastaIndexEntry *e = &index->entries[r] ;
+      fprintf( f, "%s\t%ld\t%ld\t%ld\t%ld\n", e->name, e->length, e->offset, e->line_bases, e->line_bytes ) ;
+   }
+   if (ferror( f )) { fclose( f ) ; return -1 ; }
+   return fclose( f ) ;
+}
+
+/* reads the index of file in the sidecar file name; returns NULL if it is invalid or does not match file */
+static struct FastaIndex *FastaIndex_Load(struct SequenceFile *file, const char *name)
+{
+   FILE *f = fopen( name, "r" ) ;
+   if (f == NULL) return NULL ;
+   struct FastaIndex *index = FastaIndex_New() ;
+   size_t capacity = 0 ;
+   char *line = NULL ;
+   size_t line_size = 0 ;
+   int valid = 1 ;
+   while (valid && (getline( &line, &line_size, f ) != -1))
+   {  char *tab = strchr( line, '\t' ) ;
+      struct FastaIndexEntry e ;
+      valid = (tab != NULL) && 
+              (sscanf( tab + 1, "%ld\t%ld\t%ld\t%ld", &e.length, &e.offset, &e.line_bases, &e.line_bytes ) == 4) &&
+              (e.offset >= 0) && (e.offset <= file->length) && (e.length >= 0) && ((e.length == 0) || (e.line_bases > 0)) && (e.line_bases <= e.line_bytes) &&
+              ((e.offset == 0) || (file->data[e.offset-1] == '\n')) ; /* a record begins on a new line */
+      if (valid)
+      {  e.name = strndup( line, tab - line ) ;
+         if (e.name == NULL) { perror("FastaIndex: strdup" ); exit(EXIT_FAILURE); }
+         *FastaIndex_Add( index, &capacity ) = e ;
+      }
+   }
+   free( line ) ;
+   fclose( f ) ;
+   if (! valid) 
+   {  FastaIndex_free( index ) ;
+      return NULL ;
+   }
+   FastaIndex_Sort( index ) ;
+   return index ;
+}
+
+struct FastaIndex *FastaIndex_get(struct SequenceFile *file)
+{
+   if (file->index != NULL) return file->index ;
+   size_t size = strlen( file->name ) + 5 ;
+   char *name = (char *) malloc( size ) ;
+   if (name == NULL) { perror("FastaIndex: malloc" ); exit(EXIT_FAILURE); }
+   snprintf( name, size, "%s.fai", file->name ) ;
+   struct stat s ;
+   if ((stat( name, &s ) == 0) && (s.st_mtime >= file->mtime)) file->index = FastaIndex_Load( file, name ) ;
+   if (file->index == NULL) 
+   {  file->index = FastaIndex_build( file ) ;
+      if (FastaIndex_save( file->index, name ) != 0) 
+         fprintf( stderr, "Warning: the index %s cannot be written (%s); it is built again at each execution.\n", 
+                          name, strerror( errno ) ) ;
+   }
+   free( name ) ;
+   return file->index ;
+}
+
+static int FastaIndex_Compare(const void *a, const void *b)
+{
+   return strcmp( (*(struct FastaIndexEntry * const *) a)->name, (*(struct FastaIndexEntry * const *) b)->name ) ;
+}
+
+/* sorts the entries by name in index->by_name */
+static void FastaIndex_Sort(struct FastaIndex *index) 
+{
+   index->by_name = (struct FastaIndexEntry **) malloc( (index->count + 1) * sizeof(struct FastaIndexEntry *) ) ;
+   if (index->by_name == NULL) { perror("FastaIndex: malloc" ); exit(EXIT_FAILURE); }
+   for (size_t r = 0; r < index->count; ++r) index->by_name[r] = &index->entries[r] ;
+   qsort( index->by_name, index->count, sizeof(struct FastaIndexEntry *), FastaIndex_Compare ) ;
+}
+
+const struct FastaIndexEntry *FastaIndex_find(const struct FastaIndex *index, const char *name)
+{
+   struct FastaIndexEntry key = { (char *) name, 0, 0, 0, 0 } ;
+   struct FastaIndexEntry *pkey = &key ;
+   struct FastaIndexEntry **e = (struct FastaIndexEntry **) 
+      bsearch( &pkey, index->by_name, index->count, sizeof(struct FastaIndexEntry *), FastaIndex_Compare ) ;
+   return (e == NULL) ? NULL : *e ;
+}
+
+int FastaIndex_is_region(const char *arg)
+{
+   return strchr( arg, ':' ) != NULL ;
+}
+
+/* position in the file of the base k (numbered from 0) of the record e */
+static inline long FastaIndex_Position(const struct FastaIndexEntry *e, long k)
+{
+   return e->offset + (k / e->line_bases) * e->line_bytes + k % e->line_bases ;
+}
+
+char *FastaIndex_region(const char *region, struct SequenceFile **file, long *length, int verbose)
+{
+   char *copy = strdup( region ) ;
+   if (copy == NULL) { perror("FastaIndex: strdup" ); exit(EXIT_FAILURE); }
+   char *colon = strrchr( copy, ':' ) ;
+   if (colon == NULL) errx(1, "invalid region %s: file:record[:start-end] expected", region) ;
+   long start = 1, last = -1 ; /* whole record if last < 0 */
+   {  int n = -1 ;
+      if ((sscanf( colon + 1, "%ld-%ld%n", &start, &last, &n ) == 2) && (n == (int) strlen( colon + 1 )))
+      {  *colon = '\0' ;
+         colon = strrchr( copy, ':' ) ;
+         if ((colon == NULL) || (start < 1) || (last < start)) 
+            errx(1, "invalid region %s: file:record[:start-end] expected, with 1 <= start <= end", region) ;
+      }
+      else 
+      {  start = 1 ;
+         last = -1 ;
+      }
+   }
+   *colon = '\0' ;
+   const char *record = colon + 1 ;
+
+   *file = SequenceFile_open( copy ) ;
+   const struct FastaIndexEntry *e = FastaIndex_find( FastaIndex_get( *file ), record ) ;
+   if (e == NULL) errx(1, "invalid region %s: no record %s in %s", region, record, copy) ;
+   if (last < 0) last = e->length ;
+   if (last > e->length) errx(1, "invalid region %s: the record %s has %ld bases", region, record, e->length) ;
+
+   char *seq = (*file)->data + e->offset ;
+   *length = 0 ;
+   if (last >= start) 
+   {  long first = FastaIndex_Position( e, start - 1 ) ;
+      long final = FastaIndex_Position( e, last - 1 ) ;
+      if (final >= (*file)->length) errx(1, "the index of %s does not match the file: remove %s.fai", copy, copy) ;
+      seq = (*file)->data + first ;
+      *length = final - first + 1 ;
+   }
+   if (verbose) SequenceFile_print( seq, *length ) ;
+   free( copy ) ;
+   return seq ;
+}
+
+void FastaIndex_free(struct FastaIndex *index)
+{
+   if (index == NULL) return ;
+   for (size_t r = 0; r < index->count; ++r) free( index->entries[r].name ) ;
+   free( index->entries ) ;
+   free( index->by_name ) ;
+   free( index ) ;
+}
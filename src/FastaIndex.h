@@ -0,0 +1,98 @@
+/**
+ * \file FastaIndex.h
+ * \brief index of the records of a FASTA file (as the .fai files of samtools), to address 
+ * a sequence by record name and coordinates of bases instead of offsets in bytes 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * The index of file F is stored in the sidecar file F.fai, one line per record with 5 fields 
+ * separated by tabulations:
+ *    name  length  offset  line_bases  line_bytes 
+ * where length is the number of bases of the record, offset the position in F of its first base, 
+ * line_bases the number of bases per line and line_bytes the number of bytes per line (including '\n').
+ * All the lines of a record but the last one must have the same length, so that the position 
+ * of the k-th base is computed without reading the file:
+ *    offset + (k / line_bases) * line_bytes + k % line_bases
+ */
+
+#ifndef __FASTA_INDEX_h__
+#define __FASTA_INDEX_h__
+
+#include "SequenceFile.h" 
+
+/**
+ * \struct FastaIndexEntry
+ * \brief the index of a record 
+ */
+struct FastaIndexEntry 
+{  char *name ;        /*!< name of the record (first word of its header line) */
+   long length ;       /*!< number of bases */
+   long offset ;       /*!< position in the file of the first base */
+   long line_bases ;   /*!< number of bases per line */
+   long line_bytes ;   /*!< number of bytes per line */
+} ;
+
+/**
+ * \struct FastaIndex
+ * \brief the index of the records of a file 
+ */
+struct FastaIndex 
+{  struct FastaIndexEntry *entries ; /*!< in the order of the file */
+   size_t count ;                    /*!< number of records */
+   struct FastaIndexEntry **by_name ;  /*!< the entries sorted by name, for the search */
+} ;
+
+/**
+ * \fn struct FastaIndex *FastaIndex_get(struct SequenceFile *file)
+ * \brief returns the index of file: loaded from the sidecar file <name>.fai if it is not older than file, 
+ * else built by one pass on file and saved in <name>.fai (only a warning if it cannot be written).
+ * The index is kept in file->index for the next calls. Exits if the file is not a valid FASTA file.
+ */
+struct FastaIndex *FastaIndex_get(struct SequenceFile *file) ;
+
+/**
+ * \fn struct FastaIndex *FastaIndex_build(struct SequenceFile *file)
+ * \brief builds the index of file by one pass on its content 
+ */
+struct FastaIndex *FastaIndex_build(struct SequenceFile *file) ;
+
+/**
+ * \fn int FastaIndex_save(const struct FastaIndex *index, const char *name)
+ * \brief writes index in the file name (.fai format); returns 0 on success, -1 on error (with errno set)
+ */
+int FastaIndex_save(const struct FastaIndex *index, const char *name) ;
+
+/**
+ * \fn const struct FastaIndexEntry *FastaIndex_find(const struct FastaIndex *index, const char *name)
+ * \brief returns the entry of the record name, NULL if there is none
+ */
+const struct FastaIndexEntry *FastaIndex_find(const struct FastaIndex *index, const char *name) ;
+
+/**
+ * \fn char *FastaIndex_region(const char *region, struct SequenceFile **file, long *length, int verbose)
+ * \brief returns the sequence given by region = "file:record[:start-end]"
+ * \param region : pathname of a FASTA file, name of a record and optionally the positions of its first and last 
+ * bases, numbered from 1 (as samtools: "wuhan.fasta:NC_045512.2:101-200" are the bases 101 to 200 included);
+ * the whole record if there are no positions
+ * \param file : receives the file of the sequence, mapped in virtual memory (cf SequenceFile_open)
+ * \param length : receives the number of chars of the sequence (including the '\n' between its lines)
+ * \param verbose : if not 0, prints the sequence on stderr (cf SequenceFile_print)
+ * \return the address in the mapping of the first base of the sequence 
+ *
+ * Exits with an error message if the region is not valid.
+ */
+char *FastaIndex_region(const char *region, struct SequenceFile **file, long *length, int verbose) ;
+
+/**
+ * \fn int FastaIndex_is_region(const char *arg)
+ * \brief 1 iff arg has the syntax of a region (it contains a ':'), 0 else
+ */
+int FastaIndex_is_region(const char *arg) ;
+
+/**
+ * \fn void FastaIndex_free(struct FastaIndex *index)
+ * \brief frees index (nothing if NULL)
+ */
+void FastaIndex_free(struct FastaIndex *index) ;
+
+#endif /* __FASTA_INDEX_h__ */
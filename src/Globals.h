@@ -4,18 +4,42 @@
  * Costs for operations on canonical bases
  * Three  operations: insertion and sustitution of one base by an another 
  * Note= substitution of an unknown base N by another one (known or unknown) as the same cost than substitution between 2 different known bases
+ * The costs may be redefined at compilation (eg -DINSERTION_COST=1)
+ * These are the default costs, compiled in all the engines; other ones may be chosen at run time (cf Scoring.h)
  */
 /** \def SUBSTITUTION_COST
  *  \brief Cost of substitution of one canonical base by another
  */
+#ifndef SUBSTITUTION_COST
 #define SUBSTITUTION_COST	1
+#endif
 
 /** \def SUBSTITUTION_UNKNOWN_COST
  *  \brief Cost of substitution of an unknown base (N) by another one (canonical or unknown)
  */
+#ifndef SUBSTITUTION_UNKNOWN_COST
 #define SUBSTITUTION_UNKNOWN_COST	1  /* Cost for sustitition of an Unknown bas N by another on -known or unkown- */ 
+#endif
 
 /** \def INSERTION_COST
  *  \brief Cost of insertion of a canonical base 
  */
+#ifndef INSERTION_COST
 #define INSERTION_COST		2
+#endif
+
+/*
+ * Kernels allowed by the costs (decided at compilation)
+ */
+/** \def DIFF_ENCODING_LEGAL
+ *  \brief 1 iff the differences between two adjacent cells of the table fit in an int8_t
+ *
+ * The horizontal and vertical differences lie in [-INSERTION_COST, INSERTION_COST]; during their
+ * computation, intermediate values reach 3*INSERTION_COST and the substitution costs.
+ */
+#define DIFF_ENCODING_LEGAL	( (3*INSERTION_COST <= 127) && (SUBSTITUTION_COST <= 127) && (SUBSTITUTION_UNKNOWN_COST <= 127) )
+
+/** \def UNIT_COST
+ *  \brief 1 iff all the operations cost 1 (Levenshtein distance): the bit-parallel kernel of Myers/Hyyro is allowed
+ */
+#define UNIT_COST	( (SUBSTITUTION_COST == 1) && (SUBSTITUTION_UNKNOWN_COST == 1) && (INSERTION_COST == 1) )
@@ -0,0 +1,299 @@
+/**
+ * \file Hirschberg.c
+ * \brief linear space algorithm that computes an optimal alignment between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Hirschberg.h
+ */
+
+#include "Hirschberg.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <string.h> 
+#include <pthread.h>
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+/** \def LEAF_CELLS
+ * \brief subproblems with at most LEAF_CELLS cells are solved with the full table and a traceback
+ */
+#define LEAF_CELLS (1 << 16)
+
+/** \def SUBSTITUTION(a,b)
+ * \brief cost of the substitution of base a (of A) by base b (of B)
+ */
+#define SUBSTITUTION(a,b) ( ((a) == UNKOWN_BASE) ? SUBSTITUTION_UNKNOWN_COST : ( ((a) == (b)) ? 0 : SUBSTITUTION_COST ) )
+
+/** \struct Hirschberg_Context
+ * \brief data shared by all the subproblems
+ *
+ * The operation from cell (i,j) (i bases of A and j bases of B aligned) is stored in ops[i+j]; 
+ * a match or a substitution moves to (i+1,j+1) and leaves ops[i+j+1] to 0 (ops is allocated by calloc 
+ * and this slot is never written: it may be the first slot of the next subproblem). So two independent 
+ * subproblems write in disjoint parts of ops.
+ */
+struct Hirschberg_Context
+{
+    unsigned char *A ; /*!< bases of A */
+    unsigned char *B ; /*!< bases of B */
+    char *ops ;        /*!< ops[0 .. m+n-1]: the operations '=', 'X', 'I', 'D' or 0 */
+} ;
+
+/*
+ * Last row of the table of P[0..p-1] against the prefixes of Q[0..q-1]: row[j] = phi(p, j), 0 <= j <= q.
+ * If reverse, P and Q are read backwards from their end (ie P[-1], P[-2] ...), for the suffixes.
+ */
+static void Hirschberg_LastRow(const unsigned char *P, size_t p, const unsigned char *Q, size_t q, int reverse, long *row)
+{
+   long step = reverse ? -1 : 1 ;
+   if (reverse) { P-- ; Q-- ; }
+   for (size_t j = 0; j <= q; ++j) row[j] = INSERTION_COST * (long) j ;
+   for (size_t i = 0; i < p; ++i)
+   {  enum Base a = P[step * (long) i] ;
+      long diag = row[0] ;
+      row[0] += INSERTION_COST ;
+      for (size_t j = 1; j <= q; ++j)
+      {  long up = row[j] ;
+         long min = SUBSTITUTION(a, Q[step * (long) (j-1)]) + diag ;
+         { long cas2 = INSERTION_COST + up ;      
+           if (cas2 < min) min = cas2 ;
+         }
+         { long cas3 = INSERTION_COST + row[j-1] ;      
+           if (cas3 < min) min = cas3 ; 
+         }
+         row[j] = min ;
+         diag = up ;
+      }
+   }
+}
+
+/*
+ * Small subproblem A[a0..a1-1] x B[b0..b1-1]: full table then traceback from the bottom-right corner.
+ */
+static void Hirschberg_Leaf(struct Hirschberg_Context *c, size_t a0, size_t a1, size_t b0, size_t b1)
+{
+   size_t p = a1 - a0, q = b1 - b0 ;
+   long *T = (long *) malloc( (p+1) * (q+1) * sizeof(long) ) ;
+   if (T == NULL) { perror("EditDistance_Align: malloc of leaf table" ); exit(EXIT_FAILURE); }
+   #define CELL(i,j) T[(i)*(q+1) + (j)]
+   for (size_t j = 0; j <= q; ++j) CELL(0,j) = INSERTION_COST * (long) j ;
+   for (size_t i = 1; i <= p; ++i)
+   {  CELL(i,0) = INSERTION_COST * (long) i ;
+      for (size_t j = 1; j <= q; ++j)
+      {  long min = SUBSTITUTION(c->A[a0+i-1], c->B[b0+j-1]) + CELL(i-1,j-1) ;
+         if (INSERTION_COST + CELL(i-1,j) < min) min = INSERTION_COST + CELL(i-1,j) ;
+         if (INSERTION_COST + CELL(i,j-1) < min) min = INSERTION_COST + CELL(i,j-1) ;
+         CELL(i,j) = min ;
+      }
+   }
+   size_t i = p, j = q ;
+   while ((i > 0) || (j > 0))
+   {  size_t slot ;
+      if ((i > 0) && (j > 0) 
+          && (CELL(i,j) == SUBSTITUTION(c->A[a0+i-1], c->B[b0+j-1]) + CELL(i-1,j-1)))
+      {  i-- ; j-- ;
+         slot = a0 + i + b0 + j ;
+         c->ops[slot] = (c->A[a0+i] == c->B[b0+j]) && (c->A[a0+i] != UNKOWN_BASE) ? '=' : 'X' ;
+      }
+      else if ((i > 0) && (CELL(i,j) == INSERTION_COST + CELL(i-1,j)))
+      {  i-- ;
+         c->ops[a0 + i + b0 + j] = 'I' ;
+      }
+      else
+      {  j-- ;
+         c->ops[a0 + i + b0 + j] = 'D' ;
+      }
+   }
+   #undef CELL
+   free( T ) ;
+}
+
+/*
+ * Subproblem with one base A[a0] against B[b0..b1-1]: either it is aligned with the base of B 
+ * that costs the less, or it is inserted (if this is cheaper than a substitution).
+ */
+static void Hirschberg_OneBase(struct Hirschberg_Context *c, size_t a0, size_t b0, size_t b1)
+{
+   enum Base a = c->A[a0] ;
+   size_t best = b1 ; /* b1: insertion of a */
+   long best_cost = 2 * INSERTION_COST ;
+   for (size_t k = b0; k < b1; ++k)
+   {  long cost = SUBSTITUTION(a, c->B[k]) ;
+      if (cost < best_cost) { best_cost = cost ; best = k ; }
+   }
+   size_t slot = a0 + b0 ;
+   for (size_t k = b0; k < b1; ++k)
+   {  if (k == best)
+      {  c->ops[slot++] = (a == c->B[k]) && (a != UNKOWN_BASE) ? '=' : 'X' ;
+         slot++ ; /* ops[slot] stays 0 */
+      }
+      else c->ops[slot++] = 'D' ;
+   }
+   if (best == b1) c->ops[slot] = 'I' ;
+}
+
+/** \struct Hirschberg_Task
+ * \brief arguments of a subproblem solved by another thread
+ */
+struct Hirschberg_Task
+{
+    struct Hirschberg_Context *c ;
+    size_t a0, a1, b0, b1 ;
+    int nthreads ;
+} ;
+
+static void Hirschberg_Rec(struct Hirschberg_Context *c, size_t a0, size_t a1, size_t b0, size_t b1, int nthreads) ;
+
+static void *Hirschberg_Thread(void *arg)
+{
+   struct Hirschberg_Task *t = (struct Hirschberg_Task *) arg ;
+   Hirschberg_Rec( t->c, t->a0, t->a1, t->b0, t->b1, t->nthreads ) ;
+   return NULL ;
+}
+
+/** \struct Hirschberg_Pass
+ * \brief arguments of the reverse pass run by another thread
+ */
+struct Hirschberg_Pass
+{
+    const unsigned char *P, *Q ;
+    size_t p, q ;
+    long *row ;
+} ;
+
+static void *Hirschberg_ReversePass(void *arg)
+{
+   struct Hirschberg_Pass *t = (struct Hirschberg_Pass *) arg ;
+   Hirschberg_LastRow( t->P, t->p, t->Q, t->q, 1, t->row ) ;
+   return NULL ;
+}
+
+/*
+ * Writes in c->ops an optimal alignment of A[a0..a1-1] with B[b0..b1-1], using nthreads threads.
+ */
+static void Hirschberg_Rec(struct Hirschberg_Context *c, size_t a0, size_t a1, size_t b0, size_t b1, int nthreads)
+{
+   size_t p = a1 - a0, q = b1 - b0 ;
+   if (p == 0) 
+   {  for (size_t k = b0; k < b1; ++k) c->ops[a0 + k] = 'D' ;
+      return ;
+   }
+   if (q == 0) 
+   {  for (size_t k = a0; k < a1; ++k) c->ops[k + b0] = 'I' ;
+      return ;
+   }
+   if ((p+1) * (q+1) <= LEAF_CELLS) { Hirschberg_Leaf( c, a0, a1, b0, b1 ) ; return ; }
+   if (p == 1) { Hirschberg_OneBase( c, a0, b0, b1 ) ; return ; }
+
+   size_t mid = a0 + p / 2 ;
+   long *forward = (long *) malloc( (q+1) * sizeof(long) ) ;
+   long *backward = (long *) malloc( (q+1) * sizeof(long) ) ;
+   if ((forward == NULL) || (backward == NULL)) { perror("EditDistance_Align: malloc of rows" ); exit(EXIT_FAILURE); }
+
+   {  /* forward and reverse half-passes, concurrently if there is more than one thread */
+      struct Hirschberg_Pass pass = { c->A + a1, c->B + b1, a1 - mid, q, backward } ;
+      pthread_t thread ;
+      int spawned = (nthreads > 1) && (pthread_create( &thread, NULL, Hirschberg_ReversePass, &pass ) == 0) ;
+      Hirschberg_LastRow( c->A + a0, mid - a0, c->B + b0, q, 0, forward ) ;
+      if (spawned) pthread_join( thread, NULL ) ;
+      else Hirschberg_ReversePass( &pass ) ;
+   }
+
+   size_t split = 0 ; /* forward[split] + backward[q-split] is minimal */
+   for (size_t j = 1; j <= q; ++j)
+      if (forward[j] + backward[q-j] < forward[split] + backward[q-split]) split = j ;
+   free( forward ) ;
+   free( backward ) ;
+
+   {  /* the two subproblems are independent */
+      struct Hirschberg_Task left = { c, a0, mid, b0, b0 + split, nthreads / 2 } ;
+      pthread_t thread ;
+      int spawned = (nthreads > 1) && (pthread_create( &thread, NULL, Hirschberg_Thread, &left ) == 0) ;
+      if (! spawned) Hirschberg_Thread( &left ) ;
+      Hirschberg_Rec( c, mid, a1, b0 + split, b1, nthreads - nthreads / 2 ) ;
+      if (spawned) pthread_join( thread, NULL ) ;
+   }
+}
+
+/*
+ * Offsets in the source of S of its first base and following its last base
+ */
+static void Hirschberg_Bounds(const struct PackedSequence *S, size_t *begin, size_t *end)
+{
+   *begin = (S->length == 0) ? S->source_length : Packed_offset( S, 0 ) ;
+   *end = (S->length == 0) ? 0 : Packed_offset( S, S->length - 1 ) + 1 ;
+}
+
+/* EditDistance_Align_Packed : cf .h for specification 
+ */
+long EditDistance_Align_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Alignment *alignment)
+{
+   struct Hirschberg_Context ctx ;
+   size_t m = A->length ;
+   size_t n = B->length ;
+   ctx.A = (unsigned char *) malloc( m + 1 ) ;
+   ctx.B = (unsigned char *) malloc( n + 1 ) ;
+   if ((ctx.A == NULL) || (ctx.B == NULL)) { perror("EditDistance_Align: malloc of bases" ); exit(EXIT_FAILURE); }
+   Packed_unpack( A, 0, m, ctx.A ) ;
+   Packed_unpack( B, 0, n, ctx.B ) ;
+   ctx.ops = (char *) calloc( m + n + 1, 1 ) ;
+   if (ctx.ops == NULL) { perror("EditDistance_Align: malloc of ops" ); exit(EXIT_FAILURE); }
+
+   Hirschberg_Rec( &ctx, 0, m, 0, n, (nthreads < 1) ? 1 : nthreads ) ;
+
+   {  /* cost of the alignment and run-length encoding of the operations in a CIGAR string */
+      long distance = 0 ;
+      size_t i = 0, j = 0, length = 0 ;
+      char *cigar = (char *) malloc( 2 * (m + n) + 1 ) ; /* at most m+n operations of 1 digit and 1 letter */
+      if (cigar == NULL) { perror("EditDistance_Align: malloc of cigar" ); exit(EXIT_FAILURE); }
+      for (size_t k = 0; k < m + n; )
+      {  char op = ctx.ops[k] ;
+         size_t count = 0 ;
+         while ((k < m + n) && ((ctx.ops[k] == op) || (ctx.ops[k] == 0)))
+         {  if (ctx.ops[k] == op) 
+            {  count++ ;
+               switch (op) 
+               {  case '=' : case 'X' : distance += SUBSTITUTION(ctx.A[i], ctx.B[j]) ; i++ ; j++ ; break ;
+                  case 'I' : distance += INSERTION_COST ; i++ ; break ;
+                  default  : distance += INSERTION_COST ; j++ ; break ;
+               }
+            }
+            k++ ;
+         }
+         length += sprintf( cigar + length, "%zu%c", count, op ) ;
+      }
+      cigar[length] = '\0' ;
+      alignment->distance = distance ;
+      alignment->cigar = (char *) realloc( cigar, length + 1 ) ;
+   }
+   Hirschberg_Bounds( A, &alignment->begin_1, &alignment->end_1 ) ;
+   Hirschberg_Bounds( B, &alignment->begin_2, &alignment->end_2 ) ;
+
+   free( ctx.ops ) ;
+   free( ctx.A ) ;
+   free( ctx.B ) ;
+   return alignment->distance ;
+}
+
+/* EditDistance_Align : cf .h for specification 
+ */
+long EditDistance_Align(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads, struct Alignment *alignment)
+{
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_Align_Packed( &X, &Y, nthreads, alignment ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   return res ;
+}
+
+/* Alignment_free : cf .h for specification 
+ */
+void Alignment_free(struct Alignment *alignment)
+{
+   free( alignment->cigar ) ;
+   alignment->cigar = NULL ;
+}
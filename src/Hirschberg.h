@@ -0,0 +1,66 @@
+/**
+ * \file Hirschberg.h
+ * \brief linear space algorithm that computes an optimal alignment between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ */
+
+#include "Globals.h" /* have all the cost definitions */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/** \struct Alignment
+ * \brief an optimal global alignment of A[0 .. lengthA-1] with B[0 .. lengthB-1]
+ *
+ * The alignment is described by an extended CIGAR string on the bases (the chars that are not bases 
+ * are skipped), A being the query and B the reference: 
+ *    '=' : the bases of A and B match, 'X' : a base of A is substituted by a base of B,
+ *    'I' : a base of A is inserted (not in B), 'D' : a base of B is deleted (not in A);
+ * each operation is prefixed by its number of repetitions, eg "12=1X3I".
+ * The positions are offsets of chars in A and B, including the skipped chars (eg '\n').
+ */
+struct Alignment
+{
+    long distance ;  /*!< edit distance between A and B: cost of the alignment */
+    char *cigar ;    /*!< extended CIGAR string, allocated by EditDistance_Align */
+    size_t begin_1 ; /*!< offset in A of its first base (lengthA if none) */
+    size_t end_1 ;   /*!< offset in A following its last base (0 if none) */
+    size_t begin_2 ; /*!< offset in B of its first base (lengthB if none) */
+    size_t end_2 ;   /*!< offset in B following its last base (0 if none) */
+} ;
+
+/********************************************************************************
+ *  Hirschberg divide and conquer algorithm
+ */
+/**
+ * \fn long EditDistance_Align(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads, struct Alignment *alignment);
+ * \brief computes the edit distance and an optimal alignment between A[0 .. lengthA-1] and B[0 .. lengthB-1]
+ * \param A  : array of char representing a genetic sequence A (query)
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B (reference)
+ * \param lengthB :  number of elements in B 
+ * \param nthreads : number of threads for the independent subproblems (1: sequential)
+ * \param alignment : receives the alignment, to be released by Alignment_free
+ * \return :  edit distance between A and B 
+ *
+ * Hirschberg's algorithm: the bases of A are cut in two halves; a forward pass computes the last row 
+ * of the table for the first half of A and all the prefixes of B, a reverse pass the same for the 
+ * second half of A and all the suffixes of B (both in linear space). The column where their sum is 
+ * minimal is on an optimal path: the two subproblems on each side of this cell are independent 
+ * and are solved recursively, in parallel for the first levels. Small subproblems are solved with
+ * the full table and a traceback.
+ * The memory used is O(lengthA + lengthB), the time about twice the time of the distance only.
+ */
+long EditDistance_Align(char* A, size_t lengthA, char* B, size_t lengthB, int nthreads, struct Alignment *alignment);
+
+/**
+ * \fn long EditDistance_Align_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Alignment *alignment);
+ * \brief same as EditDistance_Align on sequences already packed (cf Packed_init); the offsets of the alignment 
+ * are in the chars A->source and B->source (cf Packed_offset)
+ */
+long EditDistance_Align_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nthreads, struct Alignment *alignment);
+
+/**
+ * \fn void Alignment_free(struct Alignment *alignment)
+ * \brief releases the memory allocated by EditDistance_Align
+ */
+void Alignment_free(struct Alignment *alignment);
@@ -0,0 +1,142 @@
+/**
+ * \file LinearSpace.c
+ * \brief iterative linear space algorithm that computes only the distance between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see LinearSpace.h
+ */
+
+#include "LinearSpace.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "Scoring.h" /* costs of the operations */
+#include "Checkpoint.h" /* checkpoints of the row */
+#include "Progress.h" /* count of the cells computed */
+
+#include <stdio.h>  
+#include <stdlib.h> 
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+/*
+ * static void LS_Row(void *row, enum Base x, const unsigned char *Yb, size_t n, int width, enum ScoringModel model)
+ * \brief updates row from phi(i,.) to phi(i+1,.), the (i+1)-th base of X being x 
+ *
+ * row[j] contains phi(i,j), the distance between the i first bases of X and the j first bases of Y, 
+ * on width bytes (cf CellWidth.h); row is updated in place from left to right, the diagonal value 
+ * phi(i,j-1) being kept in diag before being overwritten. The costs are the ones of _scoring, of model model.
+ */
+CELL_KERNEL void LS_Row(void *row, enum Base x, const unsigned char *Yb, size_t n, int width, enum ScoringModel model)
+{
+   const long indel = Scoring_indel( &_scoring, model ) ;
+   const long *sub_x = _scoring.sub[x] ;
+   long diag = Cell_get( row, 0, width ) ;
+   long left = diag + indel ;
+   Cell_set( row, 0, width, left ) ;
+   for (size_t j = 1; j <= n; ++j)
+   {  long up = Cell_get( row, j, width ) ;
+      long min = Scoring_cost( sub_x, model, x, Yb[j-1] ) + diag ; /* initialization  with cas 1*/
+      { long cas2 = indel + up ;      
+        if (cas2 < min) min = cas2 ;
+      }
+      { long cas3 = indel + left ;      
+        if (cas3 < min) min = cas3 ; 
+      }
+      Cell_set( row, j, width, min ) ;
+      left = min ;
+      diag = up ;
+   }
+}
+
+/*
+ * static long LS_Rows(const struct PackedSequence *X, const unsigned char *Xb, size_t m, const unsigned char *Yb, size_t n, void *row, int width, enum ScoringModel model)
+ * \brief phi(m,n), computed on row (n+1 cells of width bytes); the bases of X are read in X if it is not NULL, else in Xb
+ *
+ * For X packed, with a checkpoint (_checkpoint not NULL), the row and the number of the rows done are saved
+ * when the writer of the checkpoint requests it, and restored with --resume (cf Checkpoint.h).
+ */
+CELL_KERNEL long LS_Rows(const struct PackedSequence *X, const unsigned char *Xb, size_t m, const unsigned char *Yb, size_t n,
+                         void *row, int width, enum ScoringModel model)
+{
+   struct Checkpoint *checkpoint = (X != NULL) ? _checkpoint : NULL ;
+   size_t i0 = 0 ;
+   for (size_t j = 0; j <= n; ++j) Cell_set( row, j, width, Scoring_indel( &_scoring, model ) * (long) j ) ;
+   if (checkpoint != NULL) i0 = Checkpoint_restore( checkpoint, row, (n+1) * width, NULL, 0 ) ;
+   Progress_cells( (uint64_t) i0 * n ) ;
+   if (X != NULL) PerfCounters_phase( PERF_FILL ) ; /* not for the bases: EditDistance_LS_Bases may run in parallel */
+   for (size_t i = i0; i < m; ++i)
+   {  if ((checkpoint != NULL) && Checkpoint_requested( checkpoint ))
+         Checkpoint_save( checkpoint, i, row, (n+1) * width, NULL, 0 ) ;
+      LS_Row( row, (X != NULL) ? Packed_base( X, i ) : Xb[i], Yb, n, width, model ) ;
+      Progress_cells( n ) ;
+   }
+   return Cell_get( row, n, width ) ;
+}
+
+/* phi(m,n) by LS_Rows specialized on the width of the cells, for the model model of the scoring */
+CELL_KERNEL long LS_Widths(const struct PackedSequence *X, const unsigned char *Xb, size_t m, const unsigned char *Yb, size_t n,
+                           void *row, int width, enum ScoringModel model)
+{
+   switch (width)
+   {  case 2 :  return LS_Rows( X, Xb, m, Yb, n, row, 2, model ) ;
+      case 4 :  return LS_Rows( X, Xb, m, Yb, n, row, 4, model ) ;
+      default : return LS_Rows( X, Xb, m, Yb, n, row, 8, model ) ;
+   }
+}
+
+/* phi(m,n) by LS_Rows specialized on the width of the cells for m and n bases and on the model of _scoring */
+static long LS_Dispatch(const struct PackedSequence *X, const unsigned char *Xb, size_t m, const unsigned char *Yb, size_t n,
+                        struct Workspace *ws)
+{
+   int width = Cell_width( m, n ) ;
+   void *row = Workspace_get( ws, 1, (n+1) * width ) ;
+   switch (_scoring.model)
+   {  case SCORING_DEFAULT : return LS_Widths( X, Xb, m, Yb, n, row, width, SCORING_DEFAULT ) ;
+      case SCORING_UNIT :    return LS_Widths( X, Xb, m, Yb, n, row, width, SCORING_UNIT ) ;
+      default :              return LS_Widths( X, Xb, m, Yb, n, row, width, SCORING_MATRIX ) ;
+   }
+}
+
+/* EditDistance_LS_Packed : main function, cf .h for specification.
+ * The bases of the shortest sequence Y are unpacked, the longest one X is read base by base in its packed form.
+ */
+long EditDistance_LS_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws)
+{
+   const struct PackedSequence *X = (A->length >= B->length) ? A : B ; /* X is the longest sequence, Y the shortest */
+   const struct PackedSequence *Y = (A->length >= B->length) ? B : A ;
+   size_t m = X->length, n = Y->length ;
+
+   unsigned char *Yb = (unsigned char *) Workspace_get( ws, 0, n + 1 ) ;
+   Packed_unpack( Y, 0, n, Yb ) ;
+   if (_checkpoint != NULL) Checkpoint_start( _checkpoint, "ls", X, Y ) ;
+   long res = LS_Dispatch( X, NULL, m, Yb, n, ws ) ;
+   if (_checkpoint != NULL) Checkpoint_finish( _checkpoint ) ;
+   return res ;
+}
+
+/* EditDistance_LS_Bases : cf .h for specification 
+ */
+long EditDistance_LS_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws)
+{
+   if (m < n) /* row on the shortest sequence */
+   {  const unsigned char *aux = X ; X = Y ; Y = aux ;
+      size_t aux_size = m ; m = n ; n = aux_size ;
+   }
+   return LS_Dispatch( NULL, X, m, Y, n, ws ) ;
+}
+
+/* EditDistance_LS : cf .h for specification 
+ */
+long EditDistance_LS(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_LS_Packed( &X, &Y, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
@@ -0,0 +1,49 @@
+/**
+ * \file LinearSpace.h
+ * \brief iterative linear space algorithm that computes only the distance between two genetic sequences 
+ * \version 0.1
+ * \date 17/10/2026 
+ */
+
+#include "Globals.h" /* have all the cost definitions */
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/********************************************************************************
+ *  Iterative linear space algorithm (distance only)
+ */
+/**
+ * \fn long EditDistance_LS(char* A, size_t lengthA, char* B, size_t lengthB);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1]
+ * \param A  : array of char representing a genetic sequence A 
+ * \param lengthA :  number of elements in A 
+ * \param B  : array of char representing a genetic sequence B
+ * \param lengthB :  number of elements in B 
+ * \return :  edit distance between A and B 
+ *
+ * EditDistance_LS fills the Needleman-Wunsch table row by row, keeping only one 
+ * row of the table: the memory used is O(min(lengthA, lengthB)) instead of 
+ * O(lengthA * lengthB) for the other engines, but no alignment can be recovered.
+ * The sequences are packed once (chars that are not bases are skipped, cf Packed.h);
+ * the bases of the shortest one are unpacked in one byte each, the longest one is read in its packed form.
+ * The cells of the row are on 2, 4 or 8 bytes, the smallest width that holds the distances (cf CellWidth.h).
+ * The costs are the ones of _scoring (cf Scoring.h): the kernel is specialized on its model.
+ * 
+ * If lengthA < lengthB, the sequences A and B are swapped.
+ *
+ */
+long EditDistance_LS(char* A, size_t lengthA, char* B, size_t lengthB);
+
+/**
+ * \fn long EditDistance_LS_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_LS on sequences already packed (cf Packed_init), the buffers being taken 
+ * in ws (slots 0 and 1) instead of allocated and freed
+ */
+long EditDistance_LS_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
+/**
+ * \fn long EditDistance_LS_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
+ * \brief same as EditDistance_LS_Packed on sequences already unpacked: X[0 .. m-1] and Y[0 .. n-1] are bases 
+ * (enum Base, cf Packed_unpack)
+ */
+long EditDistance_LS_Bases(const unsigned char* X, size_t m, const unsigned char* Y, size_t n, struct Workspace *ws);
@@ -0,0 +1,193 @@
+/**
+ * \file Matrix.c
+ * \brief all-vs-all mode: matrix of the distances between the records of multi-record FASTA files 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Matrix.h
+ */
+
+#include "Matrix.h"
+#include "ThreadPool.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <stdint.h> 
+#include <string.h> 
+#include <err.h> 
+
+/** \struct MatrixPair
+ * \brief the pair of records (i, j), i < j
+ */
+struct MatrixPair { uint32_t i, j ; } ;
+
+/** \struct Matrix
+ * \brief data shared by the tasks
+ */
+struct Matrix 
+{  struct PairOptions options ;
+   size_t n ;                     /*!< number of records */
+   struct PackedSequence *bases ; /*!< bases[r]: packed bases of record r */
+   size_t *length ;               /*!< length[r]: number of bases of record r */
+   struct MatrixPair *pairs ;     /*!< the n(n-1)/2 pairs, by decreasing cost */
+   size_t grain ;                 /*!< a range of at most grain pairs is not split */
+   long *distance ;               /*!< distance[Matrix_Index(i,j)] = d(i,j), i < j */
+   struct Workspace *workspace ;  /*!< one per worker */
+   struct ThreadPool *pool ;
+} ;
+
+/** \struct MatrixRange
+ * \brief argument of a task: the pairs begin .. end-1 
+ */
+struct MatrixRange 
+{  struct Matrix *matrix ;
+   size_t begin, end ;
+} ;
+
+/* index of d(i,j), i < j, in the upper triangle stored row by row */
+static inline size_t Matrix_Index(size_t n, size_t i, size_t j)
+{
+   return i * (2 * n - i - 1) / 2 + (j - i - 1) ;
+}
+
+/* sorts the pairs by decreasing cost */
+static const size_t *_sort_length ; /* lengths of the records, for Matrix_Compare */
+static int Matrix_Compare(const void *a, const void *b)
+{
+   const struct MatrixPair *p = (const struct MatrixPair *) a, *q = (const struct MatrixPair *) b ;
+   double cp = (double) _sort_length[p->i] * (double) _sort_length[p->j] ;
+   double cq = (double) _sort_length[q->i] * (double) _sort_length[q->j] ;
+   return (cp > cq) ? -1 : (cp < cq) ? 1 : 0 ;
+}
+
+static struct MatrixRange *Matrix_Range(struct Matrix *matrix, size_t begin, size_t end)
+{
+   struct MatrixRange *r = (struct MatrixRange *) malloc( sizeof(struct MatrixRange) ) ;
+   if (r == NULL) { perror("Matrix_run: malloc of range" ); exit(EXIT_FAILURE); }
+   r->matrix = matrix ;
+   r->begin = begin ;
+   r->end = end ;
+   return r ;
+}
+
+/*
+ * task: computes the pairs of a range, after having submitted its second half while it is larger than the grain 
+ */
+static void Matrix_Task(void *arg, size_t index, int worker)
+{
+   (void) index ;
+   struct MatrixRange *r = (struct MatrixRange *) arg ;
+   struct Matrix *matrix = r->matrix ;
+   size_t begin = r->begin, end = r->end ;
+   free( r ) ;
+   while (end - begin > matrix->grain) /* the most expensive half first, the cheapest one may be stolen */
+   {  size_t middle = begin + (end - begin) / 2 ;
+      ThreadPool_submit( matrix->pool, Matrix_Task, Matrix_Range( matrix, middle, end ), 0 ) ;
+      end = middle ;
+   }
+   for (size_t k = begin; k < end; ++k)
+   {  size_t i = matrix->pairs[k].i, j = matrix->pairs[k].j ;
+      matrix->distance[Matrix_Index( matrix->n, i, j )] = 
+         Pair_distance_packed( &matrix->options, &matrix->bases[i], &matrix->bases[j], &matrix->workspace[worker] ) ;
+   }
+}
+
+static void Matrix_Print(struct Matrix *matrix, struct SequenceRecord *record, enum MatrixFormat format)
+{
+   size_t n = matrix->n ;
+   if (format == MATRIX_BINARY)
+   {  uint64_t n64 = n ;
+      fwrite( "EDMATRIX", 1, 8, stdout ) ;
+      fwrite( &n64, sizeof(uint64_t), 1, stdout ) ;
+      for (size_t r = 0; r < n; ++r) 
+      {  uint32_t l = (uint32_t) record[r].name_length ;
+         fwrite( &l, sizeof(uint32_t), 1, stdout ) ;
+         fwrite( record[r].name, 1, l, stdout ) ;
+      }
+      for (size_t k = 0; k < n * (n - 1) / 2; ++k) 
+      {  int64_t d = matrix->distance[k] ;
+         fwrite( &d, sizeof(int64_t), 1, stdout ) ;
+      }
+   }
+   else 
+   {  printf( "%5zu\n", n ) ;
+      for (size_t i = 0; i < n; ++i)
+      {  printf( "%-10.*s", record[i].name_length, record[i].name ) ;
+         for (size_t j = 0; j < n; ++j)
+         {  long d = (i == j) ? 0 : matrix->distance[(i < j) ? Matrix_Index( n, i, j ) : Matrix_Index( n, j, i )] ;
+            printf( " %ld", d ) ;
+         }
+         printf( "\n" ) ;
+      }
+   }
+   if (ferror( stdout )) err(1, "write of the matrix") ;
+}
+
+/* Matrix_run : cf .h for specification 
+ */
+void Matrix_run(struct SequenceFile *file[], int nfiles, const struct PairOptions *options, int nthreads, enum MatrixFormat format)
+{
+   /* the records of all the files */
+   struct SequenceRecord *record = NULL ;
+   size_t n = 0 ;
+   for (int f = 0; f < nfiles; ++f)
+   {  struct SequenceRecord *r ;
+      size_t count = SequenceFile_records( file[f], &r ) ;
+      record = (struct SequenceRecord *) realloc( record, (n + count) * sizeof(struct SequenceRecord) ) ;
+      if (record == NULL) { perror("Matrix_run: malloc of records" ); exit(EXIT_FAILURE); }
+      memcpy( record + n, r, count * sizeof(struct SequenceRecord) ) ;
+      n += count ;
+      free( r ) ;
+   }
+   if (n > UINT32_MAX) errx(1, "too many records: %zu", n) ;
+
+   struct Matrix matrix ;
+   matrix.options = *options ;
+   matrix.options.mem_limit /= nthreads ; /* the memory budget is shared by the pairs computed at the same time */
+   matrix.n = n ;
+   size_t npairs = n * (n - 1) / 2 ;
+
+   /* preprocessing: the bases of each record, packed once */
+   matrix.bases = (struct PackedSequence *) malloc( n * sizeof(struct PackedSequence) ) ;
+   matrix.length = (size_t *) malloc( n * sizeof(size_t) ) ;
+   if ((matrix.bases == NULL) || (matrix.length == NULL)) { perror("Matrix_run: malloc" ); exit(EXIT_FAILURE); }
+   for (size_t r = 0; r < n; ++r)
+   {  Packed_init( &matrix.bases[r], record[r].seq, record[r].length ) ;
+      matrix.length[r] = matrix.bases[r].length ;
+   }
+
+   /* the pairs by decreasing cost */
+   matrix.pairs = (struct MatrixPair *) malloc( (npairs + 1) * sizeof(struct MatrixPair) ) ;
+   matrix.distance = (long *) malloc( (npairs + 1) * sizeof(long) ) ;
+   if ((matrix.pairs == NULL) || (matrix.distance == NULL)) { perror("Matrix_run: malloc of pairs" ); exit(EXIT_FAILURE); }
+   {  size_t k = 0 ;
+      for (size_t i = 0; i < n; ++i)
+         for (size_t j = i + 1; j < n; ++j) 
+         {  matrix.pairs[k].i = (uint32_t) i ;
+            matrix.pairs[k].j = (uint32_t) j ;
+            ++k ;
+         }
+   }
+   _sort_length = matrix.length ;
+   qsort( matrix.pairs, npairs, sizeof(struct MatrixPair), Matrix_Compare ) ;
+
+   /* at least 64 ranges per worker */
+   matrix.grain = npairs / (64 * (size_t) nthreads) ;
+   if (matrix.grain < 1) matrix.grain = 1 ;
+   matrix.workspace = (struct Workspace *) calloc( nthreads, sizeof(struct Workspace) ) ;
+   if (matrix.workspace == NULL) { perror("Matrix_run: malloc of workspaces" ); exit(EXIT_FAILURE); }
+   matrix.pool = ThreadPool_create( nthreads ) ;
+   if (npairs > 0) ThreadPool_submit( matrix.pool, Matrix_Task, Matrix_Range( &matrix, 0, npairs ), 0 ) ;
+   ThreadPool_destroy( matrix.pool ) ;
+
+   Matrix_Print( &matrix, record, format ) ;
+
+   for (int w = 0; w < nthreads; ++w) Workspace_release( &matrix.workspace[w] ) ;
+   free( matrix.workspace ) ;
+   for (size_t r = 0; r < n; ++r) Packed_free( &matrix.bases[r] ) ;
+   free( matrix.bases ) ;
+   free( matrix.length ) ;
+   free( matrix.pairs ) ;
+   free( matrix.distance ) ;
+   free( record ) ;
+}
@@ -0,0 +1,43 @@
+/**
+ * \file Matrix.h
+ * \brief all-vs-all mode: matrix of the distances between the records of multi-record FASTA files 
+ * \version 0.1
+ * \date 17/10/2026 
+ */
+
+#ifndef __MATRIX_h__
+#define __MATRIX_h__
+
+#include "Pair.h" 
+#include "SequenceFile.h" 
+
+/**
+ * \enum MatrixFormat
+ * \brief output format of the matrix
+ *
+ * MATRIX_PHYLIP: text, square matrix in (relaxed) PHYLIP format: the number n of records on the first line, 
+ *    then one line per record: its name (padded to 10 chars) and its n distances separated by spaces.
+ * MATRIX_BINARY: the 8 chars "EDMATRIX", n as an uint64_t, the n names each one as an uint32_t length 
+ *    followed by its chars, then the n(n-1)/2 distances d(i,j), i < j, row by row, as int64_t 
+ *    (all integers in the byte order of the host).
+ * A distance that exceeds --max-distance is -1 (DISTANCE_ABOVE_MAX).
+ */
+enum MatrixFormat { MATRIX_PHYLIP = 0, MATRIX_BINARY = 1 } ;
+
+/**
+ * \fn void Matrix_run(struct SequenceFile *file[], int nfiles, const struct PairOptions *options, int nthreads, enum MatrixFormat format)
+ * \brief prints on stdout the matrix of the distances between all the records of the files file[0 .. nfiles-1]
+ * \param file, nfiles : the FASTA files (their records are numbered in the order of the files, then of the records)
+ * \param options : what is computed for each pair (only the distance, with options->max_distance if >= 0)
+ * \param nthreads : number of worker threads
+ * \param format : output format 
+ *
+ * The bases of each record are packed once (cf Packed_init) and reused for all its pairs.
+ * Only the upper triangle (i < j) is computed: the n(n-1)/2 pairs are sorted by decreasing estimated 
+ * cost (product of the lengths) and scheduled by work stealing (cf ThreadPool.h): a task on a range 
+ * of pairs splits it in two halves while it is larger than a grain, and submits the second half, 
+ * that an idle worker may steal. Each pair is computed by one thread with its own struct Workspace.
+ */
+void Matrix_run(struct SequenceFile *file[], int nfiles, const struct PairOptions *options, int nthreads, enum MatrixFormat format) ;
+
+#endif /* __MATRIX_h__ */
@@ -1,4 +1,8 @@
 #include "Needleman-Wunsch-itmemo.h"
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "Progress.h" /* count of the cells computed */
 
 #include <stdio.h>  
 #include <stdlib.h> 
@@ -7,117 +11,94 @@
 
 #include "characters_to_base.h" /* mapping from char to base */
 
-/* EditDistance_NW_It : It is the main function, performs the calculations
- * in an iterative manner. It dones so by filling up a table that represents
- * the insertions, deletions or substitions, giving the costs of .h
+/* NW_It_Fill : fills the table edit_dist[0..totalRows][0..totalCols] of cells of width bytes (cf CellWidth.h)
+ * and returns its last cell; specialized on width by each call of EditDistance_NW_It_Packed
  */
-long EditDistance_NW_It(char* A, size_t lengthA, char* B, size_t lengthB) {
-
-    if(lengthA<lengthB) {
-        char *aux = B;
-        B = A;
-        A = aux;
-
-        size_t aux_size = lengthA;
-        lengthA = lengthB;
-        lengthB = aux_size;
-    }
-
-    _init_base_match();
-
-    // creates the tables of length
-    // the +1 to take deletions and insertions into account
-    // simulates long edit_dist[lengthA+1][lengthB+1] = {0};
-
-    // lengthA + 1 = number of rows
-    long** edit_dist = (long**)malloc( (lengthB+1) * sizeof(long*));
-    for(int i=0; i<lengthA+1; i++) {
-        // lengthB + 1 = number os columns
-        edit_dist[i] = (long*)malloc( (lengthA+1) * sizeof(long));
-        for(int j=0; j<lengthA+1; j++)
-            edit_dist[i][j] = 0;
-    }
+CELL_KERNEL long NW_It_Fill(const struct PackedSequence *X, const unsigned char *Yb, void **edit_dist, 
+                            size_t totalRows, size_t totalCols, int width) {
 
-    //rows and cols to ignore the chars that are not bases
-    int row = 1, col = 1;
     // just insertions and deletions for the first row and column
-    for(int i=1; i<lengthA+1; i++) {
-        // for the row
-        if(isBase(A[i-1])) {
-            // if it is a base, calculate the cost of insertion
-            edit_dist[0][col] = INSERTION_COST * col;
-            // printf("col[%d] -> %zu\n", col, edit_dist[0][col]);
-            col++;
-            // otherwise, don't add anything to the value
-        }
-    }
-    for(int i=1; i<lengthB+1; i++) {
-        // for the column
-        if(isBase(B[i-1])) {
-            //printf("%c", B[i-1]);
-            edit_dist[row][0] = INSERTION_COST * row;
-            // printf("row[%d] -> %zu\n", row, edit_dist[row][0]);
-            row++;
-        }
-    }
-
-    int totalCols = col - 1;
-    int totalRows = row - 1;
-
-    // printf("row: %zu\ncol: %zu\n", totalRows, totalCols);
-
-    // for(int i=0; i<totalRows+1;i++) {
-    //     for(int j=0; j<totalCols+1; j++) {
-    //         printf("%zu ", edit_dist[i][j]);
-    //     }
-    //     printf("\n");
-    // }
-
+    for(size_t col=0; col<totalCols+1; col++) Cell_set(edit_dist[0], col, width, INSERTION_COST * (long)col);
+    for(size_t row=0; row<totalRows+1; row++) Cell_set(edit_dist[row], 0, width, INSERTION_COST * (long)row);
+    PerfCounters_phase(PERF_FILL);
 
     // the evaluation loop
     // starts in 1 to make sense of the table organization
     // as the index 0,0 doesn't represent a char
-    long delta;
-    col = 1;
-    for(int i=0; i<lengthA; i++) {
-        row = 1;
-        for(int j=0; j<lengthB; j++) {
-            // test if it is indeed a base
-            if(isBase(A[i]) && isBase(B[j])) {
-                // initialization  with cas 1
-                long min = isUnknownBase(A[i]) ?  
-                                SUBSTITUTION_UNKNOWN_COST : 
-                                ( isSameBase(A[i], B[j]) ? 0 : SUBSTITUTION_COST )
-                            + edit_dist[row-1][col-1];
-                { 
-                    long cas2 = INSERTION_COST + edit_dist[row][col-1] ;      
-                    if (cas2 < min) min = cas2 ;
-                }
-                { 
-                    long cas3 = INSERTION_COST + edit_dist[row-1][col];      
-                    if (cas3 < min) min = cas3 ; 
-                }
-                // the value is updated with the min
-                edit_dist[row][col] = min;
-                
-                // update row count
-                row++;
+    for(size_t col=1; col<totalCols+1; col++) {
+        enum Base x = Packed_base(X, col-1);
+        for(size_t row=1; row<totalRows+1; row++) {
+            // initialization  with cas 1
+            long min = ( (x == UNKOWN_BASE) ?  
+                            SUBSTITUTION_UNKNOWN_COST : 
+                            ( (x == Yb[row-1]) ? 0 : SUBSTITUTION_COST ) )
+                        + Cell_get(edit_dist[row-1], col-1, width);
+            { 
+                long cas2 = INSERTION_COST + Cell_get(edit_dist[row], col-1, width) ;      
+                if (cas2 < min) min = cas2 ;
             }
+            { 
+                long cas3 = INSERTION_COST + Cell_get(edit_dist[row-1], col, width);      
+                if (cas3 < min) min = cas3 ; 
+            }
+            // the value is updated with the min
+            Cell_set(edit_dist[row], col, width, min);
         }
-        if(isBase(A[i])) {
-            // update column count
-            col++;
-        }
+        Progress_cells(totalRows);
     }
+    return Cell_get(edit_dist[totalRows], totalCols, width);
+}
+
+/* EditDistance_NW_It_Packed : It is the main function, performs the calculations
+ * in an iterative manner. It dones so by filling up a table that represents
+ * the insertions, deletions or substitions, giving the costs of .h
+ * The sequences are packed (cf Packed.h): the loops run on the bases only.
+ * The table is one array of the arena of ws (cf Arena.h), rows after rows, 
+ * of cells of the smallest width that holds the distances (cf CellWidth.h).
+ */
+long EditDistance_NW_It_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws) {
 
-    // printf("row: %zu\ncol: %zu\n", totalRows, totalCols);
+    const struct PackedSequence *X = A, *Y = B;
+    if(A->length < B->length) {
+        X = B;
+        Y = A;
+    }
+    size_t totalCols = X->length;
+    size_t totalRows = Y->length;
+    int width = Cell_width(totalCols, totalRows);
 
-    // for(int i=0; i<totalRows+1;i++) {
-    //     for(int j=0; j<totalCols+1; j++) {
-    //         printf("%zu ", edit_dist[i][j]);
-    //     }
-    //     printf("\n");
-    // }
+    // the bases of Y, read for each column, the pointers to the rows and the rows of the table,
+    // simulates edit_dist[totalRows+1][totalCols+1]
+    // the +1 to take deletions and insertions into account
+    Arena_reserve(&ws->arena, Arena_bytes(totalRows + 1) + Arena_bytes((totalRows+1) * sizeof(void*))
+                              + Arena_bytes((totalRows+1) * (totalCols+1) * width));
+    unsigned char *Yb = (unsigned char*)Arena_alloc(&ws->arena, totalRows + 1, 0);
+    Packed_unpack(Y, 0, totalRows, Yb);
+    void** edit_dist = (void**)Arena_alloc(&ws->arena, (totalRows+1) * sizeof(void*), 0);
+    edit_dist[0] = Arena_alloc(&ws->arena, (totalRows+1) * (totalCols+1) * width, 0);
+    for(size_t i=1; i<totalRows+1; i++) edit_dist[i] = (char*)edit_dist[i-1] + (totalCols+1) * width;
+
+    long res;
+    switch(width) {
+        case 2 :  res = NW_It_Fill(X, Yb, edit_dist, totalRows, totalCols, 2); break;
+        case 4 :  res = NW_It_Fill(X, Yb, edit_dist, totalRows, totalCols, 4); break;
+        default : res = NW_It_Fill(X, Yb, edit_dist, totalRows, totalCols, 8);
+    }
+    PerfCounters_phase(PERF_TEARDOWN);
+    return res;
+}
 
-    return edit_dist[totalRows][totalCols];
+/* EditDistance_NW_It : packs the bases (the chars that are not bases are skipped once for all)
+ * and calls EditDistance_NW_It_Packed with a workspace of its own
+ */
+long EditDistance_NW_It(char* A, size_t lengthA, char* B, size_t lengthB) {
+    struct PackedSequence PA, PB;
+    Packed_init(&PA, A, lengthA);
+    Packed_init(&PB, B, lengthB);
+    struct Workspace ws = WORKSPACE_INITIALIZER;
+    long res = EditDistance_NW_It_Packed(&PA, &PB, &ws);
+    Workspace_release(&ws);
+    Packed_free(&PA);
+    Packed_free(&PB);
+    return res;
 }
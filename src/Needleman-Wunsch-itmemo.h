@@ -6,6 +6,8 @@
  */
 
 #include "Globals.h" /* have all the cost definitions */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+#include "Workspace.h" /* the arena of the table */
 
 /********************************************************************************
  * Iterative implementation of NeedlemanWunsch with memoization
@@ -28,3 +30,10 @@
  */
 long EditDistance_NW_It(char* A, size_t lengthA, char* B, size_t lengthB);
 
+/**
+ * \fn long EditDistance_NW_It_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+ * \brief same as EditDistance_NW_It on sequences already packed (cf Packed_init); the table is one array of
+ * the arena of ws (cf Arena.h), reused by the next computations with ws
+ */
+long EditDistance_NW_It_Packed(const struct PackedSequence *A, const struct PackedSequence *B, struct Workspace *ws);
+
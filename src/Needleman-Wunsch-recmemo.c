@@ -7,11 +7,12 @@
  *
  * Documentation: see Needleman-Wunsch-recmemo.h
  * Costs of basic base opertaions (SUBSTITUTION_COST, SUBSTITUTION_UNKNOWN_COST, INSERTION_COST) are
- * defined in Needleman-Wunsch-recmemo.h
+ * defined in Globals.h
  */
 
 
 #include "Needleman-Wunsch-recmemo.h"
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
 #include <stdio.h>  
 #include <stdlib.h> 
 #include <string.h> /* for strchr */
@@ -23,9 +24,10 @@
    
 /* Context of the memoization : passed to all recursive calls */
 /** \def NOT_YET_COMPUTED
- * \brief default value for memoization of minimal distance (defined as an impossible value for a distance, -1).
+ * \brief default value for memoization of minimal distance: memo stores phi+1, so that 0 is an impossible value,
+ * the one of the zero pages of the arena (no initialization of the table).
  */
-#define NOT_YET_COMPUTED -1L 
+#define NOT_YET_COMPUTED 0L 
 
 /** \struct NW_MemoContext
  * \brief data for memoization of recursive Needleman-Wunsch algorithm 
@@ -36,7 +38,7 @@ struct NW_MemoContext
     char *Y ; /*!< the shortest genetic sequences */
     size_t M; /*!< length of X */
     size_t N; /*!< length of Y,  N <= M */
-    long **memo; /*!< memoization table to store memo[0..M][0..N] (including stopping conditions phi(M,j) and phi(i,N) */
+    long **memo; /*!< memoization table to store memo[0..M][0..N] = phi+1 (including stopping conditions phi(M,j) and phi(i,N) */
 } ;
 
 /*
@@ -85,17 +87,17 @@ static long EditDistance_NW_RecMemo(struct NW_MemoContext *c, size_t i, size_t j
          }
          res = min ;
       }
-       c->memo[i][j] = res ;
+       c->memo[i][j] = res + 1 ;
    }
-   return c->memo[i][j] ;
+   return c->memo[i][j] - 1 ;
 }
 
-/* EditDistance_NW_Rec :  is the main function to call, cf .h for specification 
- * It allocates and initailizes data (NW_MemoContext) for memoization and call the 
+/* EditDistance_NW_Rec_Arena :  is the main function to call, cf .h for specification 
+ * It allocates data (NW_MemoContext) for memoization in arena and call the 
  * recursivefunction EditDistance_NW_RecMemo 
  * See .h file for documentation
  */
-long EditDistance_NW_Rec(char* A, size_t lengthA, char* B, size_t lengthB)
+long EditDistance_NW_Rec_Arena(char* A, size_t lengthA, char* B, size_t lengthB, struct Arena *arena)
 {
    _init_base_match() ;
    struct NW_MemoContext ctx;
@@ -113,27 +115,31 @@ long EditDistance_NW_Rec(char* A, size_t lengthA, char* B, size_t lengthB)
    }
    size_t M = ctx.M ;
    size_t N = ctx.N ;
-   {  /* Allocation and initialization of ctx.memo to NOT_YET_COMPUTED*/
-      /* Note: memo is of size (N+1)*(M+1) but is stored as (M+1) distinct arrays each with (N+1) continuous elements 
-       * It would have been possible to allocate only one big array memezone of (M+1)*(N+1) elements 
-       * and then memo as an array of (M+1) pointers, the memo[i] being the address of memzone[i*(N+1)].
+   {  /* Allocation of ctx.memo, NOT_YET_COMPUTED by the zero pages of the arena */
+      /* Note: memo is of size (N+1)*(M+1), stored as one big array memzone of (M+1)*(N+1) elements 
+       * and memo as an array of (M+1) pointers, the memo[i] being the address of memzone[i*(N+1)].
        */ 
-      ctx.memo = (long **) malloc ( (M+1) * sizeof(long *)) ;
-      if (ctx.memo == NULL) { perror("EditDistance_NW_Rec: malloc of ctx_memo" ); exit(EXIT_FAILURE); }
-      for (int i=0; i <= M; ++i) 
-      {  ctx.memo[i] = (long*) malloc( (N+1) * sizeof(long));
-         if (ctx.memo[i] == NULL) { perror("EditDistance_NW_Rec: malloc of ctx_memo[i]" ); exit(EXIT_FAILURE); }
-         for (int j=0; j<=N; ++j) ctx.memo[i][j] = NOT_YET_COMPUTED ;
-      }
+      Arena_reserve( arena, Arena_bytes( (M+1) * sizeof(long *) ) + Arena_bytes( (M+1) * (N+1) * sizeof(long) ) ) ;
+      ctx.memo = (long **) Arena_alloc( arena, (M+1) * sizeof(long *), 0 ) ;
+      long *memzone = (long *) Arena_alloc( arena, (M+1) * (N+1) * sizeof(long), 1 ) ;
+      for (size_t i=0; i <= M; ++i) ctx.memo[i] = memzone + i * (N+1) ;
    }    
    
    /* Compute phi(0,0) = ctx.memo[0][0] by calling the recursive function EditDistance_NW_RecMemo */
+   PerfCounters_phase( PERF_FILL ) ;
    long res = EditDistance_NW_RecMemo( &ctx, 0, 0 ) ;
-    
-   { /* Deallocation of ctx.memo */
-      for (int i=0; i <= M; ++i) free( ctx.memo[i] ) ;
-      free( ctx.memo ) ;
-   }
+   PerfCounters_phase( PERF_TEARDOWN ) ;
+   return res ;
+}
+
+/* EditDistance_NW_Rec : cf .h for specification 
+ * EditDistance_NW_Rec_Arena with an arena of its own 
+ */
+long EditDistance_NW_Rec(char* A, size_t lengthA, char* B, size_t lengthB)
+{
+   struct Arena arena = ARENA_INITIALIZER ;
+   long res = EditDistance_NW_Rec_Arena( A, lengthA, B, lengthB, &arena ) ;
+   Arena_release( &arena ) ;
    return res ;
 }
 
@@ -6,27 +6,8 @@
  * \author Jean-Louis Roch (Ensimag, Grenoble-INP - University Grenoble-Alpes) jean-louis.roch@grenoble-inp.fr
  */
 
-#include <stdlib.h> /* for size_t */
-
-/*
- * Costs for operations on canonical bases
- * Three  operations: insertion and sustitution of one base by an another 
- * Note= substitution of an unknown base N by another one (known or unknown) as the same cost than substitution between 2 different known bases
- */
-/** \def SUBSTITUTION_COST
- *  \brief Cost of substitution of one canonical base by another
- */
-#define SUBSTITUTION_COST	1
-
-/** \def SUBSTITUTION_UNKNOWN_COST
- *  \brief Cost of substitution of an unknown base (N) by another one (canonical or unknown)
- */
-#define SUBSTITUTION_UNKNOWN_COST	1  /* Cost for sustitition of an Unknown bas N by another on -known or unkown- */ 
-
-/** \def INSERTION_COST
- *  \brief Cost of insertion of a canonical base 
- */
-#define INSERTION_COST		2
+#include "Globals.h" /* have all the cost definitions */
+#include "Arena.h" /* one mapping for the memoization table */
 
 /********************************************************************************
  * Recursive implementation of NeedlemanWunsch with memoization
@@ -49,3 +30,10 @@
  */
 long EditDistance_NW_Rec(char* A, size_t lengthA, char* B, size_t lengthB);
 
+/**
+ * \fn long EditDistance_NW_Rec_Arena(char* A, size_t lengthA, char* B, size_t lengthB, struct Arena *arena);
+ * \brief same as EditDistance_NW_Rec, the memoization table being one array of arena (cf Arena.h), 
+ * reused by the next computations with arena
+ */
+long EditDistance_NW_Rec_Arena(char* A, size_t lengthA, char* B, size_t lengthB, struct Arena *arena);
+
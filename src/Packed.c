@@ -0,0 +1,123 @@
+/**
+ * \file Packed.c
+ * \brief genetic sequences packed on 2 bits per base (plus 1 bit for the rare bases N and U)
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Packed.h
+ */
+
+#include "Packed.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+void Packed_init(struct PackedSequence *ps, const char *S, size_t length)
+{
+   Packed_create( ps, length ) ;
+   Packed_append( ps, S, length ) ;
+   ps->source = S ;
+}
+
+void Packed_create(struct PackedSequence *ps, size_t capacity)
+{
+   _init_base_match() ;
+   size_t nwords = capacity / 64 + 1 ;
+   ps->code = (uint64_t *) calloc( 2 * nwords, sizeof(uint64_t) ) ;
+   ps->rare = (uint64_t *) calloc( nwords, sizeof(uint64_t) ) ;
+   ps->checkpoint = (size_t *) malloc( nwords * sizeof(size_t) ) ;
+   if ((ps->code == NULL) || (ps->rare == NULL) || (ps->checkpoint == NULL)) 
+   {  perror("Packed_create: malloc" ); exit(EXIT_FAILURE); 
+   }
+   ps->length = 0 ;
+   ps->source = NULL ;
+   ps->source_length = 0 ;
+}
+
+/* Packed_append : cf .h for specification.
+ * Each char is encoded whether it is a base or not (the code of a skipped char is 0 and is 
+ * overwritten by the next base); the position n of the next base advances only after a base.
+ * The last words, partially filled by the previous call, are reloaded (0 on the first call, calloc).
+ */
+void Packed_append(struct PackedSequence *ps, const char *S, size_t count)
+{
+   size_t n = ps->length ;
+   size_t offset = ps->source_length ;
+   uint64_t code = ps->code[n / 32], rare = ps->rare[n / 64] ;
+   for (size_t k = 0; k < count; ++k)
+   {  unsigned b = CharToBase((unsigned char) S[k]) ;
+      unsigned valid = (b != SKIP_BASE) ;
+      if (! valid) ManageBaseError( S[k] ) ; /* nothing unless BASE_ERROR_TREATMENT is defined */
+      unsigned r = (b >= URACILE) ;
+      unsigned c = r ? (UNKOWN_BASE - b) : (b - 1) ;
+      code |= (uint64_t) (c & -valid) << (2 * (n % 32)) ;
+      rare |= (uint64_t) r << (n % 64) ;
+      if (valid && (n % 64 == 0)) ps->checkpoint[n / 64] = offset + k ;
+      n += valid ;
+      if (valid && (n % 32 == 0)) { ps->code[n / 32 - 1] = code ; code = 0 ; }
+      if (valid && (n % 64 == 0)) { ps->rare[n / 64 - 1] = rare ; rare = 0 ; }
+   }
+   if (n % 32 != 0) ps->code[n / 32] = code ;
+   if (n % 64 != 0) ps->rare[n / 64] = rare ;
+   ps->length = n ;
+   ps->source_length = offset + count ;
+}
+
+void Packed_free(struct PackedSequence *ps)
+{
+   free( ps->code ) ;
+   free( ps->rare ) ;
+   free( ps->checkpoint ) ;
+   ps->code = ps->rare = NULL ;
+   ps->checkpoint = NULL ;
+   ps->length = 0 ;
+}
+
+void Packed_unpack(const struct PackedSequence *ps, size_t begin, size_t count, unsigned char *out)
+{
+   for (size_t k = 0; k < count; ++k) out[k] = (unsigned char) Packed_base( ps, begin + k ) ;
+}
+
+size_t Packed_offset(const struct PackedSequence *ps, size_t k)
+{
+   if (k >= ps->length) return (ps->length == 0) ? 0 : Packed_offset( ps, ps->length - 1 ) + 1 ;
+   size_t j = ps->checkpoint[k / 64] ;
+   for (size_t skip = k % 64; ; ++j) 
+      if (isBase((unsigned char) ps->source[j]))
+      {  if (skip == 0) return j ;
+         --skip ;
+      }
+}
+
+/* the 32 bits of even rank of w, ie the low bits of the 32 codes of a word */
+static inline uint64_t Packed_EvenBits(uint64_t w)
+{
+   w &= 0x5555555555555555ULL ;
+   w = (w | (w >> 1)) & 0x3333333333333333ULL ;
+   w = (w | (w >> 2)) & 0x0F0F0F0F0F0F0F0FULL ;
+   w = (w | (w >> 4)) & 0x00FF00FF00FF00FFULL ;
+   w = (w | (w >> 8)) & 0x0000FFFF0000FFFFULL ;
+   w = (w | (w >> 16)) & 0x00000000FFFFFFFFULL ;
+   return w ;
+}
+
+uint64_t Packed_match(const struct PackedSequence *ps, size_t b, int base)
+{
+   uint64_t lo = Packed_EvenBits( ps->code[2*b] ) | (Packed_EvenBits( ps->code[2*b+1] ) << 32) ;
+   uint64_t hi = Packed_EvenBits( ps->code[2*b] >> 1 ) | (Packed_EvenBits( ps->code[2*b+1] >> 1 ) << 32) ;
+   uint64_t rare = ps->rare[b] ;
+   uint64_t exists = (64 * (b + 1) <= ps->length) ? ~(uint64_t) 0 
+                   : (64 * b >= ps->length) ? 0 : ((uint64_t) 1 << (ps->length - 64 * b)) - 1 ;
+   uint64_t m ;
+   switch (base)
+   {  case ADENINE :  m = ~lo & ~hi & ~rare ; break ;
+      case CYTOSINE : m = lo & ~hi & ~rare ; break ;
+      case GUANINE :  m = ~lo & hi & ~rare ; break ;
+      case THYMINE :  m = lo & hi & ~rare ; break ;
+      case URACILE :  m = lo & rare ; break ;
+      default :       m = 0 ; /* UNKOWN_BASE matches nothing */
+   }
+   return m & exists ;
+}
@@ -0,0 +1,95 @@
+/**
+ * \file Packed.h
+ * \brief genetic sequences packed on 2 bits per base (plus 1 bit for the rare bases N and U)
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * The chars of a sequence that are not bases (eg '\n') are skipped once by Packed_init, 
+ * the engines then read only bases: no test isBase per cell, and 4 times less memory to read 
+ * than one char per base. Encoding of the base k:
+ *    code (2 bits, 32 bases per uint64_t): ADENINE=0, CYTOSINE=1, GUANINE=2, THYMINE=3 
+ *    rare (1 bit, 64 bases per uint64_t): 1 for UNKOWN_BASE (code 0) or URACILE (code 1)
+ * so 3 bits in all. The offset in the original chars of every 64-th base is kept, to map the 
+ * bases back to the file (eg for the bounds of an alignment).
+ */
+
+#ifndef __PACKED_h__
+#define __PACKED_h__
+
+#include <stdlib.h> /* for size_t */
+#include <stdint.h> 
+
+/**
+ * \struct PackedSequence
+ * \brief the bases of S[0 .. length-1]
+ */
+struct PackedSequence 
+{  size_t length ;       /*!< number of bases */
+   uint64_t *code ;      /*!< 2 bits per base, base k in bits 2*(k%32) .. 2*(k%32)+1 of code[k/32] */
+   uint64_t *rare ;      /*!< 1 bit per base, base k in bit k%64 of rare[k/64]: 1 iff N or U */
+   size_t *checkpoint ;  /*!< checkpoint[b] = offset in S of the base 64*b */
+   const char *source ;  /*!< S, for Packed_offset; NULL if the chars are not kept (Packed_append) */
+   size_t source_length ; /*!< number of chars of S */
+} ;
+
+/**
+ * \fn void Packed_init(struct PackedSequence *ps, const char *S, size_t length)
+ * \brief packs the bases of S[0 .. length-1] in ps, skipping the chars that are not bases (one pass, without branch per char)
+ */
+void Packed_init(struct PackedSequence *ps, const char *S, size_t length) ;
+
+/**
+ * \fn void Packed_create(struct PackedSequence *ps, size_t capacity)
+ * \brief makes ps an empty sequence, to be filled by Packed_append with at most capacity chars in all
+ */
+void Packed_create(struct PackedSequence *ps, size_t capacity) ;
+
+/**
+ * \fn void Packed_append(struct PackedSequence *ps, const char *S, size_t count)
+ * \brief packs the bases of S[0 .. count-1] after the bases of ps, eg for a sequence read by chunks from a pipe.
+ *
+ * The chars appended are not kept: ps->source remains NULL (Packed_offset is then not available), 
+ * the checkpoints are offsets from the first char appended.
+ */
+void Packed_append(struct PackedSequence *ps, const char *S, size_t count) ;
+
+/**
+ * \fn void Packed_free(struct PackedSequence *ps)
+ * \brief frees the arrays of ps
+ */
+void Packed_free(struct PackedSequence *ps) ;
+
+/**
+ * \fn void Packed_unpack(const struct PackedSequence *ps, size_t begin, size_t count, unsigned char *out)
+ * \brief stores in out[0 .. count-1] the bases begin .. begin+count-1 of ps as enum Base (cf characters_to_base.h), 
+ * eg for the engines that compute one byte per cell in vectors
+ */
+void Packed_unpack(const struct PackedSequence *ps, size_t begin, size_t count, unsigned char *out) ;
+
+/**
+ * \fn size_t Packed_offset(const struct PackedSequence *ps, size_t k)
+ * \brief offset in S of the base k (k < ps->length), or of the char following the last base if k == ps->length 
+ * (reads at most the chars of S between two checkpoints)
+ */
+size_t Packed_offset(const struct PackedSequence *ps, size_t k) ;
+
+/**
+ * \fn uint64_t Packed_match(const struct PackedSequence *ps, size_t b, int base)
+ * \brief bit k is set iff the base 64*b+k of ps exists and is base (enum Base, ADENINE .. URACILE; UNKOWN_BASE matches nothing)
+ *
+ * Computed on the packed words, without reading the bases one by one (eg for the bit-parallel engine).
+ */
+uint64_t Packed_match(const struct PackedSequence *ps, size_t b, int base) ;
+
+/**
+ * \fn static inline int Packed_base(const struct PackedSequence *ps, size_t k)
+ * \brief the base k of ps (enum Base)
+ */
+static inline int Packed_base(const struct PackedSequence *ps, size_t k)
+{
+   int c = (int) ((ps->code[k / 32] >> (2 * (k % 32))) & 3) ;
+   int r = (int) ((ps->rare[k / 64] >> (k % 64)) & 1) ;
+   return (1 + c) + r * (5 - 2 * c) ; /* ADENINE + c, or UNKOWN_BASE - c if rare */
+}
+
+#endif /* __PACKED_h__ */
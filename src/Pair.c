@@ -0,0 +1,107 @@
+/**
+ * \file Pair.c
+ * \brief computation of the output for one pair of sequences
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Pair.h
+ */
+
+#include "Pair.h"
+
+#include "Engine.h" // engines of the distance, chosen under the memory budget
+#include "Banded.h" // DISTANCE_ABOVE_MAX
+#include "Hirschberg.h" // alignment in linear space (--align)
+#include "Anchored.h" // DP between the anchors of similar sequences (--anchor)
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <string.h> /* for strlen */
+#include <err.h>
+
+/* the engine of the distance between sequences of m and n bases: the one forced by options->engine, 
+ * or the fastest one whose footprint fits in options->mem_limit; exits if it does not fit
+ */
+static enum Engine Pair_Engine(const struct PairOptions *options, size_t m, size_t n, int nthreads)
+{
+   enum Engine engine = options->engine ;
+   if (engine == ENGINE_AUTO) 
+   {  engine = Engine_select( m, n, options->max_distance, nthreads, options->mem_limit ) ;
+      if (engine == ENGINE_AUTO) 
+         errx(1, "no engine fits in the memory limit of %zu bytes for sequences of %zu and %zu bases", options->mem_limit, m, n) ;
+   }
+   else if ((options->mem_limit != 0) && (Engine_footprint( engine, m, n, options->max_distance ) > options->mem_limit))
+      errx(1, "engine %s needs about %zu bytes for sequences of %zu and %zu bases, above the memory limit of %zu bytes", 
+              Engine_name( engine ), Engine_footprint( engine, m, n, options->max_distance ), m, n, options->mem_limit) ;
+   return engine ;
+}
+
+/* the distance by engine: from the anchors with options->anchor (cf Anchored.h); in auto mode, by the wavefronts
+ * first, bounded by the distance up to which they are faster than engine (cf Engine_wavefront_bound)
+ */
+static long Pair_Distance(const struct PairOptions *options, enum Engine engine, const struct PackedSequence *X,
+                          const struct PackedSequence *Y, int nthreads, struct Workspace *ws)
+{
+   long max_distance = options->max_distance ;
+   if (options->anchor > 0) return EditDistance_Anchored_Packed( X, Y, options->anchor, engine, max_distance, nthreads, ws ) ;
+   if ((options->engine == ENGINE_AUTO) && Engine_available( ENGINE_WFA, max_distance ))
+   {  long bound = Engine_wavefront_bound( engine, X->length, Y->length, max_distance, nthreads ) ;
+      if ((max_distance >= 0) && (max_distance <= bound)) return Engine_distance( ENGINE_WFA, X, Y, max_distance, 1, ws ) ;
+      long res = Engine_wavefront_try( X, Y, bound, ws ) ;
+      if (res != DISTANCE_ABOVE_MAX) return res ; /* else the distance is above bound: engine */
+   }
+   return Engine_distance( engine, X, Y, max_distance, nthreads, ws ) ;
+}
+
+/* Pair_distance_packed : cf .h for specification 
+ */
+long Pair_distance_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws)
+{
+   enum Engine engine = Pair_Engine( options, X->length, Y->length, 1 ) ;
+   return Pair_Distance( options, engine, X, Y, 1, ws ) ;
+}
+
+/* Pair_compute : cf .h for specification 
+ */
+char *Pair_compute(const struct PairOptions *options, struct SequenceFile *file[2], char *seq[2], long length[2], struct Workspace *ws)
+{
+   struct PackedSequence X, Y ; /* the pre-pass: the engines read only the packed bases */
+   Packed_init( &X, seq[0], length[0] ) ;
+   Packed_init( &Y, seq[1], length[1] ) ;
+   char *line ;
+   if (options->align) 
+   {  struct Alignment alignment ;
+      long res = EditDistance_Align_Packed(&X, &Y, options->nthreads, &alignment) ;
+      /* one record: offsets in the files of the aligned sequences, distance and CIGAR */
+      long offset[2] = { seq[0] - file[0]->data, seq[1] - file[1]->data } ;
+      size_t size = strlen( file[0]->name ) + strlen( file[1]->name ) + strlen( alignment.cigar ) + 7 * 21 + 8 ;
+      line = (char *) malloc( size ) ;
+      if (line == NULL) { perror("Pair_compute: malloc of line" ); exit(EXIT_FAILURE); }
+      snprintf(line, size, "%s\t%ld\t%ld\t%s\t%ld\t%ld\t%ld\t%s\n", 
+             file[0]->name, offset[0] + (long) alignment.begin_1, offset[0] + (long) alignment.end_1,
+             file[1]->name, offset[1] + (long) alignment.begin_2, offset[1] + (long) alignment.end_2,
+             res, alignment.cigar ) ;
+      Alignment_free( &alignment ) ;
+      Packed_free( &X ) ;
+      Packed_free( &Y ) ;
+      return line ;
+   }
+
+   line = Pair_compute_packed(options, &X, &Y, ws) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   return line ;
+}
+
+/* Pair_compute_packed : cf .h for specification 
+ */
+char *Pair_compute_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws)
+{
+   enum Engine engine = Pair_Engine( options, X->length, Y->length, options->nthreads ) ;
+   long res = Pair_Distance( options, engine, X, Y, options->nthreads, ws ) ;
+   char *line = (char *) malloc( 32 ) ;
+   if (line == NULL) { perror("Pair_compute_packed: malloc of line" ); exit(EXIT_FAILURE); }
+   if ((options->max_distance >= 0) && (res == DISTANCE_ABOVE_MAX)) snprintf(line, 32, "> %ld\n", options->max_distance ) ;
+   else snprintf(line, 32, "%ld\n", res ) ; 
+   return line ;
+}
@@ -0,0 +1,68 @@
+/**
+ * \file Pair.h
+ * \brief computation of the output for one pair of sequences, with the engine chosen by the options 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Used both for the pair given on the command line and for each pair of a batch.
+ */
+
+#ifndef __PAIR_h__
+#define __PAIR_h__
+
+#include "SequenceFile.h" 
+#include "Workspace.h" 
+#include "Packed.h" 
+#include "Engine.h" 
+
+/**
+ * \struct PairOptions 
+ * \brief what is computed for a pair, and with how many threads
+ */
+struct PairOptions 
+{  long max_distance ; /*!< bound on the distance if >= 0 (--max-distance), else -1 */
+   int align ;         /*!< prints an alignment if 1 (--align) */
+   int nthreads ;      /*!< number of threads for the computation of the pair */
+   enum Engine engine ; /*!< engine of the distance (--engine), ENGINE_AUTO to choose it by Engine_select */
+   size_t mem_limit ;  /*!< memory budget in bytes for the computation of the pair (--mem-limit), 0 if none */
+   int anchor ;        /*!< length of the seeds of the anchors if > 0 (--anchor, cf Anchored.h), else 0 */
+} ;
+
+/**
+ * \fn char *Pair_compute(const struct PairOptions *options, struct SequenceFile *file[2], char *seq[2], long length[2], struct Workspace *ws)
+ * \brief computes the output line for the sequences seq[i][0 .. length[i]-1] of file[i], i = 0..1
+ * \param options : the options of the computation 
+ * \param file : the files of the sequences (for the offsets and names of an alignment)
+ * \param seq, length : the sequences 
+ * \param ws : scratch buffers of the calling thread, reused by the linear space engines
+ * \return the output line (ended by '\\n'), allocated by malloc: 
+ *    the distance; or "> k" if it exceeds options->max_distance = k; 
+ *    or, if options->align, the record "file_1 begin end file_2 begin end distance CIGAR" separated by tabulations
+ *
+ * The two sequences are packed once (cf Packed_init), then given to the engine.
+ * Engine: EditDistance_Align if options->align, else options->engine, or if it is ENGINE_AUTO the fastest engine
+ * whose footprint fits in options->mem_limit (cf Engine_select). Exits if the engine does not fit.
+ * With options->anchor, the engine only computes the table if the anchors do not bound the distance (cf Anchored.h).
+ * In auto mode, the wavefronts (ENGINE_WFA) are tried first while the distance is small (cf Engine_wavefront_bound).
+ */
+char *Pair_compute(const struct PairOptions *options, struct SequenceFile *file[2], char *seq[2], long length[2], struct Workspace *ws) ;
+
+/**
+ * \fn char *Pair_compute_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws)
+ * \brief computes the output line of the distance between two sequences already packed (eg read from a pipe, cf SequenceStream.h)
+ * \return the output line (ended by '\\n'), allocated by malloc: the distance, or "> k" if it exceeds options->max_distance = k
+ *
+ * As Pair_compute without alignment: options->align is ignored (the offsets of the bases in the files are not known).
+ */
+char *Pair_compute_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws) ;
+
+/**
+ * \fn long Pair_distance_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws)
+ * \brief computes with one thread the distance between two sequences already packed (cf Packed_init)
+ * \return the distance, or DISTANCE_ABOVE_MAX if it exceeds options->max_distance >= 0 
+ *
+ * Engine: as Pair_compute with one thread; options->align and options->nthreads are ignored.
+ */
+long Pair_distance_packed(const struct PairOptions *options, const struct PackedSequence *X, const struct PackedSequence *Y, struct Workspace *ws) ;
+
+#endif /* __PAIR_h__ */
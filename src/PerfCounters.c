@@ -0,0 +1,150 @@
+/**
+ * \file PerfCounters.c
+ * \brief hardware counters of the engines, by phase, read by perf_event_open
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see PerfCounters.h
+ */
+
+#include "PerfCounters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for memset */
+#include <stdint.h>
+#include <unistd.h> /* for read, close and syscall */
+#include <sys/syscall.h> /* for SYS_perf_event_open */
+#include <linux/perf_event.h>
+
+int _perf_enabled = 0 ;
+
+/** \struct PerfEventSpec
+ * \brief name, type and config of an event for perf_event_open
+ */
+struct PerfEventSpec
+{  const char *name ;
+   uint32_t type ;
+   uint64_t config ;
+} ;
+
+/* cache event config: cache id | (operation << 8) | (result << 16) */
+#define PERF_CACHE(cache, op, result) ((cache) | ((op) << 8) | ((result) << 16))
+
+static const struct PerfEventSpec _events[PERF_EVENTS] =
+{  [PERF_CYCLES]       = { "cycles",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+   [PERF_INSTRUCTIONS] = { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+   [PERF_L1D_MISSES]   = { "L1D-misses",   PERF_TYPE_HW_CACHE,
+                           PERF_CACHE( PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS ) },
+   [PERF_LLC_MISSES]   = { "LLC-misses",   PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+   [PERF_DTLB_MISSES]  = { "dTLB-misses",  PERF_TYPE_HW_CACHE,
+                           PERF_CACHE( PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS ) },
+   [PERF_PAGE_FAULTS]  = { "page-faults",  PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+} ;
+
+static const char *_phase_names[PERF_PHASES] = { "alloc", "fill", "teardown" } ;
+
+static int _fd[PERF_EVENTS] ;                         /* -1 if the event is not available */
+static uint64_t _last[PERF_EVENTS] ;                  /* counts at the previous mark */
+static double _total[PERF_PHASES][PERF_EVENTS] ;      /* counts of each phase */
+static enum PerfPhase _phase = PERF_OUTSIDE ;         /* the current phase */
+static double _cells = 0 ;
+
+/* the count of the event e (including the threads created after the opening, inherit) */
+static uint64_t PerfCounters_Read(int e)
+{
+   uint64_t value = 0 ;
+   if (read( _fd[e], &value, sizeof(value) ) != (ssize_t) sizeof(value)) value = _last[e] ;
+   return value ;
+}
+
+int PerfCounters_open(void)
+{
+   int count = 0 ;
+   for (int e = 0; e < PERF_EVENTS; ++e)
+   {  struct perf_event_attr attr ;
+      memset( &attr, 0, sizeof(attr) ) ;
+      attr.size = sizeof(attr) ;
+      attr.type = _events[e].type ;
+      attr.config = _events[e].config ;
+      attr.inherit = 1 ;        /* and the threads created later (workers) */
+      attr.exclude_kernel = 1 ; /* allowed with perf_event_paranoid <= 2 */
+      attr.exclude_hv = 1 ;
+      _fd[e] = (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) ;
+      if (_fd[e] >= 0)
+      {  ++count ;
+         _last[e] = PerfCounters_Read( e ) ;
+      }
+   }
+   PerfCounters_reset() ;
+   _phase = PERF_OUTSIDE ;
+   _perf_enabled = 1 ;
+   return count ;
+}
+
+void PerfCounters_switch(enum PerfPhase phase)
+{
+   for (int e = 0; e < PERF_EVENTS; ++e)
+      if (_fd[e] >= 0)
+      {  uint64_t value = PerfCounters_Read( e ) ;
+         if (_phase != PERF_OUTSIDE) _total[_phase][e] += (double) (value - _last[e]) ;
+         _last[e] = value ;
+      }
+   _phase = phase ;
+}
+
+void PerfCounters_cells(double cells)
+{
+   _cells += cells ;
+}
+
+void PerfCounters_reset(void)
+{
+   memset( _total, 0, sizeof(_total) ) ;
+   _cells = 0 ;
+}
+
+double PerfCounters_total(enum PerfPhase phase, enum PerfEvent event)
+{
+   if (! _perf_enabled || (_fd[event] < 0)) return -1 ;
+   if (phase != PERF_PHASES) return _total[phase][event] ;
+   double total = 0 ;
+   for (int p = 0; p < PERF_PHASES; ++p) total += _total[p][event] ;
+   return total ;
+}
+
+double PerfCounters_cell_count(void)
+{
+   return _cells ;
+}
+
+const char *PerfCounters_name(enum PerfEvent event)
+{
+   return _events[event].name ;
+}
+
+void PerfCounters_report(FILE *f)
+{
+   fprintf( f, "Counters of the engines (%.0f cells): count, and count per cell in parentheses\n%-9s", _cells, "phase" ) ;
+   for (int e = 0; e < PERF_EVENTS; ++e) fprintf( f, " %24s", _events[e].name ) ;
+   fprintf( f, "\n" ) ;
+   for (int p = 0; p <= PERF_PHASES; ++p)
+   {  fprintf( f, "%-9s", (p == PERF_PHASES) ? "total" : _phase_names[p] ) ;
+      for (int e = 0; e < PERF_EVENTS; ++e)
+      {  double count = PerfCounters_total( p, e ) ;
+         if (count < 0) fprintf( f, " %24s", "n/a" ) ;
+         else fprintf( f, " %14.0f (%7.3f)", count, (_cells > 0) ? count / _cells : 0 ) ;
+      }
+      fprintf( f, "\n" ) ;
+   }
+}
+
+void PerfCounters_close(void)
+{
+   for (int e = 0; e < PERF_EVENTS; ++e)
+      if (_fd[e] >= 0)
+      {  close( _fd[e] ) ;
+         _fd[e] = -1 ;
+      }
+   _perf_enabled = 0 ;
+}
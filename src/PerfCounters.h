@@ -0,0 +1,116 @@
+/**
+ * \file PerfCounters.h
+ * \brief hardware counters (cycles, instructions, cache and TLB misses) of the engines, by phase, read by perf_event_open
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The engines mark their phases: allocation and initialization of their arrays (PERF_ALLOC), computation of the
+ * table (PERF_FILL), deallocation (PERF_TEARDOWN); Engine_distance marks the entry and the exit of an engine.
+ * When the counters are open (PerfCounters_open, eg distanceEdition --counters), the counts of the process
+ * between two marks are added to the totals of the phase; else a mark is only a test of a global flag.
+ * The counters are those of the process: of the calling thread and of the threads created after PerfCounters_open
+ * (eg the workers of EditDistance_CA_Par). The phases are marked by one thread at a time (not in batch or matrix mode).
+ */
+
+#ifndef __PERF_COUNTERS_h__
+#define __PERF_COUNTERS_h__
+
+#include <stdio.h> /* for FILE */
+
+/**
+ * \enum PerfPhase
+ * \brief the phases of an engine
+ */
+enum PerfPhase
+{  PERF_ALLOC = 0,  /*!< allocation and initialization of the arrays */
+   PERF_FILL,       /*!< computation of the table */
+   PERF_TEARDOWN,   /*!< deallocation */
+   PERF_PHASES,     /*!< number of phases */
+   PERF_OUTSIDE = PERF_PHASES /*!< outside of the engines: not counted */
+} ;
+
+/**
+ * \enum PerfEvent
+ * \brief the events counted
+ */
+enum PerfEvent
+{  PERF_CYCLES = 0,     /*!< cpu cycles */
+   PERF_INSTRUCTIONS,   /*!< instructions retired */
+   PERF_L1D_MISSES,     /*!< L1 data cache read misses */
+   PERF_LLC_MISSES,     /*!< last level cache misses */
+   PERF_DTLB_MISSES,    /*!< data TLB read misses */
+   PERF_PAGE_FAULTS,    /*!< page faults (a software event, available without hardware counters) */
+   PERF_EVENTS          /*!< number of events */
+} ;
+
+/** \var int _perf_enabled
+ * \brief 1 iff the counters are open
+ */
+extern int _perf_enabled ;
+
+/**
+ * \fn int PerfCounters_open(void)
+ * \brief opens the counters of the events for the process, and enables the marks of the phases
+ * \return the number of events that can be counted (0 if perf_event_open is not allowed, eg /proc/sys/kernel/perf_event_paranoid);
+ * the events that cannot be counted are reported as not available
+ */
+int PerfCounters_open(void) ;
+
+/**
+ * \fn void PerfCounters_switch(enum PerfPhase phase)
+ * \brief adds the counts since the previous mark to the totals of the previous phase; phase is the next one
+ */
+void PerfCounters_switch(enum PerfPhase phase) ;
+
+/**
+ * \fn static inline void PerfCounters_phase(enum PerfPhase phase)
+ * \brief marks the beginning of phase (PERF_OUTSIDE: the end of an engine); nothing but a test if the counters are not open
+ */
+static inline void PerfCounters_phase(enum PerfPhase phase)
+{
+   if (_perf_enabled) PerfCounters_switch( phase ) ;
+}
+
+/**
+ * \fn void PerfCounters_cells(double cells)
+ * \brief adds cells to the number of cells of the tables computed, by which the counts are normalized
+ */
+void PerfCounters_cells(double cells) ;
+
+/**
+ * \fn void PerfCounters_reset(void)
+ * \brief sets the totals and the number of cells to 0 (eg before a run)
+ */
+void PerfCounters_reset(void) ;
+
+/**
+ * \fn double PerfCounters_total(enum PerfPhase phase, enum PerfEvent event)
+ * \brief the count of event during phase (PERF_PHASES: during all the phases) since the last reset, -1 if event is not available
+ */
+double PerfCounters_total(enum PerfPhase phase, enum PerfEvent event) ;
+
+/**
+ * \fn double PerfCounters_cell_count(void)
+ * \brief the number of cells since the last reset
+ */
+double PerfCounters_cell_count(void) ;
+
+/**
+ * \fn const char *PerfCounters_name(enum PerfEvent event)
+ * \brief the name of event (eg "cycles", "L1D-misses")
+ */
+const char *PerfCounters_name(enum PerfEvent event) ;
+
+/**
+ * \fn void PerfCounters_report(FILE *f)
+ * \brief prints on f the counts of each phase and their total, and the counts per cell
+ */
+void PerfCounters_report(FILE *f) ;
+
+/**
+ * \fn void PerfCounters_close(void)
+ * \brief closes the counters and disables the marks
+ */
+void PerfCounters_close(void) ;
+
+#endif /* __PERF_COUNTERS_h__ */
@@ -0,0 +1,208 @@
+/**
+ * \file Progress.c
+ * \brief progress of the computation of a distance (percent of the cells, GCUPS, ETA), reported by a thread
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Progress.h
+ */
+
+#include "Progress.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <err.h>
+#include <string.h> /* for strncpy */
+#include <time.h> /* for clock_gettime */
+#include <pthread.h>
+#include <sys/mman.h> /* for mmap */
+
+int _progress_enabled = 0 ;
+_Thread_local struct ProgressSlot *_progress_slot = NULL ;
+
+/**
+ * \struct ProgressSlots
+ * \brief the slots, in a mapping shared with the processes forked once the progress is open (eg the workers of
+ * EditDistance_Striped), whose counts are then seen by the reporter
+ */
+static struct ProgressSlots
+{  struct ProgressSlot slot[PROGRESS_SLOTS] ;
+   atomic_int registered ; /*!< slots given to the threads */
+} *_shared = NULL ;
+
+/**
+ * \struct ProgressReporter
+ * \brief the reporter thread and the state of its reports
+ */
+static struct ProgressReporter
+{  double interval ;        /*!< seconds between two reports */
+   char *path ;             /*!< the metrics file, NULL for stderr */
+   char *tmp ;              /*!< path.tmp, written then renamed to path */
+   char engine[16] ;        /*!< name of the engine */
+   double total ;           /*!< cells of the engine */
+   double start ;           /*!< time of Progress_start (s, CLOCK_MONOTONIC) */
+   double last_time ;       /*!< time of the previous report */
+   double last_cells ;      /*!< cells at the previous report */
+   int stop ;               /*!< 1 when the reporter must stop */
+   int running ;            /*!< 1 between Progress_start and Progress_finish */
+   pthread_mutex_t lock ;   /*!< protects stop */
+   pthread_cond_t cond ;    /*!< signals stop to the reporter */
+   pthread_t thread ;       /*!< the reporter thread */
+} _reporter = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER } ;
+
+/* Progress_register : cf .h for specification
+ */
+struct ProgressSlot *Progress_register(void)
+{
+   int k = atomic_fetch_add( &_shared->registered, 1 ) ;
+   _progress_slot = &_shared->slot[(k < PROGRESS_SLOTS - 1) ? k : PROGRESS_SLOTS - 1] ;
+   return _progress_slot ;
+}
+
+/* seconds of the clock clock */
+static double Progress_Now(clockid_t clock)
+{
+   struct timespec t ;
+   clock_gettime( clock, &t ) ;
+   return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec ;
+}
+
+/* the cells computed by all the threads */
+static double Progress_Cells(void)
+{
+   double cells = 0 ;
+   for (int k = 0; k < PROGRESS_SLOTS; ++k) cells += (double) atomic_load_explicit( &_shared->slot[k].cells, memory_order_relaxed ) ;
+   return cells ;
+}
+
+/* writes one metric of the text format of Prometheus, with its help and type */
+static void Progress_Metric(FILE *f, const char *name, const char *type, const char *help, double value)
+{
+   fprintf( f, "# HELP distance_edition_%s %s\n# TYPE distance_edition_%s %s\n", name, help, name, type ) ;
+   fprintf( f, "distance_edition_%s{engine=\"%s\"} %.17g\n", name, _reporter.engine, value ) ;
+}
+
+/* reports the progress now: on stderr or in the metrics file (the last report if done) */
+static void Progress_Report(int done)
+{
+   struct ProgressReporter *r = &_reporter ;
+   double now = Progress_Now( CLOCK_MONOTONIC ) ;
+   double cells = Progress_Cells() ;
+   double elapsed = now - r->start ;
+   double dt = now - r->last_time ;
+   double rate = (dt > 0) ? (cells - r->last_cells) / dt : 0 ; /* cells per second in the last interval */
+   if ((done || (rate <= 0)) && (elapsed > 0)) rate = cells / elapsed ; /* the average of the run in the last report */
+   double ratio = (done || (r->total <= 0)) ? 1 : cells / r->total ; /* banded: may stop before its total */
+   if (ratio > 1) ratio = 1 ;
+   double eta = done ? 0 : (rate > 0) ? ((r->total > cells) ? r->total - cells : 0) / rate : -1 ; /* -1: unknown */
+   r->last_time = now ;
+   r->last_cells = cells ;
+
+   if (r->path == NULL)
+   {  fprintf( stderr, "progress engine=%s cells=%.0f total=%.0f percent=%.2f gcups=%.3f eta_s=%.1f elapsed_s=%.1f\n",
+               r->engine, cells, r->total, 100 * ratio, rate * 1e-9, eta, elapsed ) ;
+      return ;
+   }
+   FILE *f = fopen( r->tmp, "w" ) ;
+   if (f == NULL) { warn("progress %s", r->tmp) ; return ; }
+   Progress_Metric( f, "cells_done", "counter", "cells of the table computed", cells ) ;
+   Progress_Metric( f, "cells_total", "gauge", "cells of the table of the engine", r->total ) ;
+   Progress_Metric( f, "progress_ratio", "gauge", "fraction of the cells computed", ratio ) ;
+   Progress_Metric( f, "gcups", "gauge", "10^9 cells per second in the last interval", rate * 1e-9 ) ;
+   Progress_Metric( f, "eta_seconds", "gauge", "estimated seconds to completion, -1 if unknown", eta ) ;
+   Progress_Metric( f, "elapsed_seconds", "gauge", "seconds since the start of the engine", elapsed ) ;
+   Progress_Metric( f, "done", "gauge", "1 once the distance is computed", done ) ;
+   if ((fclose( f ) != 0) || (rename( r->tmp, r->path ) != 0)) warn("progress %s", r->path) ;
+}
+
+/* the reporter thread: a report every interval seconds until Progress_finish */
+static void *Progress_Reporter(void *arg)
+{
+   struct ProgressReporter *r = (struct ProgressReporter *) arg ;
+   pthread_mutex_lock( &r->lock ) ;
+   while (! r->stop)
+   {  double t = Progress_Now( CLOCK_REALTIME ) + r->interval ;
+      struct timespec deadline = { (time_t) t, (long) ((t - (double) (time_t) t) * 1e9) } ;
+      while (! r->stop)
+         if (pthread_cond_timedwait( &r->cond, &r->lock, &deadline ) == ETIMEDOUT)
+         {  Progress_Report( 0 ) ;
+            break ;
+         }
+   }
+   pthread_mutex_unlock( &r->lock ) ;
+   return NULL ;
+}
+
+/* Progress_open : cf .h for specification
+ */
+void Progress_open(double interval, const char *path)
+{
+   _reporter.interval = interval ;
+   if (_shared == NULL) /* kept until the exit: the threads may keep their slot */
+   {  _shared = (struct ProgressSlots *) mmap( NULL, sizeof(struct ProgressSlots), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 ) ;
+      if (_shared == MAP_FAILED) { perror("Progress_open: mmap"); exit(EXIT_FAILURE); }
+   }
+   if (path != NULL)
+   {  size_t size = strlen( path ) + 5 ;
+      _reporter.path = strdup( path ) ;
+      _reporter.tmp = (char *) malloc( size ) ;
+      if ((_reporter.path == NULL) || (_reporter.tmp == NULL)) { perror("Progress_open: malloc"); exit(EXIT_FAILURE); }
+      snprintf( _reporter.tmp, size, "%s.tmp", path ) ;
+   }
+   _progress_enabled = 1 ;
+}
+
+/* Progress_start : cf .h for specification
+ */
+void Progress_start(const char *engine, double total)
+{
+   if (! _progress_enabled) return ;
+   struct ProgressReporter *r = &_reporter ;
+   for (int k = 0; k < PROGRESS_SLOTS; ++k)
+   {  atomic_store( &_shared->slot[k].cells, 0 ) ;
+      _shared->slot[k].shared = (k == PROGRESS_SLOTS - 1) ;
+   }
+   memset( r->engine, 0, sizeof(r->engine) ) ;
+   strncpy( r->engine, engine, sizeof(r->engine) - 1 ) ;
+   r->total = total ;
+   r->start = r->last_time = Progress_Now( CLOCK_MONOTONIC ) ;
+   r->last_cells = 0 ;
+   r->stop = 0 ;
+   if (pthread_create( &r->thread, NULL, Progress_Reporter, r ) != 0) { perror("Progress_start: pthread_create"); exit(EXIT_FAILURE); }
+   r->running = 1 ;
+}
+
+/* Progress_stop : cf .h for specification
+ */
+void Progress_stop(void)
+{
+   struct ProgressReporter *r = &_reporter ;
+   if (! r->running) return ;
+   pthread_mutex_lock( &r->lock ) ;
+   r->stop = 1 ;
+   pthread_cond_signal( &r->cond ) ;
+   pthread_mutex_unlock( &r->lock ) ;
+   pthread_join( r->thread, NULL ) ;
+   r->running = 0 ;
+}
+
+/* Progress_finish : cf .h for specification
+ */
+void Progress_finish(void)
+{
+   if (! _reporter.running) return ;
+   Progress_stop() ;
+   Progress_Report( 1 ) ;
+}
+
+/* Progress_close : cf .h for specification
+ */
+void Progress_close(void)
+{
+   Progress_finish() ;
+   _progress_enabled = 0 ;
+   free( _reporter.path ) ;
+   free( _reporter.tmp ) ;
+   _reporter.path = _reporter.tmp = NULL ;
+}
@@ -0,0 +1,104 @@
+/**
+ * \file Progress.h
+ * \brief progress of the computation of a distance (percent of the cells, GCUPS, ETA), reported by a thread
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The engines count the cells of their table as they compute them (Progress_cells, once per row, anti-diagonal,
+ * strip row, block or tile). Each thread counts in a slot of its own, on its own cache line: the count is a
+ * load and a store of the slot, without locked instruction nor sharing of the line between the threads.
+ * When the progress is open (Progress_open, eg distanceEdition --progress), Engine_distance starts a reporter
+ * thread that sums the slots every interval seconds and reports the cells computed, the percent of the cells
+ * of the engine, the GCUPS (10^9 cells per second) of the last interval and the estimated time to completion,
+ * either as a line key=value on stderr:
+ *    progress engine=ls cells=123456789 total=874734528 percent=14.11 gcups=0.412 eta_s=1822.4 elapsed_s=300.2
+ * or in a metrics file in the text format of Prometheus, rewritten at each report (file.tmp renamed to file).
+ * A last report (percent=100, the GCUPS of the whole run) is made when the distance is computed. Else a count is only a test of a global flag.
+ * The engine rec (recursion with memoization) counts its cells only when it returns.
+ * The slots are in a shared mapping: a process forked once the progress is open (the workers of EditDistance_Striped)
+ * counts in the slots of the reporter, after a Progress_register of its own.
+ */
+
+#ifndef __PROGRESS_h__
+#define __PROGRESS_h__
+
+#include <stddef.h> /* for NULL */
+#include <stdint.h>
+#include <stdatomic.h>
+
+/** \def PROGRESS_SLOTS
+ * \brief number of slots of the counts: the threads beyond PROGRESS_SLOTS-1 share the last one (by atomic additions)
+ */
+#define PROGRESS_SLOTS 128
+
+/**
+ * \struct ProgressSlot
+ * \brief the cells computed by one thread, on a cache line of its own
+ */
+struct ProgressSlot
+{  _Alignas(64) _Atomic uint64_t cells ; /*!< cells computed, written by the thread of the slot only (unless shared) */
+   int shared ;                           /*!< 1 for the last slot, shared by the threads beyond */
+} ;
+
+/** \var int _progress_enabled
+ * \brief 1 iff the progress is open
+ */
+extern int _progress_enabled ;
+
+/** \var _progress_slot
+ * \brief the slot of the calling thread, NULL until its first count
+ */
+extern _Thread_local struct ProgressSlot *_progress_slot ;
+
+/**
+ * \fn struct ProgressSlot *Progress_register(void)
+ * \brief gives the next slot to the calling thread, at its first count, or to a process just forked (which would else
+ * share the slot of the thread that forked it)
+ */
+struct ProgressSlot *Progress_register(void) ;
+
+/**
+ * \fn static inline void Progress_cells(uint64_t cells)
+ * \brief adds cells to the cells computed by the calling thread; nothing but a test if the progress is not open
+ */
+static inline void Progress_cells(uint64_t cells)
+{
+   if (_progress_enabled)
+   {  struct ProgressSlot *s = (_progress_slot != NULL) ? _progress_slot : Progress_register() ;
+      if (s->shared) atomic_fetch_add_explicit( &s->cells, cells, memory_order_relaxed ) ;
+      else atomic_store_explicit( &s->cells, atomic_load_explicit( &s->cells, memory_order_relaxed ) + cells, memory_order_relaxed ) ;
+   }
+}
+
+/**
+ * \fn void Progress_open(double interval, const char *path)
+ * \brief enables the counts and the reports every interval seconds, on stderr if path is NULL, else in the metrics file path
+ */
+void Progress_open(double interval, const char *path) ;
+
+/**
+ * \fn void Progress_start(const char *engine, double total)
+ * \brief resets the counts and starts the reporter thread for engine, which computes about total cells; nothing if the progress is not open
+ */
+void Progress_start(const char *engine, double total) ;
+
+/**
+ * \fn void Progress_finish(void)
+ * \brief stops the reporter thread after a last report: the distance is computed
+ */
+void Progress_finish(void) ;
+
+/**
+ * \fn void Progress_stop(void)
+ * \brief stops the reporter thread without a last report: the run gave up (eg the wavefronts tried first by the auto
+ * mode, above their bound), the engine started next reports the distance
+ */
+void Progress_stop(void) ;
+
+/**
+ * \fn void Progress_close(void)
+ * \brief disables the counts and the reports
+ */
+void Progress_close(void) ;
+
+#endif /* __PROGRESS_h__ */
@@ -0,0 +1,170 @@
+/**
+ * \file Scoring.c
+ * \brief costs of the operations chosen at run time: a substitution matrix over the bases and the cost of an indel
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Scoring.h
+ */
+
+#include "Scoring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <err.h>
+#include <string.h> /* for strcmp and strchr */
+
+/* row of the substitutions of the known base b in the default scoring */
+#define SCORING_ROW(b) { SUBSTITUTION_COST, \
+   ((b) == ADENINE) ? 0 : SUBSTITUTION_COST, ((b) == CYTOSINE) ? 0 : SUBSTITUTION_COST, ((b) == GUANINE) ? 0 : SUBSTITUTION_COST, \
+   ((b) == THYMINE) ? 0 : SUBSTITUTION_COST, ((b) == URACILE) ? 0 : SUBSTITUTION_COST, SUBSTITUTION_COST }
+
+/* the unknown row is all SUBSTITUTION_UNKNOWN_COST */
+#define SCORING_UNKNOWN_ROW { SUBSTITUTION_UNKNOWN_COST, SUBSTITUTION_UNKNOWN_COST, SUBSTITUTION_UNKNOWN_COST, \
+   SUBSTITUTION_UNKNOWN_COST, SUBSTITUTION_UNKNOWN_COST, SUBSTITUTION_UNKNOWN_COST, SUBSTITUTION_UNKNOWN_COST }
+
+struct Scoring _scoring =
+{  { SCORING_ROW( SKIP_BASE ), SCORING_ROW( ADENINE ), SCORING_ROW( CYTOSINE ), SCORING_ROW( GUANINE ),
+     SCORING_ROW( THYMINE ), SCORING_ROW( URACILE ), SCORING_UNKNOWN_ROW },
+   INSERTION_COST,
+   0,
+   SCORING_DEFAULT
+} ;
+
+/* largest cost accepted: the distances of sequences of 2^40 bases hold in a long */
+#define SCORING_MAX_COST 1000000L
+
+/* the bases in the order of the columns of a scoring file */
+static const char _bases[] = "ACGTUN" ;
+
+void Scoring_default(struct Scoring *scoring)
+{
+   for (int x = SKIP_BASE; x <= UNKOWN_BASE; ++x)
+      for (int y = SKIP_BASE; y <= UNKOWN_BASE; ++y)
+         scoring->sub[x][y] = (x == UNKOWN_BASE) ? SUBSTITUTION_UNKNOWN_COST : ( (x == y) ? 0 : SUBSTITUTION_COST ) ;
+   scoring->indel = INSERTION_COST ;
+   scoring->gap_open = 0 ;
+   scoring->model = SCORING_DEFAULT ;
+}
+
+/* 1 if x and y are a transition: two purines (A, G) or two pyrimidines (C, T, U) that differ */
+static int Scoring_Transition(int x, int y)
+{
+   int purine_x = (x == ADENINE) || (x == GUANINE) ;
+   int purine_y = (y == ADENINE) || (y == GUANINE) ;
+   return (x != y) && (x != UNKOWN_BASE) && (y != UNKOWN_BASE) && (purine_x == purine_y)
+          && ! (((x == THYMINE) && (y == URACILE)) || ((x == URACILE) && (y == THYMINE))) ;
+}
+
+/* sets the costs of the substitutions between the known bases (sub), those with N (unknown) and the transitions
+ * (transition), the ones given as negative being unchanged */
+static void Scoring_Costs(struct Scoring *scoring, long sub, long unknown, long transition)
+{
+   for (int x = ADENINE; x <= UNKOWN_BASE; ++x)
+      for (int y = ADENINE; y <= UNKOWN_BASE; ++y)
+      {  long *cost = &scoring->sub[x][y] ;
+         if ((x == UNKOWN_BASE) || (y == UNKOWN_BASE)) { if (unknown >= 0) *cost = unknown ; }
+         else if (Scoring_Transition( x, y )) { if (transition >= 0) *cost = transition ; else if (sub >= 0) *cost = sub ; }
+         else if (x != y) { if (sub >= 0) *cost = sub ; }
+      }
+}
+
+/* the base of the char c among "ACGTUN" (upper or lower case), or SKIP_BASE */
+static int Scoring_Base(char c)
+{
+   const char *p = (c == '\0') ? NULL : strchr( _bases, (c >= 'a') && (c <= 'z') ? c - 'a' + 'A' : c ) ;
+   return (p == NULL) ? SKIP_BASE : ADENINE + (int) (p - _bases) ;
+}
+
+/* reads the scoring file path in scoring (changes of its costs); exits on error */
+static void Scoring_Load(const char *path, struct Scoring *scoring)
+{
+   FILE *f = fopen( path, "r" ) ;
+   if (f == NULL) err(1, "scoring %s", path) ;
+   char line[512] ;
+   int number = 0 ;
+   while (fgets( line, sizeof(line), f ) != NULL)
+   {  ++number ;
+      char key[16] ;
+      long cost[UNKOWN_BASE] ;
+      int base ;
+      if ((line[0] == '#') || (sscanf( line, "%15s", key ) != 1)) continue ; /* comment or empty line */
+      if (strcmp( key, "indel" ) == 0)
+      {  if (sscanf( line, "%*s %ld", &scoring->indel ) != 1) errx(1, "%s:%d: invalid indel cost", path, number) ;
+      }
+      else if (strcmp( key, "open" ) == 0)
+      {  if (sscanf( line, "%*s %ld", &scoring->gap_open ) != 1) errx(1, "%s:%d: invalid gap open cost", path, number) ;
+      }
+      else if ((key[1] == '\0') && ((base = Scoring_Base( key[0] )) != SKIP_BASE))
+      {  if (sscanf( line, "%*s %ld %ld %ld %ld %ld %ld", &cost[0], &cost[1], &cost[2], &cost[3], &cost[4], &cost[5] ) != 6)
+            errx(1, "%s:%d: 6 costs expected (substitutions of %c by %s)", path, number, key[0], _bases) ;
+         for (int y = ADENINE; y <= UNKOWN_BASE; ++y) scoring->sub[base][y] = cost[y - ADENINE] ;
+      }
+      else errx(1, "%s:%d: invalid line (indel k, open k, or a base of %s and its 6 costs)", path, number, _bases) ;
+   }
+   fclose( f ) ;
+}
+
+void Scoring_parse(const char *spec, struct Scoring *scoring)
+{
+   Scoring_default( scoring ) ;
+   if (strcmp( spec, "default" ) == 0) return ;
+   if (strcmp( spec, "unit" ) == 0)
+   {  Scoring_Costs( scoring, 1, 1, -1 ) ;
+      scoring->indel = 1 ;
+   }
+   else if (strcmp( spec, "transition" ) == 0)
+   {  Scoring_Costs( scoring, 2, 1, 1 ) ;
+      scoring->sub[THYMINE][URACILE] = scoring->sub[URACILE][THYMINE] = 0 ;
+      scoring->indel = 2 ;
+   }
+   else if ((strchr( spec, '=' ) != NULL) && (strchr( spec, '/' ) == NULL))
+   {  long sub = -1, unknown = -1, transition = -1 ;
+      const char *p = spec ;
+      while (*p != '\0')
+      {  char key[16] ;
+         long value ;
+         int length = 0 ;
+         if ((sscanf( p, "%15[a-z]=%ld%n", key, &value, &length ) != 2) || ((p[length] != ',') && (p[length] != '\0')))
+            errx(1, "invalid scoring: %s (key=value,...)", spec) ;
+         if (strcmp( key, "sub" ) == 0) sub = value ;
+         else if (strcmp( key, "unknown" ) == 0) unknown = value ;
+         else if (strcmp( key, "transition" ) == 0) transition = value ;
+         else if (strcmp( key, "indel" ) == 0) scoring->indel = value ;
+         else if (strcmp( key, "open" ) == 0) scoring->gap_open = value ;
+         else errx(1, "invalid scoring key: %s (sub, unknown, transition, indel or open)", key) ;
+         if ((value < 0) && (strcmp( key, "indel" ) != 0)) errx(1, "invalid scoring: negative cost %s=%ld", key, value) ;
+         p += length + (p[length] == ',') ;
+      }
+      Scoring_Costs( scoring, sub, unknown, transition ) ;
+   }
+   else Scoring_Load( spec, scoring ) ;
+
+   if ((scoring->indel < 1) || (scoring->indel > SCORING_MAX_COST))
+      errx(1, "invalid scoring %s: the indel cost must be in 1..%ld", spec, SCORING_MAX_COST) ;
+   if ((scoring->gap_open < 0) || (scoring->gap_open > SCORING_MAX_COST))
+      errx(1, "invalid scoring %s: the gap open cost must be in 0..%ld", spec, SCORING_MAX_COST) ;
+   for (int x = ADENINE; x <= UNKOWN_BASE; ++x)
+      for (int y = ADENINE; y <= UNKOWN_BASE; ++y)
+      {  if ((scoring->sub[x][y] < 0) || (scoring->sub[x][y] > SCORING_MAX_COST))
+            errx(1, "invalid scoring %s: the cost %c-%c must be in 0..%ld", spec, _bases[x - ADENINE], _bases[y - ADENINE], SCORING_MAX_COST) ;
+         if (scoring->sub[x][y] != scoring->sub[y][x])
+            errx(1, "invalid scoring %s: the cost %c-%c differs from %c-%c (the matrix must be symmetric)",
+                 spec, _bases[x - ADENINE], _bases[y - ADENINE], _bases[y - ADENINE], _bases[x - ADENINE]) ;
+      }
+}
+
+void Scoring_set(const struct Scoring *scoring)
+{
+   struct Scoring reference ;
+   Scoring_default( &reference ) ;
+   int is_default = (scoring->indel == reference.indel) && (scoring->gap_open == 0) ;
+   int is_unit = (scoring->indel == 1) && (scoring->gap_open == 0) ;
+   for (int x = ADENINE; x <= UNKOWN_BASE; ++x)
+      for (int y = ADENINE; y <= UNKOWN_BASE; ++y)
+      {  is_default &= (scoring->sub[x][y] == reference.sub[x][y]) ;
+         is_unit &= (scoring->sub[x][y] == ((x == UNKOWN_BASE) || (x != y))) ;
+      }
+   _scoring = *scoring ;
+   _scoring.model = is_default ? SCORING_DEFAULT : is_unit ? SCORING_UNIT : SCORING_MATRIX ;
+}
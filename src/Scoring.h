@@ -0,0 +1,107 @@
+/**
+ * \file Scoring.h
+ * \brief costs of the operations chosen at run time: a substitution matrix over the bases and the cost of an indel
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The costs of Globals.h are decided at compilation; a scoring replaces them at run time (distanceEdition --scoring):
+ * the cost sub[x][y] of the substitution of each base x of the first sequence by each base y of the second one
+ * (A, C, G, T, U and N, eg transitions cheaper than transversions), the cost indel of an insertion or deletion and,
+ * for affine gaps, the cost gap_open of the opening of a gap: a gap of k bases then costs gap_open + k indel.
+ * The engines read the scoring in _scoring, whose model selects their kernel:
+ *   - SCORING_DEFAULT: the costs of Globals.h, constants in all the kernels (all the engines);
+ *   - SCORING_UNIT: all the operations cost 1, N matching nothing (Levenshtein): constants in the kernels of the
+ *     linear space and banded engines, and the bit-parallel engine;
+ *   - SCORING_MATRIX: any other costs, read in the matrix by the kernels of the linear space and banded engines.
+ * Only the affine gap engine (cf AffineGap.h) computes the distance with affine gaps (gap_open > 0).
+ * The kernels are written once with Scoring_indel and Scoring_cost on a model given as a constant: as for the width
+ * of the cells (cf CellWidth.h), the compiler makes one copy per model, without any test per cell.
+ *
+ * The engines swap the sequences (the longest one is on the rows): a matrix must be symmetric.
+ */
+
+#ifndef __SCORING_h__
+#define __SCORING_h__
+
+#include "Globals.h" /* the default costs */
+#include "characters_to_base.h" /* enum Base */
+
+/**
+ * \enum ScoringModel
+ * \brief the kernels allowed by a scoring (cf Scoring_set)
+ */
+enum ScoringModel
+{  SCORING_DEFAULT = 0, /*!< the costs of Globals.h */
+   SCORING_UNIT,        /*!< all the costs 1, N matching nothing (other than SCORING_DEFAULT) */
+   SCORING_MATRIX       /*!< any other costs */
+} ;
+
+/**
+ * \struct Scoring
+ * \brief costs of the operations, indexed by enum Base (SKIP_BASE: unused)
+ */
+struct Scoring
+{  long sub[UNKOWN_BASE + 1][UNKOWN_BASE + 1] ; /*!< sub[x][y]: cost of the substitution of x by y, >= 0 */
+   long indel ;                                 /*!< cost of an insertion or a deletion, >= 1 */
+   long gap_open ;                              /*!< cost of the opening of a gap, >= 0 (0: linear gaps) */
+   enum ScoringModel model ;                    /*!< set by Scoring_set */
+} ;
+
+/**
+ * \var _scoring
+ * \brief the scoring of the engines (by default the costs of Globals.h); must not be changed while an engine runs
+ */
+extern struct Scoring _scoring ;
+
+/**
+ * \fn void Scoring_default(struct Scoring *scoring)
+ * \brief the costs of Globals.h: SUBSTITUTION_UNKNOWN_COST for N, 0 between equal bases, else SUBSTITUTION_COST,
+ * linear gaps
+ */
+void Scoring_default(struct Scoring *scoring) ;
+
+/**
+ * \fn void Scoring_parse(const char *spec, struct Scoring *scoring)
+ * \brief the scoring given by spec, exits if it is invalid:
+ *   - "default": the costs of Globals.h;
+ *   - "unit": all the costs 1 (Levenshtein distance);
+ *   - "transition": transitions (A-G, C-T, C-U) 1, transversions 2, T-U 0, N 1, indel 2;
+ *   - a list key=value,... of changes of the default costs, with the keys sub (substitution of two known bases),
+ *     unknown (substitution of N, or by N), indel, open (opening of a gap) and transition (substitution A-G, C-T or C-U),
+ *     eg "indel=3,transition=1" or "open=4,indel=1";
+ *   - else a file of lines "indel k", "open k" and "x c_A c_C c_G c_T c_U c_N" (the costs of the substitutions of the base
+ *     x, one of ACGTUN, by each base), changes of the default costs; the lines starting by '#' are comments.
+ */
+void Scoring_parse(const char *spec, struct Scoring *scoring) ;
+
+/**
+ * \fn void Scoring_set(const struct Scoring *scoring)
+ * \brief sets _scoring to scoring and its model: SCORING_DEFAULT if it has the costs of Globals.h,
+ * SCORING_UNIT if all its costs are 1 (with linear gaps for both), else SCORING_MATRIX
+ */
+void Scoring_set(const struct Scoring *scoring) ;
+
+/**
+ * \fn static inline long Scoring_indel(const struct Scoring *scoring, enum ScoringModel model)
+ * \brief the cost of an indel of scoring, of model model (a constant in a kernel)
+ */
+static inline long Scoring_indel(const struct Scoring *scoring, enum ScoringModel model)
+{
+   return (model == SCORING_DEFAULT) ? INSERTION_COST : (model == SCORING_UNIT) ? 1 : scoring->indel ;
+}
+
+/**
+ * \fn static inline long Scoring_cost(const long *sub_x, enum ScoringModel model, enum Base x, enum Base y)
+ * \brief the cost of the substitution of x by y, sub_x being the row x of the matrix of a scoring of model model
+ * (a constant in a kernel; the row is only read for SCORING_MATRIX)
+ */
+static inline long Scoring_cost(const long *sub_x, enum ScoringModel model, enum Base x, enum Base y)
+{
+   if (model == SCORING_DEFAULT)
+      return (x == UNKOWN_BASE) ? SUBSTITUTION_UNKNOWN_COST : ( (x == y) ? 0 : SUBSTITUTION_COST ) ;
+   if (model == SCORING_UNIT)
+      return (x == UNKOWN_BASE) | (x != y) ;
+   return sub_x[y] ;
+}
+
+#endif /* __SCORING_h__ */
@@ -0,0 +1,159 @@
+/**
+ * \file SequenceFile.c
+ * \brief files of genetic sequences mapped in virtual memory
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see SequenceFile.h
+ */
+
+#include "SequenceFile.h"
+#include "FastaIndex.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <err.h> 
+#include <string.h> /* for memchr */
+#include <ctype.h> /* for isspace */
+#include <fcntl.h> /* for open */
+#include <unistd.h> /* for close and dup */
+#include <sys/mman.h> /* for mmap and munmap */
+#include <sys/stat.h> /* for file length */
+
+/* list of the files mapped */
+static struct SequenceFile *_opened_files = NULL ;
+
+struct SequenceFile *SequenceFile_open(const char *name)
+{
+   for (struct SequenceFile *f = _opened_files; f != NULL; f = f->next) /* same pathname */
+      if (strcmp( f->name, name ) == 0) return f ;
+
+   int fd = (strcmp( name, "-" ) == 0) ? dup( 0 ) : open(name, O_RDONLY); /* stdin redirected from a regular file */
+   if (fd == -1) err(1,"open %s", name);
+   struct stat s;
+   if (fstat(fd, &s) == -1) err(1, "fstat") ;
+   for (struct SequenceFile *f = _opened_files; f != NULL; f = f->next) /* same file under another pathname */
+      if ((f->dev == s.st_dev) && (f->ino == s.st_ino)) 
+      {  if (close( fd ) != 0)  err(1, "close") ; 
+         return f ;
+      }
+
+   struct SequenceFile *f = (struct SequenceFile *) malloc( sizeof(struct SequenceFile) ) ;
+   if (f == NULL) { perror("SequenceFile_open: malloc" ); exit(EXIT_FAILURE); }
+   f->name = strdup( name ) ;
+   if (f->name == NULL) { perror("SequenceFile_open: strdup" ); exit(EXIT_FAILURE); }
+   f->fd = fd ;
+   f->length = (long) s.st_size ;
+   f->dev = s.st_dev ;
+   f->ino = s.st_ino ;
+   f->mtime = s.st_mtime ;
+   f->index = NULL ;
+   f->data = (char *) mmap(NULL,  s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   if (f->data == MAP_FAILED) err(1, "mmap") ;
+   f->next = _opened_files ;
+   _opened_files = f ;
+   return f ;
+}
+
+char *SequenceFile_sequence(struct SequenceFile *file, long begin, long *length, int verbose)
+{
+   char *seq ;
+   {  // Assign seq to the begining of the sequence, excluding comment lines starting by '>' 
+      seq = file->data + begin ; // beginning of the sequence
+      long n_exceed = file->length - begin; 
+      if ((begin < 0) || (n_exceed < 0))
+      {  fprintf( stderr, "Error: given sequence beginning %ld exceeds end of file of %ld bytes.\n",
+                           begin, n_exceed ) ;
+         exit( 1 ) ;
+      }
+      if ((n_exceed > 0) && (*seq == '>')) /* Skip and print the first line starting by '>' */
+      {  char *endofline = (char *) memchr(seq, '\n', n_exceed ) ;
+         if (endofline == NULL) endofline = file->data + file->length - 1 ;
+         if (verbose) 
+         {  fprintf( stderr, "Sequence comment in preamble: " ) ;
+            for( char* c = seq; c <=  endofline; ++c) fprintf(stderr, "%c", *c );
+         }
+         seq = endofline + 1; // first character of next line
+      }
+   }
+
+   {  // truncate length to the end of file 
+      long n_exceed = file->data + file->length -1 - ( seq + *length )  ; 
+      if ( n_exceed < 0) 
+      {   fprintf( stderr, "Warning: given sequence length %ld exceeds end of file of %ld bytes; "
+                           "sequence length is truncated to %ld.\n",
+                           *length, -n_exceed, *length + n_exceed ) ;
+          *length = *length + n_exceed ;
+          if (*length < 0) *length = 0 ;
+      }
+   }
+
+   if (verbose) SequenceFile_print( seq, *length ) ;
+   return seq ;
+}
+
+void SequenceFile_print(const char *seq, long length)
+{  /* Print on stderr either the full sequence is length<40 or the first twenty and last twenty characters of the sequence */ 
+   if (length <= 40)
+   { for (const char* c=seq; (c < seq+length); ++c) fprintf(stderr, "%c", *c) ;
+   }
+   else
+   { { for (const char* c=seq; (c < seq+20); ++c) fprintf(stderr, "%c", *c) ; }
+     fprintf(stderr, "..." );
+     { for (const char* c=seq+length-20; (c < seq+length); ++c) fprintf(stderr, "%c", *c) ; }
+   }
+   fprintf(stderr, "\n" );
+}
+
+size_t SequenceFile_records(struct SequenceFile *file, struct SequenceRecord **records)
+{
+   size_t count = 0, capacity = 16 ;
+   struct SequenceRecord *r = (struct SequenceRecord *) malloc( capacity * sizeof(struct SequenceRecord) ) ;
+   if (r == NULL) { perror("SequenceFile_records: malloc" ); exit(EXIT_FAILURE); }
+   char *end = file->data + file->length ;
+   char *c = file->data ;
+   if ((file->length == 0) || (*c != '>')) /* no header: the whole file */
+   {  r[0].name = file->name ;
+      r[0].name_length = (int) strlen( file->name ) ;
+      r[0].seq = c ;
+      r[0].length = file->length ;
+      *records = r ;
+      return 1 ;
+   }
+   while (c < end) /* c is at the '>' of a header */
+   {  if (count == capacity)
+      {  capacity *= 2 ;
+         r = (struct SequenceRecord *) realloc( r, capacity * sizeof(struct SequenceRecord) ) ;
+         if (r == NULL) { perror("SequenceFile_records: realloc" ); exit(EXIT_FAILURE); }
+      }
+      struct SequenceRecord *rec = &r[count++] ;
+      rec->name = c + 1 ;
+      char *e = c + 1 ;
+      while ((e < end) && !isspace( (unsigned char) *e )) ++e ;
+      rec->name_length = (int) (e - rec->name) ;
+      char *eol = (char *) memchr( e, '\n', end - e ) ;
+      rec->seq = (eol == NULL) ? end : eol + 1 ;
+      /* the next header: a '>' at the beginning of a line */
+      for (c = rec->seq; c < end; ++c)
+      {  c = (char *) memchr( c, '>', end - c ) ;
+         if (c == NULL) { c = end ; break ; }
+         if (c[-1] == '\n') break ;
+      }
+      rec->length = c - rec->seq ;
+   }
+   *records = r ;
+   return count ;
+}
+
+void SequenceFile_close_all(void)
+{
+   while (_opened_files != NULL)
+   {  struct SequenceFile *f = _opened_files ;
+      _opened_files = f->next ;
+      if (munmap( f->data, (size_t) f->length) != 0)  err(1, "munmap") ; 
+      if (close( f->fd ) != 0)  err(1, "close") ; 
+      FastaIndex_free( f->index ) ;
+      free( f->name ) ;
+      free( f ) ;
+   }
+}
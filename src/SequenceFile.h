@@ -0,0 +1,93 @@
+/**
+ * \file SequenceFile.h
+ * \brief files of genetic sequences mapped in virtual memory, and the subsequences given by (begin, length)
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Each file is mapped (mmap) at most once: the files opened are kept in a list and a file that 
+ * is opened again, under the same name or another one (same device and inode), is not remapped.
+ * The list is not protected by a lock: the files are opened by one thread (the main one), 
+ * the mappings may then be read by any thread.
+ */
+
+#ifndef __SEQUENCE_FILE_h__
+#define __SEQUENCE_FILE_h__
+
+#include <sys/types.h> /* for dev_t and ino_t */
+#include <time.h> /* for time_t */
+
+struct FastaIndex ; /* cf FastaIndex.h */
+
+/**
+ * \struct SequenceFile 
+ * \brief a file mapped in virtual memory 
+ */
+struct SequenceFile 
+{  char *name ;          /*!< pathname of the file, as given when opened first */
+   int fd ;              /*!< file descriptor */
+   char *data ;          /*!< address of the mapping */
+   long length ;         /*!< length of the file (and of the mapping) */
+   dev_t dev ;           /*!< device of the file (identifies the file with ino) */
+   ino_t ino ;           /*!< inode of the file */
+   time_t mtime ;        /*!< time of last modification of the file */
+   struct FastaIndex *index ; /*!< index of the records, NULL until loaded by FastaIndex_get */
+   struct SequenceFile *next ; /*!< next file in the list of the opened files */
+} ;
+
+/**
+ * \fn struct SequenceFile *SequenceFile_open(const char *name)
+ * \brief returns the file name mapped in virtual memory; maps it if it is not already mapped.
+ * name "-" is stdin, when redirected from a regular file (else cf SequenceStream.h). 
+ * Exits on error.
+ */
+struct SequenceFile *SequenceFile_open(const char *name) ;
+
+/**
+ * \fn char *SequenceFile_sequence(struct SequenceFile *file, long begin, long *length, int verbose)
+ * \brief returns the beginning of the sequence of *length chars from position begin in file
+ * \param file : the mapped file 
+ * \param begin : position of the sequence in the file 
+ * \param length : number of chars of the sequence; truncated (with a warning on stderr) if it exceeds the end of file
+ * \param verbose : if not 0, prints on stderr the comment line skipped and the sequence (or its first and last 20 chars)
+ * \return the address of the sequence in the mapping
+ *
+ * If the char at position begin is '>', the line (a FASTA header) is skipped and the sequence begins on the next line.
+ * Exits if begin exceeds the end of the file.
+ */
+char *SequenceFile_sequence(struct SequenceFile *file, long begin, long *length, int verbose) ;
+
+/**
+ * \fn void SequenceFile_print(const char *seq, long length)
+ * \brief prints on stderr the sequence seq[0 .. length-1] if length <= 40, else its first and last 20 chars
+ */
+void SequenceFile_print(const char *seq, long length) ;
+
+/**
+ * \struct SequenceRecord 
+ * \brief a record of a FASTA file: a header line ">name description" followed by the lines of the sequence
+ */
+struct SequenceRecord 
+{  const char *name ;    /*!< name of the record (first word of the header, not ended by '\0') */
+   int name_length ;     /*!< number of chars of name */
+   char *seq ;           /*!< first char of the sequence (after the header line) */
+   long length ;         /*!< number of chars of the sequence, up to the next header (including the '\n') */
+} ;
+
+/**
+ * \fn size_t SequenceFile_records(struct SequenceFile *file, struct SequenceRecord **records)
+ * \brief finds the records of a multi-record FASTA file 
+ * \param file : the mapped file 
+ * \param records : receives the array of the records, in the order of the file (allocated by malloc)
+ * \return the number of records 
+ *
+ * A record begins by a line starting by '>'. If the file has no header, it is one record named as the file.
+ */
+size_t SequenceFile_records(struct SequenceFile *file, struct SequenceRecord **records) ;
+
+/**
+ * \fn void SequenceFile_close_all(void)
+ * \brief unmaps and closes all the files opened 
+ */
+void SequenceFile_close_all(void) ;
+
+#endif /* __SEQUENCE_FILE_h__ */
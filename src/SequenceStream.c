@@ -0,0 +1,221 @@
+/**
+ * \file SequenceStream.c
+ * \brief genetic sequences read from a stream that cannot be mapped
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see SequenceStream.h
+ */
+
+#include "SequenceStream.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <err.h>
+#include <errno.h>
+#include <string.h> /* for strcmp, memchr */
+#include <fcntl.h> /* for open */
+#include <unistd.h> /* for read and close */
+#include <sys/stat.h> /* for the type of the file */
+
+/* list of the streams opened */
+static struct SequenceStream *_opened_streams = NULL ;
+
+int SequenceStream_is_stream(const char *name)
+{
+   struct stat s ;
+   int res = (strcmp( name, "-" ) == 0) ? fstat( 0, &s ) : stat( name, &s ) ;
+   if (res == -1) return 0 ; /* reported by SequenceFile_open */
+   return ! S_ISREG( s.st_mode ) ;
+}
+
+/* the reader thread: fills the buffers of the ring, in order, until the end of the stream or stop.
+ * It may be canceled only while it waits in read (cf SequenceStream_close_all), never with the lock held.
+ */
+static void *SequenceStream_Reader(void *arg)
+{
+   struct SequenceStream *s = (struct SequenceStream *) arg ;
+   pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, NULL ) ;
+   for (;;)
+   {  pthread_mutex_lock( &s->lock ) ;
+      while ((s->filled == STREAM_BUFFERS) && !s->stop) pthread_cond_wait( &s->not_full, &s->lock ) ;
+      int k = (s->first + s->filled) % STREAM_BUFFERS ;
+      int stop = s->stop ;
+      pthread_mutex_unlock( &s->lock ) ;
+      if (stop) return NULL ;
+
+      long n = 0 ;
+      ssize_t r = 1 ;
+      int error = 0 ;
+      while ((n < STREAM_BUFFER_SIZE) && (r > 0))
+      {  pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, NULL ) ;
+         r = read( s->fd, s->buffer[k] + n, (size_t) (STREAM_BUFFER_SIZE - n) ) ;
+         error = errno ;
+         pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, NULL ) ;
+         if (r > 0) n += r ;
+         else if ((r == -1) && (error == EINTR)) r = 1 ;
+      }
+
+      pthread_mutex_lock( &s->lock ) ;
+      s->size[k] = n ;
+      if (n > 0) ++s->filled ;
+      if (r <= 0)
+      {  s->end = 1 ;
+         s->error = (r == -1) ? error : 0 ;
+      }
+      pthread_cond_signal( &s->not_empty ) ;
+      pthread_mutex_unlock( &s->lock ) ;
+      if (r <= 0) return NULL ;
+   }
+}
+
+struct SequenceStream *SequenceStream_open(const char *name)
+{
+   for (struct SequenceStream *s = _opened_streams; s != NULL; s = s->next) /* same pathname */
+      if (strcmp( s->name, name ) == 0) return s ;
+
+   int fd = (strcmp( name, "-" ) == 0) ? 0 : open(name, O_RDONLY) ;
+   if (fd == -1) err(1,"open %s", name);
+
+   struct SequenceStream *s = (struct SequenceStream *) malloc( sizeof(struct SequenceStream) ) ;
+   if (s == NULL) { perror("SequenceStream_open: malloc" ); exit(EXIT_FAILURE); }
+   s->name = strdup( name ) ;
+   if (s->name == NULL) { perror("SequenceStream_open: strdup" ); exit(EXIT_FAILURE); }
+   s->fd = fd ;
+   for (int k = 0; k < STREAM_BUFFERS; ++k)
+   {  s->buffer[k] = (char *) malloc( STREAM_BUFFER_SIZE ) ;
+      if (s->buffer[k] == NULL) { perror("SequenceStream_open: malloc of buffer" ); exit(EXIT_FAILURE); }
+      s->size[k] = 0 ;
+   }
+   s->first = s->filled = 0 ;
+   s->end = s->error = s->stop = 0 ;
+   s->pos = s->offset = 0 ;
+   pthread_mutex_init( &s->lock, NULL ) ;
+   pthread_cond_init( &s->not_empty, NULL ) ;
+   pthread_cond_init( &s->not_full, NULL ) ;
+   if (pthread_create( &s->reader, NULL, SequenceStream_Reader, s ) != 0) errx(1, "%s: pthread_create", name) ;
+   s->next = _opened_streams ;
+   _opened_streams = s ;
+   return s ;
+}
+
+/* the chars available from the next char of the stream, in the first filled buffer:
+ * waits for the reader thread if no buffer is filled; returns 0 at the end of the stream.
+ */
+static long SequenceStream_Peek(struct SequenceStream *s, const char **chars)
+{
+   pthread_mutex_lock( &s->lock ) ;
+   while ((s->filled == 0) && !s->end) pthread_cond_wait( &s->not_empty, &s->lock ) ;
+   int filled = s->filled ;
+   int error = s->error ;
+   pthread_mutex_unlock( &s->lock ) ;
+   if (filled == 0)
+   {  if (error != 0) { errno = error ; err(1, "read %s", s->name) ; }
+      return 0 ;
+   }
+   *chars = s->buffer[s->first] + s->pos ;
+   return s->size[s->first] - s->pos ;
+}
+
+/* consumes n chars (at most those given by SequenceStream_Peek); the buffer is given back to the reader thread
+ * once all its chars are consumed.
+ */
+static void SequenceStream_Consume(struct SequenceStream *s, long n)
+{
+   s->pos += n ;
+   s->offset += n ;
+   if (s->pos < s->size[s->first]) return ;
+   pthread_mutex_lock( &s->lock ) ;
+   s->first = (s->first + 1) % STREAM_BUFFERS ;
+   --s->filled ;
+   s->pos = 0 ;
+   pthread_cond_signal( &s->not_full ) ;
+   pthread_mutex_unlock( &s->lock ) ;
+}
+
+long SequenceStream_sequence(struct SequenceStream *stream, long begin, long *length, int verbose, struct PackedSequence *ps)
+{
+   const char *chars ;
+   long n ;
+   if (begin < stream->offset)
+   {  fprintf( stderr, "Error: given sequence beginning %ld precedes the %ld bytes already read from stream %s.\n",
+                        begin, stream->offset, stream->name ) ;
+      exit( 1 ) ;
+   }
+   while (stream->offset < begin) /* skip the chars before the sequence */
+   {  n = SequenceStream_Peek( stream, &chars ) ;
+      if (n == 0)
+      {  fprintf( stderr, "Error: given sequence beginning %ld exceeds end of stream of %ld bytes.\n",
+                           begin, stream->offset ) ;
+         exit( 1 ) ;
+      }
+      SequenceStream_Consume( stream, (n < begin - stream->offset) ? n : begin - stream->offset ) ;
+   }
+
+   n = SequenceStream_Peek( stream, &chars ) ;
+   if ((n > 0) && (*chars == '>')) /* Skip and print the first line starting by '>' */
+   {  if (verbose) fprintf( stderr, "Sequence comment in preamble: " ) ;
+      for (int eol = 0; (n > 0) && !eol; n = SequenceStream_Peek( stream, &chars ))
+      {  const char *endofline = (const char *) memchr( chars, '\n', n ) ;
+         eol = (endofline != NULL) ;
+         if (eol) n = endofline + 1 - chars ;
+         if (verbose) fwrite( chars, 1, n, stderr ) ;
+         SequenceStream_Consume( stream, n ) ;
+      }
+   }
+
+   long offset = stream->offset ;
+   char head[40], tail[20] ; /* for the print on stderr: the first 40 chars, and the last 20 chars */
+   long count = 0 ;
+   Packed_create( ps, (*length > 0) ? (size_t) *length : 0 ) ;
+   while ((count < *length) && ((n = SequenceStream_Peek( stream, &chars )) > 0))
+   {  if (n > *length - count) n = *length - count ;
+      Packed_append( ps, chars, n ) ;
+      if (count < 40) memcpy( head + count, chars, (n < 40 - count) ? n : 40 - count ) ;
+      if (n >= 20) memcpy( tail, chars + n - 20, 20 ) ;
+      else
+      {  memmove( tail, tail + n, 20 - n ) ;
+         memcpy( tail + 20 - n, chars, n ) ;
+      }
+      count += n ;
+      SequenceStream_Consume( stream, n ) ;
+   }
+   if (count < *length)
+   {   fprintf( stderr, "Warning: given sequence length %ld exceeds end of stream of %ld bytes; "
+                        "sequence length is truncated to %ld.\n",
+                        *length, *length - count, count ) ;
+       *length = count ;
+   }
+
+   if (verbose)
+   {  if (count <= 40) fwrite( head, 1, count, stderr ) ;
+      else
+      {  fwrite( head, 1, 20, stderr ) ;
+         fprintf(stderr, "..." );
+         fwrite( tail, 1, 20, stderr ) ;
+      }
+      fprintf(stderr, "\n" );
+   }
+   return offset ;
+}
+
+void SequenceStream_close_all(void)
+{
+   while (_opened_streams != NULL)
+   {  struct SequenceStream *s = _opened_streams ;
+      _opened_streams = s->next ;
+      pthread_mutex_lock( &s->lock ) ;
+      s->stop = 1 ;
+      pthread_cond_signal( &s->not_full ) ;
+      pthread_mutex_unlock( &s->lock ) ;
+      pthread_cancel( s->reader ) ; /* if it waits in read for chars that are no more needed */
+      pthread_join( s->reader, NULL ) ;
+      if (close( s->fd ) != 0)  err(1, "close") ;
+      pthread_mutex_destroy( &s->lock ) ;
+      pthread_cond_destroy( &s->not_empty ) ;
+      pthread_cond_destroy( &s->not_full ) ;
+      for (int k = 0; k < STREAM_BUFFERS; ++k) free( s->buffer[k] ) ;
+      free( s->name ) ;
+      free( s ) ;
+   }
+}
@@ -0,0 +1,94 @@
+/**
+ * \file SequenceStream.h
+ * \brief genetic sequences read from a stream that cannot be mapped (stdin, a pipe, a process substitution <(zcat f.fna.gz))
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * A stream is read once, from its beginning, by a reader thread that fills a ring of
+ * STREAM_BUFFERS buffers ahead of the calling thread: while the calling thread skips the chars
+ * before a sequence and packs the sequence (cf Packed_append), the reader thread waits for the next
+ * chars, so that the producer of the stream (eg a decompressor) is never blocked by the packing.
+ * Only the packed bases are kept, never the whole stream.
+ * The streams opened are kept in a list, as the files of SequenceFile.h: a stream given twice is read once,
+ * its sequences must then be extracted in the order of their positions.
+ */
+
+#ifndef __SEQUENCE_STREAM_h__
+#define __SEQUENCE_STREAM_h__
+
+#include <pthread.h>
+
+#include "Packed.h"
+
+/** \def STREAM_BUFFERS
+ * \brief number of buffers of the ring between the reader thread and the calling thread
+ */
+#define STREAM_BUFFERS 4
+
+/** \def STREAM_BUFFER_SIZE
+ * \brief number of chars of a buffer of the ring
+ */
+#define STREAM_BUFFER_SIZE (1L << 20)
+
+/**
+ * \struct SequenceStream
+ * \brief a stream read by a reader thread in a ring of buffers
+ *
+ * The buffers first .. first+filled-1 (modulo STREAM_BUFFERS) are filled and read by the calling thread,
+ * the next one is filled by the reader thread.
+ */
+struct SequenceStream
+{  char *name ;          /*!< pathname of the stream, as given when opened ("-" for stdin) */
+   int fd ;              /*!< file descriptor */
+   pthread_t reader ;    /*!< the reader thread */
+   pthread_mutex_t lock ; /*!< protects first, filled, end, error and stop */
+   pthread_cond_t not_empty ; /*!< signaled when a buffer is filled or at the end of the stream */
+   pthread_cond_t not_full ;  /*!< signaled when a buffer is released by the calling thread, or at stop */
+   char *buffer[STREAM_BUFFERS] ; /*!< the ring */
+   long size[STREAM_BUFFERS] ;    /*!< number of chars of each filled buffer */
+   int first ;           /*!< index of the first filled buffer */
+   int filled ;          /*!< number of filled buffers */
+   int end ;             /*!< 1 when the reader thread has reached the end of the stream */
+   int error ;           /*!< errno of the read that failed, 0 if none */
+   int stop ;            /*!< 1 when the reader thread must stop (cf SequenceStream_close_all) */
+   long pos ;            /*!< position of the next char in buffer[first] (calling thread only) */
+   long offset ;         /*!< offset in the stream of the next char (calling thread only) */
+   struct SequenceStream *next ; /*!< next stream in the list of the opened streams */
+} ;
+
+/**
+ * \fn int SequenceStream_is_stream(const char *name)
+ * \brief returns 1 if name is "-" (stdin) or a file that is not regular (a pipe, a character device, /dev/fd/n of
+ * a process substitution), ie a file that cannot be mapped by SequenceFile_open; else 0
+ */
+int SequenceStream_is_stream(const char *name) ;
+
+/**
+ * \fn struct SequenceStream *SequenceStream_open(const char *name)
+ * \brief returns the stream name ("-" for stdin); opens it and starts its reader thread if it is not already opened.
+ * Exits on error.
+ */
+struct SequenceStream *SequenceStream_open(const char *name) ;
+
+/**
+ * \fn long SequenceStream_sequence(struct SequenceStream *stream, long begin, long *length, int verbose, struct PackedSequence *ps)
+ * \brief reads the sequence of *length chars from position begin in stream and packs it in ps, as soon as the chars are read
+ * \param stream : the stream
+ * \param begin : position of the sequence in the stream, not before the chars already read
+ * \param length : number of chars of the sequence; truncated (with a warning on stderr) if it exceeds the end of stream
+ * \param verbose : if not 0, prints on stderr the comment line skipped and the sequence (or its first and last 20 chars)
+ * \param ps : receives the bases (cf Packed_create, Packed_append); the chars are not kept (ps->source is NULL)
+ * \return the offset of the sequence in the stream
+ *
+ * As SequenceFile_sequence: if the char at position begin is '>', the line (a FASTA header) is skipped.
+ * Exits if begin exceeds the end of the stream or precedes the chars already read.
+ */
+long SequenceStream_sequence(struct SequenceStream *stream, long begin, long *length, int verbose, struct PackedSequence *ps) ;
+
+/**
+ * \fn void SequenceStream_close_all(void)
+ * \brief stops the reader threads and closes all the streams opened (the rest of a stream is not read)
+ */
+void SequenceStream_close_all(void) ;
+
+#endif /* __SEQUENCE_STREAM_h__ */
@@ -0,0 +1,314 @@
+/**
+ * \file Striped.c
+ * \brief distance computed by a pipeline of processes, one per stripe of columns, that pass their boundary column by sockets
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Striped.h
+ */
+
+#include "Striped.h"
+#include "CacheAware.h" /* the tiles of the stripes */
+#include "CellWidth.h" /* cells on 2, 4 or 8 bytes */
+#include "Tuning.h" /* height of the blocks and width of the tiles */
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "Progress.h" /* the counts of the workers, in the slots shared with the calling process */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for memcmp, strncmp and strrchr */
+#include <errno.h>
+#include <err.h>
+#include <time.h> /* for nanosleep */
+#include <unistd.h> /* for fork, close and unlink */
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h> /* Unix sockets */
+#include <sys/wait.h> /* for waitpid */
+#include <netdb.h> /* for getaddrinfo */
+#include <netinet/in.h>
+#include <netinet/tcp.h> /* for TCP_NODELAY */
+
+#include "characters_to_base.h" /* mapping from char to base */
+
+struct Stripe *_stripe = NULL ;
+
+/** \def STRIPE_MAGIC
+ * \brief first 8 bytes of a connection between two workers (the last 2 ones: version of the protocol)
+ */
+#define STRIPE_MAGIC "EDSTRIPE"
+
+/** \def STRIPE_CONNECT_SECONDS
+ * \brief seconds during which a worker tries to connect to the next one, that may be started after it
+ */
+#define STRIPE_CONNECT_SECONDS 60
+
+/**
+ * \struct StripeHeader
+ * \brief first message of the worker s-1 to the worker s
+ */
+struct StripeHeader
+{  char magic[8] ;    /*!< STRIPE_MAGIC */
+   uint64_t m ;       /*!< bases of the longest sequence (rows) */
+   uint64_t n ;       /*!< bases of the shortest sequence (columns) */
+   uint32_t width ;   /*!< bytes of a cell */
+   int32_t stripe ;   /*!< stripe of the sender */
+} ;
+
+/* Stripe_parse : cf .h for specification
+ */
+int Stripe_parse(const char *spec, struct Stripe *stripe)
+{
+   char end ;
+   return (sscanf( spec, "%d/%d%c", &stripe->index, &stripe->count, &end ) == 2)
+          && (stripe->count >= 1) && (stripe->index >= 0) && (stripe->index < stripe->count) ;
+}
+
+/* sends size bytes of data on the socket fd of the worker stripe; exits on error */
+static void Striped_Send(int fd, const void *data, size_t size, int stripe)
+{
+   const char *p = (const char *) data ;
+   while (size > 0)
+   {  ssize_t k = send( fd, p, size, MSG_NOSIGNAL ) ;
+      if ((k < 0) && (errno == EINTR)) continue ;
+      if (k <= 0) err(1, "stripe %d: send to the next stripe", stripe) ;
+      p += k ;
+      size -= (size_t) k ;
+   }
+}
+
+/* receives size bytes in data from the socket fd of the worker stripe; exits on error or end of the connection */
+static void Striped_Receive(int fd, void *data, size_t size, int stripe)
+{
+   char *p = (char *) data ;
+   while (size > 0)
+   {  ssize_t k = recv( fd, p, size, 0 ) ;
+      if ((k < 0) && (errno == EINTR)) continue ;
+      if (k < 0) err(1, "stripe %d: receive from the previous stripe", stripe) ;
+      if (k == 0) errx(1, "stripe %d: the previous stripe closed the connection", stripe) ;
+      p += k ;
+      size -= (size_t) k ;
+   }
+}
+
+/*
+ * static long Striped_Worker(const struct PackedSequence *X, const struct PackedSequence *Y, int stripe, int count, int in, int out, struct Workspace *ws)
+ * \brief computes the stripe stripe of count of the table of X (rows) and Y (columns), receiving the left column of each
+ * block from in (-1 for the stripe 0: the column 0 of the table) and sending its right column to out (-1 for the last stripe)
+ * \return phi(m, c1), c1 the last column of the stripe
+ *
+ * top[t] (slot 1) is the bottom row of the tile t of the stripe, K+1 cells; col (slot 2) the column of the block,
+ * from the left of the stripe to its right through the tiles.
+ */
+static long Striped_Worker(const struct PackedSequence *X, const struct PackedSequence *Y, int stripe, int count,
+                           int in, int out, struct Workspace *ws)
+{
+   size_t m = X->length, n = Y->length ;
+   size_t c0 = (size_t) ((double) n * stripe / count), c1 = (size_t) ((double) n * (stripe + 1) / count) ;
+   size_t K = _tuning.par_tile ;
+   size_t tiles = (c1 - c0 + K - 1) / K ;
+   int width = Cell_width( m, n ) ;
+
+   unsigned char *Yb = (unsigned char *) Workspace_get( ws, 0, c1 - c0 + 1 ) ;
+   Packed_unpack( Y, c0, c1 - c0, Yb ) ;
+   char *top = (char *) Workspace_get( ws, 1, tiles * (K + 1) * width + 1 ) ;
+   for (size_t t = 0; t < tiles; ++t) /* phi(0, c0 + tK .. c0 + (t+1)K) */
+      for (size_t j = 0; j <= K; ++j) Cell_set( top + t * (K + 1) * width, j, width, INSERTION_COST * (long) (c0 + t * K + j) ) ;
+
+   struct StripeHeader header ;
+   memset( &header, 0, sizeof(header) ) ;
+   memcpy( header.magic, STRIPE_MAGIC, 8 ) ;
+   header.m = m ;
+   header.n = n ;
+   header.width = (uint32_t) width ;
+   if (in >= 0)
+   {  struct StripeHeader previous ;
+      Striped_Receive( in, &previous, sizeof(previous), stripe ) ;
+      if ((memcmp( previous.magic, STRIPE_MAGIC, 8 ) != 0) || (previous.m != m) || (previous.n != n)
+          || (previous.width != (uint32_t) width) || (previous.stripe != stripe - 1))
+         errx(1, "stripe %d: the previous worker is not the stripe %d of the same table", stripe, stripe - 1) ;
+   }
+   if (out >= 0)
+   {  header.stripe = stripe ;
+      Striped_Send( out, &header, sizeof(header), stripe ) ;
+   }
+   PerfCounters_phase( PERF_FILL ) ;
+
+   long res = INSERTION_COST * (long) c1 ; /* phi(0, c1) if m = 0 */
+   for (size_t r0 = 0; r0 < m; )
+   {  uint64_t h = (m - r0 < K) ? m - r0 : K ;
+      if (in >= 0) Striped_Receive( in, &h, sizeof(h), stripe ) ;
+      if ((h == 0) || (h > m - r0)) errx(1, "stripe %d: invalid block of %llu rows", stripe, (unsigned long long) h) ;
+      char *col = (char *) Workspace_get( ws, 2, (h + 1) * width ) ;
+      if (in >= 0) Striped_Receive( in, col + width, h * width, stripe ) ;
+      else for (size_t i = 1; i <= h; ++i) Cell_set( col, i, width, INSERTION_COST * (long) (r0 + i) ) ; /* column 0 */
+      for (size_t t = 0; t < tiles; ++t) /* the right column of the tile t is the left one of the tile t+1 */
+      {  size_t w = (c1 - c0 - t * K < K) ? c1 - c0 - t * K : K ;
+         EditDistance_CA_Tile( X, Yb + t * K, r0, r0 + h, w, top + t * (K + 1) * width, col, width ) ;
+      }
+      if (out >= 0)
+      {  Striped_Send( out, &h, sizeof(h), stripe ) ;
+         Striped_Send( out, col + width, h * width, stripe ) ;
+      }
+      r0 += h ;
+      res = Cell_get( col, h, width ) ;
+   }
+   PerfCounters_phase( PERF_TEARDOWN ) ;
+   return res ;
+}
+
+/* the socket address of address (unix:path or host:port) for getaddrinfo, or a Unix address in un; exits if invalid */
+static struct addrinfo *Striped_Address(const char *address, struct sockaddr_un *un, struct addrinfo *unix_info)
+{
+   if (strncmp( address, "unix:", 5 ) == 0)
+   {  if (strlen( address + 5 ) >= sizeof(un->sun_path)) errx(1, "%s: path too long", address) ;
+      memset( un, 0, sizeof(*un) ) ;
+      un->sun_family = AF_UNIX ;
+      strcpy( un->sun_path, address + 5 ) ;
+      memset( unix_info, 0, sizeof(*unix_info) ) ;
+      unix_info->ai_family = AF_UNIX ;
+      unix_info->ai_socktype = SOCK_STREAM ;
+      unix_info->ai_addr = (struct sockaddr *) un ;
+      unix_info->ai_addrlen = sizeof(*un) ;
+      return unix_info ;
+   }
+   const char *colon = strrchr( address, ':' ) ;
+   if (colon == NULL) errx(1, "invalid address %s (unix:path or host:port)", address) ;
+   char host[256] ;
+   size_t length = (size_t) (colon - address) ;
+   if (length >= sizeof(host)) errx(1, "%s: host too long", address) ;
+   memcpy( host, address, length ) ;
+   host[length] = '\0' ;
+   struct addrinfo hints, *info ;
+   memset( &hints, 0, sizeof(hints) ) ;
+   hints.ai_family = AF_UNSPEC ;
+   hints.ai_socktype = SOCK_STREAM ;
+   hints.ai_flags = AI_PASSIVE ;
+   int e = getaddrinfo( (length == 0) ? NULL : host, colon + 1, &hints, &info ) ;
+   if (e != 0) errx(1, "%s: %s", address, gai_strerror( e )) ;
+   return info ;
+}
+
+/* the connection of the previous worker, accepted on address */
+static int Striped_Listen(const char *address, int stripe)
+{
+   struct sockaddr_un un ;
+   struct addrinfo unix_info ;
+   struct addrinfo *info = Striped_Address( address, &un, &unix_info ) ;
+   int fd = socket( info->ai_family, info->ai_socktype, 0 ) ;
+   if (fd < 0) err(1, "stripe %d: socket", stripe) ;
+   int on = 1 ;
+   if (info->ai_family == AF_UNIX) unlink( un.sun_path ) ;
+   else setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on) ) ;
+   if ((bind( fd, info->ai_addr, info->ai_addrlen ) != 0) || (listen( fd, 1 ) != 0)) err(1, "stripe %d: %s", stripe, address) ;
+   int connection ;
+   while (((connection = accept( fd, NULL, NULL )) < 0) && (errno == EINTR)) ;
+   if (connection < 0) err(1, "stripe %d: accept on %s", stripe, address) ;
+   close( fd ) ;
+   if (info->ai_family == AF_UNIX) unlink( un.sun_path ) ;
+   else freeaddrinfo( info ) ;
+   return connection ;
+}
+
+/* the connection to the next worker at address, tried during STRIPE_CONNECT_SECONDS (it may not listen yet) */
+static int Striped_Connect(const char *address, int stripe)
+{
+   struct sockaddr_un un ;
+   struct addrinfo unix_info ;
+   struct addrinfo *info = Striped_Address( address, &un, &unix_info ) ;
+   struct timespec pause = { 0, 100000000L } ; /* 0.1 s */
+   for (int attempt = 0; ; ++attempt)
+   {  int fd = socket( info->ai_family, info->ai_socktype, 0 ) ;
+      if (fd < 0) err(1, "stripe %d: socket", stripe) ;
+      if (connect( fd, info->ai_addr, info->ai_addrlen ) == 0)
+      {  int on = 1 ;
+         if (info->ai_family != AF_UNIX)
+         {  setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on) ) ;
+            freeaddrinfo( info ) ;
+         }
+         return fd ;
+      }
+      if (attempt >= 10 * STRIPE_CONNECT_SECONDS) err(1, "stripe %d: connect to %s", stripe, address) ;
+      close( fd ) ;
+      nanosleep( &pause, NULL ) ;
+   }
+}
+
+/* the distance by count worker processes forked and connected by pairs of Unix sockets, the last one writing it in a pipe */
+static long Striped_Local(const struct PackedSequence *X, const struct PackedSequence *Y, int count, struct Workspace *ws)
+{
+   int (*link)[2] = (int (*)[2]) malloc( (count + 1) * sizeof(*link) ) ; /* link[s]: from the stripe s-1 to s */
+   int result[2] ;
+   if (link == NULL) { perror("EditDistance_Striped: malloc"); exit(EXIT_FAILURE); }
+   for (int s = 1; s < count; ++s)
+      if (socketpair( AF_UNIX, SOCK_STREAM, 0, link[s] ) != 0) err(1, "EditDistance_Striped: socketpair") ;
+   if (pipe( result ) != 0) err(1, "EditDistance_Striped: pipe") ;
+   fflush( NULL ) ; /* the buffers of stdio are not written twice */
+
+   pid_t *pid = (pid_t *) malloc( count * sizeof(pid_t) ) ;
+   if (pid == NULL) { perror("EditDistance_Striped: malloc"); exit(EXIT_FAILURE); }
+   for (int s = 0; s < count; ++s)
+   {  pid[s] = fork() ;
+      if (pid[s] < 0) err(1, "EditDistance_Striped: fork") ;
+      if (pid[s] == 0) /* the worker of stripe s: link[s][1] from the previous one, link[s+1][0] to the next one */
+      {  for (int t = 1; t < count; ++t)
+         {  if (t != s) close( link[t][1] ) ;
+            if (t != s + 1) close( link[t][0] ) ;
+         }
+         close( result[0] ) ;
+         if (_progress_enabled) Progress_register() ;
+         long res = Striped_Worker( X, Y, s, count, (s > 0) ? link[s][1] : -1, (s + 1 < count) ? link[s+1][0] : -1, ws ) ;
+         if ((s + 1 == count) && (write( result[1], &res, sizeof(res) ) != sizeof(res))) _exit(EXIT_FAILURE) ;
+         _exit(0) ;
+      }
+   }
+   for (int s = 1; s < count; ++s) { close( link[s][0] ) ; close( link[s][1] ) ; }
+   close( result[1] ) ;
+
+   long res ;
+   ssize_t k ;
+   while (((k = read( result[0], &res, sizeof(res) )) < 0) && (errno == EINTR)) ;
+   close( result[0] ) ;
+   int failed = (k != sizeof(res)) ;
+   for (int s = 0; s < count; ++s)
+   {  int status ;
+      while ((waitpid( pid[s], &status, 0 ) < 0) && (errno == EINTR)) ;
+      if (! WIFEXITED( status ) || (WEXITSTATUS( status ) != 0)) failed = 1 ;
+   }
+   free( pid ) ;
+   free( link ) ;
+   if (failed) errx(1, "EditDistance_Striped: a worker process failed") ;
+   return res ;
+}
+
+/* EditDistance_Striped_Packed : cf .h for specification
+ */
+long EditDistance_Striped_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nprocesses, struct Workspace *ws)
+{
+   const struct PackedSequence *X = (A->length >= B->length) ? A : B ; /* X is the longest sequence, Y the shortest */
+   const struct PackedSequence *Y = (A->length >= B->length) ? B : A ;
+   if (_stripe == NULL) return Striped_Local( X, Y, (nprocesses < 1) ? 1 : nprocesses, ws ) ;
+
+   int stripe = _stripe->index, count = _stripe->count ;
+   int in = (stripe > 0) ? Striped_Listen( _stripe->upstream, stripe ) : -1 ;
+   int out = (stripe + 1 < count) ? Striped_Connect( _stripe->downstream, stripe ) : -1 ;
+   long res = Striped_Worker( X, Y, stripe, count, in, out, ws ) ;
+   if (in >= 0) close( in ) ;
+   if (out >= 0) close( out ) ;
+   return (stripe + 1 == count) ? res : -1 ;
+}
+
+/* EditDistance_Striped : cf .h for specification
+ */
+long EditDistance_Striped(char* A, size_t lengthA, char* B, size_t lengthB, int nprocesses)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_Striped_Packed( &X, &Y, nprocesses, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
@@ -0,0 +1,76 @@
+/**
+ * \file Striped.h
+ * \brief distance computed by a pipeline of processes, one per stripe of columns, that pass their boundary column by sockets
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The columns (the bases of the shortest sequence Y) are cut in k stripes of about n/k columns, one per worker process.
+ * The worker of stripe s computes its stripe by blocks of rows: for each block, it receives the column on its left
+ * (the right boundary of stripe s-1) from the worker s-1, computes the block by tiles (EditDistance_CA_Tile, the tiles
+ * of EditDistance_CA_Par), and sends its right boundary column to the worker s+1. The workers thus form a pipeline:
+ * the worker s starts the block b when the worker s-1 has finished it, and k blocks are computed at once.
+ * Each worker only keeps the bottom row of its stripe and one column of a block: O(n/k + block) cells.
+ * The worker 0 chooses the height of the blocks (_tuning.par_tile rows, cf Tuning.h), the others follow the blocks they
+ * receive. Only the last worker knows the distance: it is the last cell of its last column.
+ *
+ * On the connection, the worker s-1 first sends a header (the magic "EDSTRIPE", the numbers of bases m and n,
+ * the width of the cells and its stripe s-1), checked by the worker s, then, for each block, its number of rows h
+ * (a uint64_t) and the h cells of its right column, of the width of Cell_width (cf CellWidth.h). The integers and the
+ * cells are in the byte order of the machines: the workers must share it.
+ *
+ * Locally (distanceEdition --engine=striped --threads=k), the k workers are forked and connected by pairs of Unix
+ * sockets; the last one gives the distance to the calling process by a pipe. On several hosts, each worker is one
+ * distanceEdition --stripe=s/k, listening for the worker s-1 on --upstream and connecting to the worker s+1
+ * at --downstream (addresses unix:path or host:port), on the same sequences.
+ * The costs are the ones of Globals.h, as for EditDistance_CA.
+ */
+
+#ifndef __STRIPED_h__
+#define __STRIPED_h__
+
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/**
+ * \struct Stripe
+ * \brief the stripe of a worker process started on its own (distanceEdition --stripe)
+ */
+struct Stripe
+{  int index ;              /*!< the stripe of the process, 0 .. count-1 */
+   int count ;              /*!< number of stripes, and of worker processes */
+   const char *upstream ;   /*!< address where the worker index-1 connects (NULL for the stripe 0) */
+   const char *downstream ; /*!< address of the worker index+1 (NULL for the last stripe) */
+} ;
+
+/**
+ * \var _stripe
+ * \brief the stripe of the process if it is one worker of a pipeline started on its own, NULL (the default) to fork
+ * the workers locally
+ */
+extern struct Stripe *_stripe ;
+
+/**
+ * \fn int Stripe_parse(const char *spec, struct Stripe *stripe)
+ * \brief reads in stripe->index and stripe->count the stripe spec "s/k", 0 <= s < k; 0 if spec is invalid, else 1
+ */
+int Stripe_parse(const char *spec, struct Stripe *stripe) ;
+
+/**
+ * \fn long EditDistance_Striped(char* A, size_t lengthA, char* B, size_t lengthB, int nprocesses);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1] by a pipeline of nprocesses
+ * worker processes forked locally, one per stripe of columns (cf above)
+ * \return :  edit distance between A and B
+ *
+ * If lengthA < lengthB, the sequences A and B are swapped.
+ */
+long EditDistance_Striped(char* A, size_t lengthA, char* B, size_t lengthB, int nprocesses);
+
+/**
+ * \fn long EditDistance_Striped_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nprocesses, struct Workspace *ws);
+ * \brief same as EditDistance_Striped on sequences already packed (cf Packed_init), the buffers of the workers being
+ * taken in ws (slots 0 to 2); if _stripe is not NULL, the calling process is only the worker of the stripe _stripe
+ * (nprocesses is ignored), and the distance is returned by the last stripe only, the others returning -1
+ */
+long EditDistance_Striped_Packed(const struct PackedSequence *A, const struct PackedSequence *B, int nprocesses, struct Workspace *ws);
+
+#endif /* __STRIPED_h__ */
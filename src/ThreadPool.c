@@ -0,0 +1,246 @@
+/**
+ * \file ThreadPool.c
+ * \brief pool of POSIX threads that executes tasks submitted dynamically 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see ThreadPool.h
+ * Work stealing: each worker has its own deque of tasks; the tasks submitted by a worker are pushed 
+ * at the bottom of its deque and it pops them from the bottom (the last submitted first, whose data 
+ * is still in its cache). The tasks submitted by another thread are queued in a shared FIFO 
+ * (the injection queue). A worker whose deque is empty takes the oldest task of the injection 
+ * queue or else steals the oldest task at the top of the deque of another worker.
+ * Each deque is a circular array protected by its own mutex; it is doubled when full.
+ */
+
+#include "ThreadPool.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h> /* for sysconf */
+
+/** \struct ThreadPool_Entry
+ * \brief a queued task
+ */
+struct ThreadPool_Entry
+{
+    ThreadPool_Task fn ; /*!< function to call */
+    void *arg ;          /*!< its shared data */
+    size_t index ;       /*!< its index */
+} ;
+
+/** \struct ThreadPool_Deque
+ * \brief circular array of ready tasks, from top (the oldest) to bottom (the newest)
+ */
+struct ThreadPool_Deque
+{
+    struct ThreadPool_Entry *tasks ; /*!< circular array */
+    size_t capacity ;        /*!< size of tasks */
+    size_t top ;             /*!< position of the oldest task */
+    size_t count ;           /*!< number of tasks */
+    pthread_mutex_t lock ;   /*!< protects all the fields above */
+} ;
+
+/** \struct ThreadPool
+ * \brief workers and deques of ready tasks 
+ */
+struct ThreadPool
+{
+    pthread_t *threads ;     /*!< the nthreads workers */
+    int nthreads ;           /*!< number of workers */
+    struct ThreadPool_Deque *deques ; /*!< deques[w] for worker w, deques[nthreads] is the injection queue */
+    atomic_size_t queued ;   /*!< number of tasks in the deques */
+    atomic_size_t pending ;  /*!< number of submitted tasks not yet completed */
+    atomic_int sleeping ;    /*!< number of workers waiting for a task */
+    int stop ;               /*!< set by ThreadPool_destroy */
+    pthread_mutex_t lock ;   /*!< protects stop and the waits on the conditions */
+    pthread_cond_t not_empty ; /*!< signaled when a task is queued or at stop */
+    pthread_cond_t all_done ;  /*!< signaled when pending reaches 0 */
+} ;
+
+/** \struct ThreadPool_Worker
+ * \brief argument of a worker thread
+ */
+struct ThreadPool_Worker
+{
+    struct ThreadPool *pool ;
+    int id ;
+} ;
+
+/* the worker executed by the current thread, NULL if it is not a worker */
+static __thread struct ThreadPool_Worker *_current_worker = NULL ;
+
+int ThreadPool_default_size(void)
+{
+   long n = sysconf( _SC_NPROCESSORS_ONLN ) ;
+   return (n < 1) ? 1 : (int) n ;
+}
+
+static void ThreadPool_DequeInit(struct ThreadPool_Deque *d)
+{
+   d->capacity = 64 ;
+   d->tasks = (struct ThreadPool_Entry *) malloc( d->capacity * sizeof(struct ThreadPool_Entry) ) ;
+   if (d->tasks == NULL) { perror("ThreadPool_create: malloc of deque" ); exit(EXIT_FAILURE); }
+   d->top = 0 ;
+   d->count = 0 ;
+   pthread_mutex_init( &d->lock, NULL ) ;
+}
+
+static void ThreadPool_PushBottom(struct ThreadPool_Deque *d, ThreadPool_Task fn, void *arg, size_t index)
+{
+   pthread_mutex_lock( &d->lock ) ;
+   if (d->count == d->capacity) /* double the circular array, unrolling it from top */
+   {  struct ThreadPool_Entry *q = (struct ThreadPool_Entry *) malloc( 2 * d->capacity * sizeof(struct ThreadPool_Entry) ) ;
+      if (q == NULL) { perror("ThreadPool_submit: malloc of deque" ); exit(EXIT_FAILURE); }
+      for (size_t k = 0; k < d->count; ++k) q[k] = d->tasks[(d->top + k) % d->capacity] ;
+      free( d->tasks ) ;
+      d->tasks = q ;
+      d->top = 0 ;
+      d->capacity *= 2 ;
+   }
+   struct ThreadPool_Entry *e = &d->tasks[(d->top + d->count) % d->capacity] ;
+   e->fn = fn ;
+   e->arg = arg ;
+   e->index = index ;
+   d->count++ ;
+   pthread_mutex_unlock( &d->lock ) ;
+}
+
+/* pops the newest task of d (bottom) if from_bottom, else the oldest one (top); returns 0 if d is empty */
+static int ThreadPool_Pop(struct ThreadPool_Deque *d, int from_bottom, struct ThreadPool_Entry *e)
+{
+   pthread_mutex_lock( &d->lock ) ;
+   int found = (d->count != 0) ;
+   if (found)
+   {  if (from_bottom) *e = d->tasks[(d->top + d->count - 1) % d->capacity] ;
+      else 
+      {  *e = d->tasks[d->top] ;
+         d->top = (d->top + 1) % d->capacity ;
+      }
+      d->count-- ;
+   }
+   pthread_mutex_unlock( &d->lock ) ;
+   return found ;
+}
+
+/* takes a task for worker id: its own newest task, else the oldest injected one, else steals the oldest task of another worker */
+static int ThreadPool_Take(struct ThreadPool *pool, int id, struct ThreadPool_Entry *e)
+{
+   if (ThreadPool_Pop( &pool->deques[id], 1, e )) return 1 ;
+   if (ThreadPool_Pop( &pool->deques[pool->nthreads], 0, e )) return 1 ;
+   for (int k = 1; k < pool->nthreads; ++k) 
+      if (ThreadPool_Pop( &pool->deques[(id + k) % pool->nthreads], 0, e )) return 1 ;
+   return 0 ;
+}
+
+static void *ThreadPool_run(void *p)
+{
+   struct ThreadPool_Worker *w = (struct ThreadPool_Worker *) p ;
+   struct ThreadPool *pool = w->pool ;
+   int id = w->id ;
+   _current_worker = w ;
+
+   for (;;)
+   {  struct ThreadPool_Entry e ;
+      if (ThreadPool_Take( pool, id, &e ))
+      {  atomic_fetch_sub( &pool->queued, 1 ) ;
+         e.fn( e.arg, e.index, id ) ;
+         if (atomic_fetch_sub( &pool->pending, 1 ) == 1) 
+         {  pthread_mutex_lock( &pool->lock ) ;
+            pthread_cond_broadcast( &pool->all_done ) ;
+            pthread_mutex_unlock( &pool->lock ) ;
+         }
+         continue ;
+      }
+      /* no task: sleep until one is queued (sleeping is incremented before queued is read again, 
+       * cf ThreadPool_submit, so that a wake-up is not lost) */
+      pthread_mutex_lock( &pool->lock ) ;
+      atomic_fetch_add( &pool->sleeping, 1 ) ;
+      while ((atomic_load( &pool->queued ) == 0) && !pool->stop) pthread_cond_wait( &pool->not_empty, &pool->lock ) ;
+      atomic_fetch_sub( &pool->sleeping, 1 ) ;
+      int stop = pool->stop && (atomic_load( &pool->queued ) == 0) ; /* stop and no more work */
+      pthread_mutex_unlock( &pool->lock ) ;
+      if (stop) break ;
+   }
+   _current_worker = NULL ;
+   free( w ) ;
+   return NULL ;
+}
+
+struct ThreadPool *ThreadPool_create(int nthreads)
+{
+   if (nthreads <= 0) nthreads = ThreadPool_default_size() ;
+   struct ThreadPool *pool = (struct ThreadPool *) calloc( 1, sizeof(struct ThreadPool) ) ;
+   if (pool == NULL) { perror("ThreadPool_create: malloc of pool" ); exit(EXIT_FAILURE); }
+   pool->deques = (struct ThreadPool_Deque *) malloc( (nthreads + 1) * sizeof(struct ThreadPool_Deque) ) ;
+   pool->threads = (pthread_t *) malloc( nthreads * sizeof(pthread_t) ) ;
+   if ((pool->deques == NULL) || (pool->threads == NULL)) 
+   {  perror("ThreadPool_create: malloc of deques" ); exit(EXIT_FAILURE); 
+   }
+   for (int i = 0; i <= nthreads; ++i) ThreadPool_DequeInit( &pool->deques[i] ) ;
+   atomic_init( &pool->queued, 0 ) ;
+   atomic_init( &pool->pending, 0 ) ;
+   atomic_init( &pool->sleeping, 0 ) ;
+   pthread_mutex_init( &pool->lock, NULL ) ;
+   pthread_cond_init( &pool->not_empty, NULL ) ;
+   pthread_cond_init( &pool->all_done, NULL ) ;
+   pool->nthreads = nthreads ;
+   for (int i = 0; i < nthreads; ++i)
+   {  struct ThreadPool_Worker *w = (struct ThreadPool_Worker *) malloc( sizeof(struct ThreadPool_Worker) ) ;
+      if (w == NULL) { perror("ThreadPool_create: malloc of worker" ); exit(EXIT_FAILURE); }
+      w->pool = pool ; 
+      w->id = i ;
+      if (pthread_create( &pool->threads[i], NULL, ThreadPool_run, w ) != 0)
+      {  perror("ThreadPool_create: pthread_create" ); exit(EXIT_FAILURE); 
+      }
+   }
+   return pool ;
+}
+
+int ThreadPool_size(struct ThreadPool *pool)
+{
+   return pool->nthreads ;
+}
+
+void ThreadPool_submit(struct ThreadPool *pool, ThreadPool_Task fn, void *arg, size_t index)
+{
+   struct ThreadPool_Worker *w = _current_worker ;
+   int d = ((w != NULL) && (w->pool == pool)) ? w->id : pool->nthreads ; /* own deque, or injection queue */
+   atomic_fetch_add( &pool->pending, 1 ) ;
+   ThreadPool_PushBottom( &pool->deques[d], fn, arg, index ) ;
+   atomic_fetch_add( &pool->queued, 1 ) ;
+   if (atomic_load( &pool->sleeping ) > 0) 
+   {  pthread_mutex_lock( &pool->lock ) ;
+      pthread_cond_signal( &pool->not_empty ) ;
+      pthread_mutex_unlock( &pool->lock ) ;
+   }
+}
+
+void ThreadPool_wait(struct ThreadPool *pool)
+{
+   pthread_mutex_lock( &pool->lock ) ;
+   while (atomic_load( &pool->pending ) != 0) pthread_cond_wait( &pool->all_done, &pool->lock ) ;
+   pthread_mutex_unlock( &pool->lock ) ;
+}
+
+void ThreadPool_destroy(struct ThreadPool *pool)
+{
+   ThreadPool_wait( pool ) ;
+   pthread_mutex_lock( &pool->lock ) ;
+   pool->stop = 1 ;
+   pthread_cond_broadcast( &pool->not_empty ) ;
+   pthread_mutex_unlock( &pool->lock ) ;
+   for (int i = 0; i < pool->nthreads; ++i) pthread_join( pool->threads[i], NULL ) ;
+   pthread_mutex_destroy( &pool->lock ) ;
+   pthread_cond_destroy( &pool->not_empty ) ;
+   pthread_cond_destroy( &pool->all_done ) ;
+   for (int i = 0; i <= pool->nthreads; ++i) 
+   {  pthread_mutex_destroy( &pool->deques[i].lock ) ;
+      free( pool->deques[i].tasks ) ;
+   }
+   free( pool->deques ) ;
+   free( pool->threads ) ;
+   free( pool ) ;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file ThreadPool.h
+ * \brief pool of POSIX threads that executes tasks submitted dynamically 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * A task is a function called with a pointer to shared data, an index (eg the number of a tile)
+ * and the number of the worker thread that executes it (0 .. nthreads-1).
+ * A task may itself submit new tasks, eg the tiles whose dependencies are now satisfied.
+ *
+ * Scheduling by work stealing: the tasks submitted by a worker are executed by it in LIFO order 
+ * unless idle workers steal them (the oldest first); the tasks submitted by another thread 
+ * (eg the main one) are started in the order of their submission.
+ */
+
+#ifndef __THREAD_POOL_h__
+#define __THREAD_POOL_h__
+
+#include <stdlib.h> /* for size_t */
+
+/**
+ * \typedef ThreadPool_Task 
+ * \brief function executed by a worker: fn(arg, index, worker)
+ */
+typedef void (*ThreadPool_Task)(void *arg, size_t index, int worker) ;
+
+struct ThreadPool ; /* opaque */
+
+/**
+ * \fn int ThreadPool_default_size(void)
+ * \brief number of processors online (at least 1)
+ */
+int ThreadPool_default_size(void) ;
+
+/**
+ * \fn struct ThreadPool *ThreadPool_create(int nthreads)
+ * \brief starts nthreads workers (if nthreads <= 0, ThreadPool_default_size() workers)
+ */
+struct ThreadPool *ThreadPool_create(int nthreads) ;
+
+/**
+ * \fn int ThreadPool_size(struct ThreadPool *pool)
+ * \brief number of workers of the pool 
+ */
+int ThreadPool_size(struct ThreadPool *pool) ;
+
+/**
+ * \fn void ThreadPool_submit(struct ThreadPool *pool, ThreadPool_Task fn, void *arg, size_t index)
+ * \brief queues the task fn(arg, index, worker); may be called by any thread, including a worker
+ */
+void ThreadPool_submit(struct ThreadPool *pool, ThreadPool_Task fn, void *arg, size_t index) ;
+
+/**
+ * \fn void ThreadPool_wait(struct ThreadPool *pool)
+ * \brief blocks until all the submitted tasks (and the ones they submitted) are completed
+ */
+void ThreadPool_wait(struct ThreadPool *pool) ;
+
+/**
+ * \fn void ThreadPool_destroy(struct ThreadPool *pool)
+ * \brief waits for the completion of all the tasks then stops and joins the workers
+ */
+void ThreadPool_destroy(struct ThreadPool *pool) ;
+
+#endif /* __THREAD_POOL_h__ */
@@ -0,0 +1,267 @@
+/**
+ * \file Tuning.c
+ * \brief blocking parameters of the engines: derived from the caches of the machine, or measured by an autotuner
+ * and kept in a profile of the host
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Tuning.h
+ */
+
+#include "Tuning.h"
+
+#include "CacheAware.h" /* EditDistance_CA_Packed and EditDistance_CA_Par_Packed, measured */
+#include "CacheOblivious.h" /* EditDistance_CO_Packed, measured */
+#include "Packed.h"
+#include "Workspace.h"
+
+#include <err.h>
+#include <errno.h>
+#include <math.h> /* for sqrt */
+#include <string.h> /* for strcmp */
+#include <time.h> /* for clock_gettime */
+#include <unistd.h> /* for sysconf and gethostname */
+#include <sys/stat.h> /* for mkdir */
+
+struct Tuning _tuning = { 45, 200, 256 } ; /* sqrt(4096 / 2), S and PAR_TILE of the original implementation */
+
+/* sides of the blocks, leaves and tiles tried by Tuning_autotune */
+static const size_t _ca_blocks[] = { 16, 24, 32, 48, 64, 96, 128, 192, 256 } ;
+static const size_t _co_leaves[] = { 32, 48, 64, 96, 128, 192, 256, 384, 512 } ;
+static const size_t _par_tiles[] = { 64, 128, 256, 512, 1024 } ;
+
+/* bases of the random sequences of Tuning_autotune: tables of 2 to 8 MB of cells of 2 bytes, and of 16 M cells for the tiles */
+#define TUNING_BASES 2000
+#define TUNING_PAR_BASES 4000
+#define TUNING_RUNS 3
+
+/* size in bytes of the content of a file of /sys, eg "48K" (0 if it cannot be read) */
+static size_t Tuning_SysSize(const char *dir, const char *name)
+{
+   char path[256], unit = '\0' ;
+   unsigned long value = 0 ;
+   snprintf( path, sizeof(path), "%s/%s", dir, name ) ;
+   FILE *f = fopen( path, "r" ) ;
+   if (f == NULL) return 0 ;
+   if (fscanf( f, "%lu%c", &value, &unit ) < 1) value = 0 ;
+   fclose( f ) ;
+   return (unit == 'K') ? value << 10 : (unit == 'M') ? value << 20 : (unit == 'G') ? value << 30 : value ;
+}
+
+void Tuning_detect(struct CacheGeometry *geometry)
+{
+   memset( geometry, 0, sizeof(*geometry) ) ;
+   for (int i = 0; i < 8; ++i)
+   {  char dir[128], type[32] = "" ;
+      snprintf( dir, sizeof(dir), "/sys/devices/system/cpu/cpu0/cache/index%d", i ) ;
+      size_t level = Tuning_SysSize( dir, "level" ) ;
+      if (level == 0) break ;
+      {  char path[160] ;
+         snprintf( path, sizeof(path), "%s/type", dir ) ;
+         FILE *f = fopen( path, "r" ) ;
+         if (f != NULL)
+         {  if (fscanf( f, "%31s", type ) != 1) type[0] = '\0' ;
+            fclose( f ) ;
+         }
+      }
+      if (strcmp( type, "Instruction" ) == 0) continue ;
+      size_t size = Tuning_SysSize( dir, "size" ) ;
+      if (level == 1) geometry->l1d = size ;
+      else if (level == 2) geometry->l2 = size ;
+      else if (level == 3) geometry->l3 = size ;
+      if (geometry->line == 0) geometry->line = Tuning_SysSize( dir, "coherency_line_size" ) ;
+   }
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+   long value ;
+   if ((geometry->l1d == 0) && ((value = sysconf( _SC_LEVEL1_DCACHE_SIZE )) > 0)) geometry->l1d = (size_t) value ;
+   if ((geometry->l2 == 0) && ((value = sysconf( _SC_LEVEL2_CACHE_SIZE )) > 0)) geometry->l2 = (size_t) value ;
+   if ((geometry->l3 == 0) && ((value = sysconf( _SC_LEVEL3_CACHE_SIZE )) > 0)) geometry->l3 = (size_t) value ;
+   if ((geometry->line == 0) && ((value = sysconf( _SC_LEVEL1_DCACHE_LINESIZE )) > 0)) geometry->line = (size_t) value ;
+#endif
+   if (geometry->line == 0) geometry->line = 64 ;
+   if (geometry->l1d == 0) geometry->l1d = 32 << 10 ;
+   if (geometry->l2 == 0) geometry->l2 = 256 << 10 ;
+}
+
+/* value bounded by min and max */
+static size_t Tuning_Clamp(double value, size_t min, size_t max)
+{
+   return (value < min) ? min : (value > max) ? max : (size_t) value ;
+}
+
+void Tuning_derive(const struct CacheGeometry *geometry, struct Tuning *tuning)
+{
+   tuning->ca_block = Tuning_Clamp( sqrt( geometry->l1d / (2.0 * sizeof(long)) ), 8, 1024 ) ;
+   tuning->co_leaf = Tuning_Clamp( geometry->l1d / (2.0 * geometry->line), 16, TUNING_CO_LEAF_MAX ) ;
+   tuning->par_tile = Tuning_Clamp( sqrt( (double) geometry->l2 ) / 2, 64, 4096 ) ;
+}
+
+char *Tuning_profile_path(void)
+{
+   const char *base = getenv( "XDG_CACHE_HOME" ), *suffix = "" ;
+   if ((base == NULL) || (base[0] == '\0'))
+   {  base = getenv( "HOME" ) ;
+      suffix = "/.cache" ;
+      if ((base == NULL) || (base[0] == '\0')) return NULL ;
+   }
+   char host[256] ;
+   if (gethostname( host, sizeof(host) ) != 0) strcpy( host, "localhost" ) ;
+   host[sizeof(host) - 1] = '\0' ;
+   size_t size = strlen( base ) + strlen( suffix ) + strlen( host ) + 32 ;
+   char *path = (char *) malloc( size ) ;
+   if (path == NULL) { perror("Tuning_profile_path: malloc" ); exit(EXIT_FAILURE); }
+   snprintf( path, size, "%s%s/distanceEdition/%s.profile", base, suffix, host ) ;
+   return path ;
+}
+
+int Tuning_load(const char *path, const struct CacheGeometry *geometry, struct Tuning *tuning)
+{
+   FILE *f = fopen( path, "r" ) ;
+   if (f == NULL) return -1 ;
+   struct CacheGeometry g = { 0, 0, 0, 0 } ;
+   struct Tuning t = { 0, 0, 0 } ;
+   char line[256], key[64] ;
+   unsigned long value ;
+   int valid = 1 ;
+   while (valid && (fgets( line, sizeof(line), f ) != NULL))
+   {  if ((line[0] == '#') || (line[0] == '\n')) continue ;
+      if (sscanf( line, "%63s %lu", key, &value ) != 2) valid = 0 ;
+      else if (strcmp( key, "line" ) == 0) g.line = value ;
+      else if (strcmp( key, "l1d" ) == 0) g.l1d = value ;
+      else if (strcmp( key, "l2" ) == 0) g.l2 = value ;
+      else if (strcmp( key, "l3" ) == 0) g.l3 = value ;
+      else if (strcmp( key, "ca_block" ) == 0) t.ca_block = value ;
+      else if (strcmp( key, "co_leaf" ) == 0) t.co_leaf = value ;
+      else if (strcmp( key, "par_tile" ) == 0) t.par_tile = value ;
+      /* other keys: written by a later version, ignored */
+   }
+   fclose( f ) ;
+   if (! valid || (t.ca_block == 0) || (t.co_leaf == 0) || (t.co_leaf > TUNING_CO_LEAF_MAX) || (t.par_tile == 0)) return -1 ;
+   if ((g.line != geometry->line) || (g.l1d != geometry->l1d) || (g.l2 != geometry->l2) || (g.l3 != geometry->l3)) return -1 ;
+   *tuning = t ;
+   return 0 ;
+}
+
+int Tuning_save(const char *path, const struct CacheGeometry *geometry, const struct Tuning *tuning)
+{
+   size_t size = strlen( path ) + 16 ;
+   char *tmp = (char *) malloc( size ) ;
+   if (tmp == NULL) return -1 ;
+   /* the directory of the profile, and its parent (eg ~/.cache/distanceEdition and ~/.cache) */
+   strcpy( tmp, path ) ;
+   char *last = strrchr( tmp, '/' ) ;
+   if ((last != NULL) && (last != tmp))
+   {  *last = '\0' ;
+      char *parent = strrchr( tmp, '/' ) ;
+      if ((parent != NULL) && (parent != tmp))
+      {  *parent = '\0' ;
+         mkdir( tmp, 0755 ) ; /* if it fails, so does the next one */
+         *parent = '/' ;
+      }
+      if ((mkdir( tmp, 0755 ) != 0) && (errno != EEXIST)) { free( tmp ) ; return -1 ; }
+   }
+   snprintf( tmp, size, "%s.%ld", path, (long) getpid() ) ;
+   FILE *f = fopen( tmp, "w" ) ;
+   if (f == NULL) { free( tmp ) ; return -1 ; }
+   fprintf( f, "# blocking parameters of distanceEdition, measured by distanceEdition --autotune\n" ) ;
+   fprintf( f, "line %zu\nl1d %zu\nl2 %zu\nl3 %zu\n", geometry->line, geometry->l1d, geometry->l2, geometry->l3 ) ;
+   fprintf( f, "ca_block %zu\nco_leaf %zu\npar_tile %zu\n", tuning->ca_block, tuning->co_leaf, tuning->par_tile ) ;
+   int res = (fclose( f ) == 0) ? rename( tmp, path ) : -1 ;
+   if (res != 0)
+   {  int saved = errno ;
+      unlink( tmp ) ;
+      errno = saved ;
+   }
+   free( tmp ) ;
+   return res ;
+}
+
+int Tuning_init(const char *path)
+{
+   struct CacheGeometry geometry ;
+   Tuning_detect( &geometry ) ;
+   Tuning_derive( &geometry, &_tuning ) ;
+   char *host = (path == NULL) ? Tuning_profile_path() : NULL ;
+   if (path == NULL) path = host ;
+   int loaded = (path != NULL) && (Tuning_load( path, &geometry, &_tuning ) == 0) ;
+   free( host ) ;
+   return loaded ;
+}
+
+/* current time in seconds */
+static double Tuning_Now(void)
+{
+   struct timespec t ;
+   clock_gettime( CLOCK_MONOTONIC, &t ) ;
+   return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec ;
+}
+
+/* random bases "ACGT" (a fixed sequence of a linear congruential generator), packed in ps */
+static void Tuning_Random(struct PackedSequence *ps, size_t length, unsigned long seed)
+{
+   char *chars = (char *) malloc( length ) ;
+   if (chars == NULL) { perror("Tuning_autotune: malloc" ); exit(EXIT_FAILURE); }
+   for (size_t k = 0; k < length; ++k)
+   {  seed = seed * 6364136223846793005UL + 1442695040888963407UL ;
+      chars[k] = "ACGT"[(seed >> 33) & 3] ;
+   }
+   Packed_init( ps, chars, length ) ;
+   free( chars ) ;
+}
+
+/* engines measured by Tuning_autotune: the one that uses each parameter */
+enum TuningParameter { TUNING_CA_BLOCK, TUNING_CO_LEAF, TUNING_PAR_TILE } ;
+
+/* minimal time of TUNING_RUNS runs (after one more, not measured) of the engine of parameter p; *distance is set to its result */
+static double Tuning_Measure(enum TuningParameter p, const struct PackedSequence *X, const struct PackedSequence *Y,
+                             int nthreads, struct Workspace *ws, long *distance)
+{
+   double best = 0 ;
+   for (int r = 0; r <= TUNING_RUNS; ++r)
+   {  double start = Tuning_Now() ;
+      *distance = (p == TUNING_CA_BLOCK) ? EditDistance_CA_Packed( X, Y, ws )
+                : (p == TUNING_CO_LEAF) ? EditDistance_CO_Packed( X, Y, ws )
+                : EditDistance_CA_Par_Packed( X, Y, nthreads, ws ) ;
+      double time = Tuning_Now() - start ;
+      if ((r == 1) || ((r > 1) && (time < best))) best = time ;
+   }
+   return best ;
+}
+
+void Tuning_autotune(int nthreads, struct Tuning *tuning, FILE *log)
+{
+   static const char *names[] = { "ca_block", "co_leaf", "par_tile" } ;
+   const size_t *candidates[] = { _ca_blocks, _co_leaves, _par_tiles } ;
+   const size_t count[] = { sizeof(_ca_blocks) / sizeof(size_t), sizeof(_co_leaves) / sizeof(size_t), sizeof(_par_tiles) / sizeof(size_t) } ;
+   struct Tuning saved = _tuning ;
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   *tuning = _tuning ;
+   for (int p = TUNING_CA_BLOCK; p <= TUNING_PAR_TILE; ++p)
+   {  struct PackedSequence X, Y ;
+      size_t bases = (p == TUNING_PAR_TILE) ? TUNING_PAR_BASES : TUNING_BASES ;
+      Tuning_Random( &X, bases, 1 ) ;
+      Tuning_Random( &Y, bases, 2 ) ;
+      size_t *value = (p == TUNING_CA_BLOCK) ? &_tuning.ca_block : (p == TUNING_CO_LEAF) ? &_tuning.co_leaf : &_tuning.par_tile ;
+      size_t *best = (p == TUNING_CA_BLOCK) ? &tuning->ca_block : (p == TUNING_CO_LEAF) ? &tuning->co_leaf : &tuning->par_tile ;
+      double best_time = 0 ;
+      long expected = -1 ;
+      for (size_t k = 0; k < count[p]; ++k)
+      {  long distance ;
+         *value = candidates[p][k] ;
+         double time = Tuning_Measure( p, &X, &Y, nthreads, &ws, &distance ) ;
+         if (log != NULL) fprintf( log, "%s %zu %.6f\n", names[p], *value, time ) ;
+         if (expected < 0) expected = distance ;
+         else if (distance != expected)
+            errx(1, "Tuning_autotune: %s %zu computes the distance %ld instead of %ld", names[p], *value, distance, expected) ;
+         if ((k == 0) || (time < best_time))
+         {  best_time = time ;
+            *best = *value ;
+         }
+      }
+      _tuning = saved ; /* the next parameter is measured with the others unchanged */
+      Packed_free( &X ) ;
+      Packed_free( &Y ) ;
+   }
+   Workspace_release( &ws ) ;
+   _tuning = saved ;
+}
@@ -0,0 +1,115 @@
+/**
+ * \file Tuning.h
+ * \brief blocking parameters of the engines: derived from the caches of the machine, or measured by an autotuner
+ * and kept in a profile of the host
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * The side of the blocks of EditDistance_CA, of the leaf blocks of EditDistance_CO and of the tiles of
+ * EditDistance_CA_Par depend on the sizes of the caches, from 32 to 80 KB for the L1D and from 256 KB to 2 MB
+ * for the L2 of the machines we run on. They are read by the engines in _tuning, at the beginning of each computation:
+ *   - by default, the values of the original implementation (a cache of 4096 bytes, leaf blocks of 200 bases,
+ *     tiles of 256 bases);
+ *   - after Tuning_init, values derived from the caches of the machine (read in /sys, else by sysconf),
+ *     replaced by the ones of the profile of the host if it has one for the same caches;
+ *   - Tuning_autotune measures the engines on random sequences for a few candidates of each parameter and
+ *     keeps the fastest ones, which Tuning_save writes in the profile (distanceEdition --autotune).
+ * A profile is a text file of lines "key value": the sizes of the caches it was measured with (line, l1d, l2,
+ * l3), then the parameters (ca_block, co_leaf, par_tile); the lines starting by '#' are comments.
+ */
+
+#ifndef __TUNING_h__
+#define __TUNING_h__
+
+#include <stdio.h>  /* for FILE */
+#include <stdlib.h> /* for size_t */
+
+/** \def TUNING_CO_LEAF_MAX
+ * \brief maximal side of the leaf blocks of EditDistance_CO (the leaves are computed in buffers on the stack)
+ */
+#define TUNING_CO_LEAF_MAX 512
+
+/**
+ * \struct CacheGeometry
+ * \brief sizes in bytes of the cache line and of the data caches of a processor (0 if unknown)
+ */
+struct CacheGeometry
+{  size_t line ; /*!< cache line */
+   size_t l1d ;  /*!< level 1 data cache */
+   size_t l2 ;   /*!< level 2 cache */
+   size_t l3 ;   /*!< level 3 cache */
+} ;
+
+/**
+ * \struct Tuning
+ * \brief blocking parameters of the engines, in bases
+ */
+struct Tuning
+{  size_t ca_block ; /*!< side of the blocks of EditDistance_CA */
+   size_t co_leaf ;  /*!< maximal side of the leaf blocks of EditDistance_CO (at most TUNING_CO_LEAF_MAX) */
+   size_t par_tile ; /*!< minimal side of the tiles of EditDistance_CA_Par */
+} ;
+
+/**
+ * \var _tuning
+ * \brief the parameters used by the engines; must not be changed while an engine runs
+ */
+extern struct Tuning _tuning ;
+
+/**
+ * \fn void Tuning_detect(struct CacheGeometry *geometry)
+ * \brief the caches of the processor: the ones of cpu0 in /sys/devices/system/cpu, else the ones given by sysconf,
+ * else a line of 64 bytes, a L1D of 32 KB and a L2 of 256 KB
+ */
+void Tuning_detect(struct CacheGeometry *geometry) ;
+
+/**
+ * \fn void Tuning_derive(const struct CacheGeometry *geometry, struct Tuning *tuning)
+ * \brief parameters derived from the caches, without measure:
+ * blocks of EditDistance_CA of sqrt(l1d / (2 sizeof(long))) bases (the formula of the original implementation, for the
+ * actual L1D: 45 for 32 KB),
+ * leaf blocks whose column of cells (one line per cell) holds in half the L1D, tiles of sqrt(l2) / 2 bases
+ */
+void Tuning_derive(const struct CacheGeometry *geometry, struct Tuning *tuning) ;
+
+/**
+ * \fn char *Tuning_profile_path(void)
+ * \brief the profile of the host: $XDG_CACHE_HOME/distanceEdition/hostname.profile, or
+ * $HOME/.cache/distanceEdition/hostname.profile (allocated by malloc); NULL if there is no home directory
+ */
+char *Tuning_profile_path(void) ;
+
+/**
+ * \fn int Tuning_load(const char *path, const struct CacheGeometry *geometry, struct Tuning *tuning)
+ * \brief reads the parameters of the profile path in tuning, if it was measured with the caches geometry;
+ * 0 on success, -1 if the file cannot be read, is invalid or was measured with other caches (tuning unchanged)
+ */
+int Tuning_load(const char *path, const struct CacheGeometry *geometry, struct Tuning *tuning) ;
+
+/**
+ * \fn int Tuning_save(const char *path, const struct CacheGeometry *geometry, const struct Tuning *tuning)
+ * \brief writes the profile path (and its directory if needed): replaced at once, by rename;
+ * 0 on success, -1 with errno set on failure
+ */
+int Tuning_save(const char *path, const struct CacheGeometry *geometry, const struct Tuning *tuning) ;
+
+/**
+ * \fn int Tuning_init(const char *path)
+ * \brief sets _tuning from the caches of the machine (Tuning_detect, Tuning_derive), then from the profile path
+ * (the one of the host if NULL) if it exists for these caches; 1 if the profile was loaded, else 0
+ */
+int Tuning_init(const char *path) ;
+
+/**
+ * \fn void Tuning_autotune(int nthreads, struct Tuning *tuning, FILE *log)
+ * \brief measures the candidates of each parameter on random sequences and sets tuning to the fastest ones
+ * \param nthreads : threads of EditDistance_CA_Par, for the side of its tiles
+ * \param log : if not NULL, one line per candidate: parameter, value, minimal time of the runs in seconds
+ *
+ * Each candidate is timed on the engine that uses it (EditDistance_CA, EditDistance_CO, EditDistance_CA_Par),
+ * on tables larger than the L2, the other parameters being those of _tuning; the runs take a few seconds.
+ * _tuning is restored on return. Exits if the candidates do not all compute the same distance.
+ */
+void Tuning_autotune(int nthreads, struct Tuning *tuning, FILE *log) ;
+
+#endif /* __TUNING_h__ */
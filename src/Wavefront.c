@@ -0,0 +1,205 @@
+/**
+ * \file Wavefront.c
+ * \brief wavefront algorithm (WFA, diagonal transition) that computes the distance between two similar genetic
+ * sequences in O((m+n) + s^2/indel) time, s being the distance
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Documentation: see Wavefront.h
+ */
+
+#include "Wavefront.h"
+#include "Banded.h" /* DISTANCE_ABOVE_MAX */
+#include "Scoring.h" /* costs of the operations */
+#include "PerfCounters.h" /* marks of the phases for the hardware counters */
+#include "Progress.h" /* count of the cells computed */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for memcpy */
+#include <stdint.h>
+
+#include "characters_to_base.h" /* enum Base */
+
+/** \def WFA_NONE
+ * \brief row of a diagonal not reached at this cost
+ */
+#define WFA_NONE (-1L)
+
+/** \def WFA_INITIAL
+ * \brief number of diagonals on each side of the diagonal 0 in the first wavefronts, doubled when they are reached
+ */
+#define WFA_INITIAL 256
+
+/* EditDistance_WFA_mismatch : cf .h for specification
+ */
+long EditDistance_WFA_mismatch(void)
+{
+   long x = _scoring.sub[ADENINE][CYTOSINE] ;
+   if ((_scoring.gap_open != 0) || (x <= 0)) return 0 ;
+   for (int a = ADENINE; a <= UNKOWN_BASE; ++a)
+      for (int b = ADENINE; b <= UNKOWN_BASE; ++b)
+      {  long c = _scoring.sub[a][b] ;
+         int known = (a <= THYMINE) && (b <= THYMINE) ; /* compared by the words of 2 bits */
+         if (known ? (c != ((a == b) ? 0 : x)) : ((c != 0) && (c != x))) return 0 ;
+      }
+   return x ;
+}
+
+/* EditDistance_WFA_available : cf .h for specification
+ */
+int EditDistance_WFA_available(void)
+{
+   return EditDistance_WFA_mismatch() != 0 ;
+}
+
+/* the codes of the bases p .. p+31 of ps (2 bits each, the base p in the bits 0-1); 0 beyond the words of ps */
+static inline uint64_t WFA_Code(const struct PackedSequence *ps, size_t p)
+{
+   size_t w = p / 32, s = p % 32 ;
+   uint64_t c = ps->code[w] >> (2 * s) ;
+   if ((s != 0) && (w + 1 < (ps->length + 31) / 32)) c |= ps->code[w + 1] << (64 - 2 * s) ;
+   return c ;
+}
+
+/* the rare bits of the bases p .. p+31 of ps (the base p in the bit 0) */
+static inline uint32_t WFA_Rare(const struct PackedSequence *ps, size_t p)
+{
+   size_t w = p / 64, s = p % 64 ;
+   uint64_t r = ps->rare[w] >> s ;
+   if ((s > 32) && (w + 1 < (ps->length + 63) / 64)) r |= ps->rare[w + 1] << (64 - s) ;
+   return (uint32_t) r ;
+}
+
+/* number of bases of cost 0 from X[i] and Y[j] along the diagonal, at most limit: 32 bases per step */
+static inline size_t WFA_Extend(const struct PackedSequence *X, size_t i, const struct PackedSequence *Y, size_t j, size_t limit)
+{
+   size_t l = 0 ;
+   while (l < limit)
+   {  uint64_t d = WFA_Code( X, i + l ) ^ WFA_Code( Y, j + l ) ;
+      d = (d | (d >> 1)) & 0x5555555555555555ULL ; /* bit 2b: the codes of the bases b differ */
+      uint32_t r = WFA_Rare( X, i + l ) | WFA_Rare( Y, j + l ) ;
+      size_t first_diff = (d != 0) ? (size_t) __builtin_ctzll( d ) / 2 : 32 ;
+      size_t first_rare = (r != 0) ? (size_t) __builtin_ctz( r ) : 32 ;
+      if ((r != 0) && (first_rare <= first_diff)) /* N or U (even with a code that differs): its cost, one base */
+      {  l += first_rare ;
+         if ((l >= limit) || (_scoring.sub[Packed_base( X, i + l )][Packed_base( Y, j + l )] != 0)) break ;
+         ++l ;
+         continue ;
+      }
+      l += first_diff ;
+      if (first_diff < 32) break ;
+   }
+   return (l < limit) ? l : limit ;
+}
+
+/**
+ * \struct WFA_Waves
+ * \brief the wavefronts of the costs s-W+1 .. s: the one of the cost c in row[c % W][k + cap], k = lo[c % W] .. hi[c % W]
+ * (empty if lo > hi)
+ */
+struct WFA_Waves
+{  long *row ;     /*!< W rows of 2*cap+1 diagonals */
+   long *lo, *hi ; /*!< the diagonals of each wavefront */
+   long cap ;      /*!< the diagonals -cap .. cap are in the rows */
+   int W ;         /*!< number of wavefronts kept */
+   int slot ;      /*!< slot of ws of row (0 or 1) */
+} ;
+
+/* the row of the wavefront of the cost c, indexed by the diagonal */
+static inline long *WFA_Row(const struct WFA_Waves *w, long c)
+{
+   return w->row + (size_t) (c % w->W) * (size_t) (2 * w->cap + 1) + w->cap ;
+}
+
+/* doubles the diagonals of the rows, in the other slot of ws (the wavefronts are copied) */
+static void WFA_Grow(struct WFA_Waves *w, long s, struct Workspace *ws)
+{
+   struct WFA_Waves old = *w ;
+   w->cap = 2 * old.cap ;
+   w->slot = 1 - old.slot ;
+   w->row = (long *) Workspace_get( ws, w->slot, (size_t) w->W * (size_t) (2 * w->cap + 1) * sizeof(long) ) ;
+   for (long c = (s >= w->W) ? s - w->W + 1 : 0; c < s; ++c)
+   {  int t = (int) (c % w->W) ;
+      if (w->lo[t] <= w->hi[t])
+         memcpy( WFA_Row( w, c ) + w->lo[t], WFA_Row( &old, c ) + w->lo[t], (size_t) (w->hi[t] - w->lo[t] + 1) * sizeof(long) ) ;
+   }
+}
+
+/* EditDistance_WFA_Packed : cf .h for specification
+ */
+long EditDistance_WFA_Packed(const struct PackedSequence *X, const struct PackedSequence *Y, long max_distance, struct Workspace *ws)
+{
+   const long m = (long) X->length, n = (long) Y->length ;
+   const long x = EditDistance_WFA_mismatch(), g = _scoring.indel ;
+   const long k_end = n - m ;
+   struct WFA_Waves w ;
+   w.W = (int) ((x > g) ? x : g) + 1 ;
+   w.cap = WFA_INITIAL ;
+   w.slot = 0 ;
+   w.row = (long *) Workspace_get( ws, 0, (size_t) w.W * (size_t) (2 * w.cap + 1) * sizeof(long) ) ;
+   w.lo = (long *) Workspace_get( ws, 2, 2 * (size_t) w.W * sizeof(long) ) ;
+   w.hi = w.lo + w.W ;
+   PerfCounters_phase( PERF_FILL ) ;
+
+   for (long s = 0; (max_distance < 0) || (s <= max_distance); ++s)
+   {  int t = (int) (s % w.W) ;
+      long lo, hi ;
+      if (s == 0) lo = hi = 0 ;
+      else
+      {  int have_x = (s >= x) && (w.lo[(s - x) % w.W] <= w.hi[(s - x) % w.W]) ;
+         int have_g = (s >= g) && (w.lo[(s - g) % w.W] <= w.hi[(s - g) % w.W]) ;
+         lo = m + n + 1 ; hi = -lo ;
+         if (have_x) { lo = w.lo[(s - x) % w.W] ; hi = w.hi[(s - x) % w.W] ; }
+         if (have_g)
+         {  if (w.lo[(s - g) % w.W] - 1 < lo) lo = w.lo[(s - g) % w.W] - 1 ;
+            if (w.hi[(s - g) % w.W] + 1 > hi) hi = w.hi[(s - g) % w.W] + 1 ;
+         }
+         if (lo < -m) lo = -m ;
+         if (hi > n) hi = n ;
+      }
+      w.lo[t] = 1 ; w.hi[t] = 0 ; /* empty while it is computed: not copied by WFA_Grow */
+      if (lo > hi) continue ;
+      while ((-lo > w.cap) || (hi > w.cap)) WFA_Grow( &w, s, ws ) ;
+
+      long *cur = WFA_Row( &w, s ) ;
+      const long *mx = (s >= x) ? WFA_Row( &w, s - x ) : NULL ;
+      const long *mg = (s >= g) ? WFA_Row( &w, s - g ) : NULL ;
+      long lo_x = (mx != NULL) ? w.lo[(s - x) % w.W] : 1, hi_x = (mx != NULL) ? w.hi[(s - x) % w.W] : 0 ;
+      long lo_g = (mg != NULL) ? w.lo[(s - g) % w.W] : 1, hi_g = (mg != NULL) ? w.hi[(s - g) % w.W] : 0 ;
+      for (long k = lo; k <= hi; ++k)
+      {  long i = WFA_NONE, v ;
+         if (s == 0) i = 0 ;
+         if ((k >= lo_x) && (k <= hi_x) && ((v = mx[k]) != WFA_NONE) && (v < m) && (v + k < n)) i = v + 1 ;  /* substitution */
+         if ((k - 1 >= lo_g) && (k - 1 <= hi_g) && ((v = mg[k - 1]) != WFA_NONE) && (v + k <= n) && (v > i)) i = v ; /* insertion */
+         if ((k + 1 >= lo_g) && (k + 1 <= hi_g) && ((v = mg[k + 1]) != WFA_NONE) && (v < m) && (v + 1 > i)) i = v + 1 ; /* deletion */
+         if (i != WFA_NONE)
+         {  long limit = (m - i < n - i - k) ? m - i : n - i - k ;
+            i += (long) WFA_Extend( X, (size_t) i, Y, (size_t) (i + k), (size_t) limit ) ;
+         }
+         cur[k] = i ;
+      }
+      Progress_cells( (uint64_t) (hi - lo + 1) ) ;
+      while ((lo <= hi) && (cur[lo] == WFA_NONE)) ++lo ; /* the diagonals not reached are not kept */
+      while ((lo <= hi) && (cur[hi] == WFA_NONE)) --hi ;
+      w.lo[t] = lo ;
+      w.hi[t] = hi ;
+      if ((k_end >= lo) && (k_end <= hi) && (cur[k_end] == m)) return s ;
+   }
+   return DISTANCE_ABOVE_MAX ;
+}
+
+/* EditDistance_WFA : cf .h for specification
+ */
+long EditDistance_WFA(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance)
+{
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   struct PackedSequence X, Y ;
+   Packed_init( &X, A, lengthA ) ;
+   Packed_init( &Y, B, lengthB ) ;
+   long res = EditDistance_WFA_Packed( &X, &Y, max_distance, &ws ) ;
+   Packed_free( &X ) ;
+   Packed_free( &Y ) ;
+   Workspace_release( &ws ) ;
+   return res ;
+}
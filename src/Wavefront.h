@@ -0,0 +1,62 @@
+/**
+ * \file Wavefront.h
+ * \brief wavefront algorithm (WFA, diagonal transition) that computes the distance between two similar genetic
+ * sequences in O((m+n) + s^2/indel) time, s being the distance
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Instead of the cells of the table, the wavefront algorithm computes, for each cost s = 0, 1, 2 ... and each
+ * diagonal k = j-i, the furthest row M_s[k] reached on the diagonal k by an alignment of cost s, after the
+ * extension of the matches (the bases of cost 0, free to follow):
+ *    M_s[k] = extend( max( M_{s-x}[k] + 1,        a substitution, of cost x
+ *                          M_{s-g}[k-1],          an insertion, of cost g = indel
+ *                          M_{s-g}[k+1] + 1 ) )   a deletion
+ * until M_s[n-m] = m: the distance is then s. The wavefront of the cost s has at most 2s/g+1 diagonals, so that
+ * only O(s^2/g) cells and the extensions along the diagonals are computed, instead of the m n cells of the table.
+ * The extensions compare 32 bases at once on the packed sequences (a xor of the words of 2 bits per base, the first
+ * difference by a count of the trailing zeros); the rare bases N and U are compared one by one.
+ * Only the wavefronts of the costs s-x .. s are kept: the memory is linear (distance only).
+ *
+ * The costs are those of _scoring (cf Scoring.h), if they are of the form of the costs of Globals.h: linear gaps,
+ * 0 between two equal bases A, C, G or T, and the same cost x > 0 for all the other substitutions that do not
+ * cost 0 (eg N, of cost 1 as the other substitutions by default, or the unit costs), cf EditDistance_WFA_available.
+ */
+
+#ifndef __WAVEFRONT_h__
+#define __WAVEFRONT_h__
+
+#include "Workspace.h" /* scratch buffers reused between computations */
+#include "Packed.h" /* sequences packed on 2 bits per base */
+
+/**
+ * \fn long EditDistance_WFA_mismatch(void)
+ * \brief the cost x of the substitutions that are not free in _scoring, 0 if its costs are not of the form computed
+ * by EditDistance_WFA (cf above); the wavefronts of the costs s-max(x, indel) .. s are kept
+ */
+long EditDistance_WFA_mismatch(void) ;
+
+/**
+ * \fn int EditDistance_WFA_available(void)
+ * \brief 1 iff the costs of _scoring are of the form computed by EditDistance_WFA (cf above), else 0
+ */
+int EditDistance_WFA_available(void) ;
+
+/**
+ * \fn long EditDistance_WFA(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance);
+ * \brief computes the edit distance between A[0 .. lengthA-1] and B[0 .. lengthB-1] by the wavefronts of the costs
+ * up to max_distance (none if max_distance < 0)
+ * \return :  edit distance between A and B if it is <= max_distance (or max_distance < 0), else DISTANCE_ABOVE_MAX
+ * (cf Banded.h)
+ *
+ * The chars that are not bases are skipped (cf Packed_init).
+ */
+long EditDistance_WFA(char* A, size_t lengthA, char* B, size_t lengthB, long max_distance);
+
+/**
+ * \fn long EditDistance_WFA_Packed(const struct PackedSequence *A, const struct PackedSequence *B, long max_distance, struct Workspace *ws);
+ * \brief same as EditDistance_WFA on sequences already packed (cf Packed_init), the wavefronts being taken in ws
+ * (slots 0 to 2)
+ */
+long EditDistance_WFA_Packed(const struct PackedSequence *A, const struct PackedSequence *B, long max_distance, struct Workspace *ws);
+
+#endif /* __WAVEFRONT_h__ */
@@ -0,0 +1,35 @@
+/**
+ * \file Workspace.c
+ * \brief scratch buffers reused by successive distance computations 
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * Documentation: see Workspace.h
+ */
+
+#include "Workspace.h"
+
+#include <stdio.h>  
+#include <stdlib.h> 
+
+void *Workspace_get(struct Workspace *ws, int k, size_t bytes)
+{
+   if (bytes > ws->size[k]) 
+   {  size_t size = (bytes > 2 * ws->size[k]) ? bytes : 2 * ws->size[k] ; /* amortized growth */
+      free( ws->slot[k] ) ; /* the content is not kept: no copy by realloc */
+      ws->slot[k] = malloc( size ) ;
+      if (ws->slot[k] == NULL) { perror("Workspace_get: malloc" ); exit(EXIT_FAILURE); }
+      ws->size[k] = size ;
+   }
+   return ws->slot[k] ;
+}
+
+void Workspace_release(struct Workspace *ws)
+{
+   for (int k = 0; k < WORKSPACE_SLOTS; ++k) 
+   {  free( ws->slot[k] ) ;
+      ws->slot[k] = NULL ;
+      ws->size[k] = 0 ;
+   }
+   Arena_release( &ws->arena ) ;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file Workspace.h
+ * \brief scratch buffers reused by successive distance computations (eg by a worker thread in batch mode)
+ * \version 0.1
+ * \date 17/10/2026 
+ *
+ * A workspace has a few slots; each slot is a buffer that only grows: a computation asks for 
+ * the size it needs and gets the buffer of the previous computation if it is large enough.
+ * A workspace also has an arena (cf Arena.h), for the tables of the full table engines and the boundaries
+ * of the tiled one. A workspace is not shared: one per thread.
+ */
+
+#ifndef __WORKSPACE_h__
+#define __WORKSPACE_h__
+
+#include <stdlib.h> /* for size_t */
+#include "Arena.h" /* one mapping for the tables */
+
+/** \def WORKSPACE_SLOTS
+ * \brief number of buffers of a workspace (the engines use at most 4: bases of X and Y, and 2 arrays)
+ */
+#define WORKSPACE_SLOTS 4
+
+/**
+ * \struct Workspace 
+ * \brief buffers slot[k] of size[k] bytes, k = 0 .. WORKSPACE_SLOTS-1, and the arena of the tables
+ */
+struct Workspace 
+{  void *slot[WORKSPACE_SLOTS] ;
+   size_t size[WORKSPACE_SLOTS] ;
+   struct Arena arena ;
+} ;
+
+/**
+ * \def WORKSPACE_INITIALIZER 
+ * \brief empty workspace (no buffer allocated)
+ */
+#define WORKSPACE_INITIALIZER { { NULL }, { 0 }, ARENA_INITIALIZER }
+
+/**
+ * \fn void *Workspace_get(struct Workspace *ws, int k, size_t bytes)
+ * \brief returns the buffer of slot k, reallocated if it has less than bytes bytes 
+ * (its content is then lost); exits on allocation failure
+ */
+void *Workspace_get(struct Workspace *ws, int k, size_t bytes) ;
+
+/**
+ * \fn void Workspace_release(struct Workspace *ws)
+ * \brief frees all the buffers and the arena: ws is then empty and may be reused
+ */
+void Workspace_release(struct Workspace *ws) ;
+
+#endif /* __WORKSPACE_h__ */
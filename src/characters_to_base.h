@@ -42,14 +42,16 @@ enum Base
 static enum Base  _base_match[256] = { SKIP_BASE }; /* initially all chars are ignored */
 
 /**
- * \fn static void _init_base_match()
+ * \fn static inline void _init_base_match()
  * \brief definition of the  mapping from char to base
  *
- * Has to be called once before any computation for identification of a char as a base
+ * Has to be called once before any computation for identification of a char as a base.
+ * The other chars are already mapped to SKIP_BASE by the initialization of _base_match: 
+ * they are not rewritten, so that a thread may call _init_base_match() while another one 
+ * reads _base_match (batch mode).
  */
-static void  _init_base_match() /* initialisation of _base_match array for correspondence from char to base */
+static inline void  _init_base_match() /* initialisation of _base_match array for correspondence from char to base */
 { 
-   for (int c = 0; c < 256; ++c) _base_match[c] = SKIP_BASE ;
    _base_match['a'] = ADENINE ;
    _base_match['A'] = ADENINE ;
    _base_match['c'] = CYTOSINE ;
@@ -91,13 +93,32 @@ static void  _init_base_match() /* initialisation of _base_match array for corre
  */
 #define isSameBase(a,b)	( _base_match[a] == _base_match[b] )
 
+/**
+ * \fn static size_t _compact_bases(const char *S, size_t length, unsigned char *out)
+ * \brief stores in out[] the bases (enum Base) of S[0 .. length-1], skipping the chars that are not bases
+ * \param S : array of char (eg a subsequence of a FASTA file)
+ * \param length : number of chars in S
+ * \param out : array of at least length elements that receives the bases
+ * \return the number of bases written in out
+ *
+ * _init_base_match() must have been called before.
+ */
+static inline size_t _compact_bases(const char *S, size_t length, unsigned char *out)
+{  size_t n = 0 ;
+   for (size_t k = 0; k < length; ++k)
+   {  enum Base b = CharToBase((unsigned char) S[k]) ;
+      if (b != SKIP_BASE) out[n++] = (unsigned char) b ;
+   }
+   return n ;
+}
+
 /** \enum BASE_ERROR_TREATMENT_MODE
  * \brief  BASE_ERROR_TREATMENT defines way a char not in AaCcGgTtUuNn is processed; either IGNORED (default), or WARNING (prints a message on stderr), or EROOR (stops execution). 
  */
 enum BASE_ERROR_TREATMENT_MODE { IGNORED = 0, WARNING = 1, ERROR=2  } ;
 
 /** 
- * \fn void ManageBaseError(char c)
+ * \fn static inline void ManageBaseError(char c)
  * \brief according to BASE_ERROR_TREATMENT prints on stderr either nothing, or a warning or an error if the char passed as argument is not a base (known or unknown) nor a space char
  * \param c the character 
  *
@@ -107,7 +128,7 @@ enum BASE_ERROR_TREATMENT_MODE { IGNORED = 0, WARNING = 1, ERROR=2  } ;
  *   BASE_ERROR   : if c is neither a base nor a space, then prints an error with c on stderr and exit
  *   default : does nothing (just return)
 */
-void ManageBaseError(char c)
+static inline void ManageBaseError(char c)
 { 
    #ifdef BASE_ERROR_TREATMENT
    {  if (isBase(c)) return ; // no error
@@ -0,0 +1,341 @@
+/**
+ * \file distanceBench.c
+ * \brief benchmark of the engines of the distance over a sweep of sizes of sequences
+ * \version 0.1
+ * \date 17/10/2026
+ *
+ * Usage : distanceBench [options] [file_1 begin_1 file_2 begin_2]
+ * cf function usage below.
+ *
+ * For each size L of the sweep, the sequences are the L chars of file_i from position begin_i (by default the
+ * two SARS-CoV-2 genomes of the tests), packed once. Each engine (cf Engine.h: all the engines built in the binary,
+ * including the future ones) is run in a child process, so that its peak resident memory is its own:
+ * warmup runs, then repeat runs whose wall times are sent to the parent by a pipe.
+ * An engine is skipped if its footprint exceeds the memory limit, or if its median time, extrapolated from the 
+ * previous size in proportion to the number of cells, exceeds the time budget. The distance is checked against the one of the fastest linear space engine: the exit status is 1 if
+ * an engine computes another distance. With --counters, the hardware counters of the measured runs (cf PerfCounters.h)
+ * are added per cell, for all the phases and for the fill of the table only.
+ * The blocking parameters are those of distanceEdition: the profile of the host, if any (cf Tuning.h).
+ */
+
+#include "Engine.h" // the engines, their names and footprints
+#include "Banded.h" // DISTANCE_ABOVE_MAX
+#include "SequenceFile.h" // files mapped in virtual memory
+#include "Packed.h" // sequences packed on 2 bits per base
+#include "ThreadPool.h" // ThreadPool_default_size
+#include "PerfCounters.h" // hardware counters of the runs (--counters)
+#include "Tuning.h" // blocking parameters of the profile of the host
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <err.h>
+#include <string.h> /* for strtok and strcmp */
+#include <getopt.h> /* for getopt_long */
+#include <time.h> /* for clock_gettime */
+#include <unistd.h> /* for fork and pipe */
+#include <sys/wait.h> /* for wait4 */
+#include <sys/resource.h> /* for struct rusage */
+
+/** \def BENCH_MAX_SIZES
+ * \brief maximal number of sizes of a sweep
+ */
+#define BENCH_MAX_SIZES 64
+
+/** \def BENCH_MAX_REPEAT
+ * \brief maximal number of measured runs per engine and size
+ */
+#define BENCH_MAX_REPEAT 100
+
+/**
+ * \fn void usage(const char *name)
+ * \brief prints how to use the program
+ */
+static void usage(const char *name)
+{  fprintf( stderr,
+"Usage: %s [options] [file_1 begin_1 file_2 begin_2]"
+"\n     runs each engine of the distance on the sequences of L chars of file_i from position begin_i"
+"\n     (default: tests/ba52_recent_omicron.fasta 153 tests/wuhan_hu_1.fasta 116), for each size L of the sweep,"
+"\n     and prints per engine and size: the wall time (minimum and median of the runs), the cell updates per"
+"\n     second (GCUPS, on the median), the peak resident memory of the process of the runs, and the distance"
+"\n     checked against the one of the fastest linear space engine."
+"\nOPTIONS"
+"\n     -s L1,L2,..., --sizes=L1,L2,...   sizes of the sweep (default 100,300,1000,3000,10000,30000)"
+"\n     -e e1,e2,..., --engines=e1,e2,... engines (default: all the ones available, cf distanceEdition --engine)"
+"\n     -w n, --warmup=n                  runs not measured before the measured ones (default 1)"
+"\n     -r n, --repeat=n                  measured runs (default 3, at most %d)"
+"\n     -t n, --threads=n                 threads of the co-par and tiled engines (default: processors online)"
+"\n     -k k, --max-distance=k            bound of the banded engine (not run without it)"
+"\n     -l size, --mem-limit=size         engines whose footprint exceeds size (bytes, or K, M, G) are skipped"
+"\n                                       (default: half the physical memory)"
+"\n     -b s, --time-budget=s             an engine whose median time, extrapolated from the previous size, exceeds"
+"\n                                       s seconds is skipped (default 2)"
+"\n     -f format, --format=format        csv (default) or json"
+"\n     -c, --counters                    adds the counts per cell of the events of PerfCounters.h (cycles,"
+"\n                                       instructions, cache and TLB misses, page faults) during the measured"
+"\n                                       runs, in all the phases and in the fill of the table (empty or null if"
+"\n                                       the event cannot be counted)"
+"\n", name, BENCH_MAX_REPEAT ) ;
+}
+
+/* wall time, in seconds */
+static double Bench_Now(void)
+{
+   struct timespec t ;
+   clock_gettime( CLOCK_MONOTONIC, &t ) ;
+   return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec ;
+}
+
+static int Bench_Compare(const void *a, const void *b)
+{
+   double x = *(const double *) a, y = *(const double *) b ;
+   return (x > y) - (x < y) ;
+}
+
+/* parses a size in bytes with a suffix K, M or G (powers of 1024); 0 if invalid */
+static size_t Bench_Size(const char *s)
+{
+   double size ;
+   char unit = '\0' ;
+   if ((sscanf( s, "%lf%c", &size, &unit ) < 1) || (size < 1) || ((unit != '\0') && (strchr( "KMG", unit ) == NULL))) return 0 ;
+   for (const char *u = "KMG"; (unit != '\0') && (*u != '\0'); ++u)
+   {  size *= 1024 ;
+      if (*u == unit) break ;
+   }
+   return (size_t) size ;
+}
+
+/**
+ * \struct BenchResult
+ * \brief measures of an engine on a size
+ */
+struct BenchResult
+{  double time[BENCH_MAX_REPEAT] ; /*!< wall time of each measured run, sorted */
+   long distance ;                 /*!< distance computed by the runs (the same for all) */
+   long peak_rss ;                 /*!< peak resident memory of the process of the runs, in KB */
+   double per_cell[PERF_EVENTS] ;  /*!< with --counters, count of each event per cell in the runs (-1 if not available) */
+   double fill_per_cell[PERF_EVENTS] ; /*!< idem during the fill of the table only */
+} ;
+
+/* prints the name of the event, with '_' instead of '-', followed by suffix */
+static void Bench_Column(enum PerfEvent e, const char *suffix)
+{
+   for (const char *c = PerfCounters_name( e ); *c != '\0'; ++c) putchar( (*c == '-') ? '_' : *c ) ;
+   fputs( suffix, stdout ) ;
+}
+
+/* runs engine in a child process: warmup runs, then repeat measured runs (counted if counters); 0 on success */
+static int Bench_Run(enum Engine engine, const struct PackedSequence *X, const struct PackedSequence *Y,
+                     long max_distance, int nthreads, int warmup, int repeat, int counters, struct BenchResult *res)
+{
+   int fd[2] ;
+   if (pipe( fd ) != 0) err(1, "pipe") ;
+   fflush( stdout ) ;
+   pid_t pid = fork() ;
+   if (pid == -1) err(1, "fork") ;
+   if (pid == 0) /* the child: the runs */
+   {  close( fd[0] ) ;
+      struct Workspace ws = WORKSPACE_INITIALIZER ;
+      long d = 0 ;
+      for (int r = 0; r < warmup; ++r) d = Engine_distance( engine, X, Y, max_distance, nthreads, &ws ) ;
+      if (counters) PerfCounters_open() ; /* after the warmup, before the workers of the tiled engine */
+      for (int r = 0; r < repeat; ++r)
+      {  double t = Bench_Now() ;
+         d = Engine_distance( engine, X, Y, max_distance, nthreads, &ws ) ;
+         res->time[r] = Bench_Now() - t ;
+      }
+      res->distance = d ;
+      for (int e = 0; e < PERF_EVENTS; ++e)
+      {  double total = PerfCounters_total( PERF_PHASES, e ), fill = PerfCounters_total( PERF_FILL, e ) ;
+         double cells = PerfCounters_cell_count() ;
+         res->per_cell[e] = ((total < 0) || (cells == 0)) ? -1 : total / cells ;
+         res->fill_per_cell[e] = ((fill < 0) || (cells == 0)) ? -1 : fill / cells ;
+      }
+      if (counters) PerfCounters_close() ;
+      Workspace_release( &ws ) ;
+      ssize_t n = write( fd[1], res, sizeof(struct BenchResult) ) ;
+      _exit( (n == (ssize_t) sizeof(struct BenchResult)) ? 0 : 1 ) ;
+   }
+   close( fd[1] ) ;
+   ssize_t n = 0, r ;
+   while ((n < (ssize_t) sizeof(struct BenchResult)) && ((r = read( fd[0], (char *) res + n, sizeof(struct BenchResult) - n )) > 0)) n += r ;
+   close( fd[0] ) ;
+   int status ;
+   struct rusage usage ;
+   if (wait4( pid, &status, 0, &usage ) == -1) err(1, "wait4") ;
+   if ((n != (ssize_t) sizeof(struct BenchResult)) || !WIFEXITED( status ) || (WEXITSTATUS( status ) != 0)) return 1 ;
+   res->peak_rss = usage.ru_maxrss ;
+   qsort( res->time, repeat, sizeof(double), Bench_Compare ) ;
+   return 0 ;
+}
+
+/********************************************************************************/
+
+/** \fn int main(int argc, char *argv[])
+ * \brief main : see function usage for specification
+ */
+int main(int argc, char *argv[])
+{
+   long sizes[BENCH_MAX_SIZES] = { 100, 300, 1000, 3000, 10000, 30000 } ;
+   int nsizes = 6 ;
+   int selected[ENGINE_COUNT] ; /* 1 if the engine is run */
+   int warmup = 1, repeat = 3 ;
+   int nthreads = ThreadPool_default_size() ;
+   long max_distance = -1 ;
+   size_t mem_limit = Engine_memory() / 2 ;
+   double budget = 2 ;
+   int json = 0 ;
+   int counters = 0 ;
+   for (int e = 0; e < ENGINE_COUNT; ++e) selected[e] = (e != ENGINE_AUTO) ;
+   {  static struct option long_options[] =
+      {  { "sizes", required_argument, NULL, 's' },
+         { "engines", required_argument, NULL, 'e' },
+         { "warmup", required_argument, NULL, 'w' },
+         { "repeat", required_argument, NULL, 'r' },
+         { "threads", required_argument, NULL, 't' },
+         { "max-distance", required_argument, NULL, 'k' },
+         { "mem-limit", required_argument, NULL, 'l' },
+         { "time-budget", required_argument, NULL, 'b' },
+         { "format", required_argument, NULL, 'f' },
+         { "counters", no_argument, NULL, 'c' },
+         { NULL, 0, NULL, 0 }
+      } ;
+      int opt ;
+      while ((opt = getopt_long(argc, argv, "s:e:w:r:t:k:l:b:f:c", long_options, NULL)) != -1)
+      {  switch (opt)
+         {  case 's' :
+               nsizes = 0 ;
+               for (char *s = strtok( optarg, "," ); s != NULL; s = strtok( NULL, "," ))
+               {  if ((nsizes == BENCH_MAX_SIZES) || (sscanf( s, "%ld", &sizes[nsizes] ) != 1) || (sizes[nsizes] < 1))
+                     errx(1, "invalid size: %s", s) ;
+                  ++nsizes ;
+               }
+               break ;
+            case 'e' :
+               for (int e = 0; e < ENGINE_COUNT; ++e) selected[e] = 0 ;
+               for (char *s = strtok( optarg, "," ); s != NULL; s = strtok( NULL, "," ))
+               {  enum Engine e = Engine_parse( s ) ;
+                  if ((e == ENGINE_COUNT) || (e == ENGINE_AUTO)) errx(1, "invalid engine: %s", s) ;
+                  selected[e] = 1 ;
+               }
+               break ;
+            case 'w' :
+               if ((sscanf( optarg, "%d", &warmup ) != 1) || (warmup < 0)) errx(1, "invalid number of warmup runs: %s", optarg) ;
+               break ;
+            case 'r' :
+               if ((sscanf( optarg, "%d", &repeat ) != 1) || (repeat < 1) || (repeat > BENCH_MAX_REPEAT))
+                  errx(1, "invalid number of runs: %s", optarg) ;
+               break ;
+            case 't' :
+               if ((sscanf( optarg, "%d", &nthreads ) != 1) || (nthreads < 1)) errx(1, "invalid number of threads: %s", optarg) ;
+               break ;
+            case 'k' :
+               if ((sscanf( optarg, "%ld", &max_distance ) != 1) || (max_distance < 0)) errx(1, "invalid maximal distance: %s", optarg) ;
+               break ;
+            case 'l' :
+               if ((mem_limit = Bench_Size( optarg )) == 0) errx(1, "invalid memory limit: %s", optarg) ;
+               break ;
+            case 'b' :
+               if ((sscanf( optarg, "%lf", &budget ) != 1) || (budget <= 0)) errx(1, "invalid time budget: %s", optarg) ;
+               break ;
+            case 'f' :
+               if (strcmp( optarg, "json" ) == 0) json = 1 ;
+               else if (strcmp( optarg, "csv" ) == 0) json = 0 ;
+               else errx(1, "invalid format: %s (csv or json)", optarg) ;
+               break ;
+            case 'c' :
+               counters = 1 ;
+               break ;
+            default :
+               usage( argv[0] ) ;
+               exit(EXIT_FAILURE);
+         }
+      }
+   }
+   const char *name[2] = { "tests/ba52_recent_omicron.fasta", "tests/wuhan_hu_1.fasta" } ;
+   long begin[2] = { 153, 116 } ;
+   if (argc - optind == 4)
+   {  for (int i = 0; i < 2; ++i)
+      {  name[i] = argv[optind + 2*i] ;
+         if (sscanf( argv[optind + 2*i + 1], "%ld", &begin[i] ) != 1) errx(1, "invalid position: %s", argv[optind + 2*i + 1]) ;
+      }
+   }
+   else if (argc != optind)
+   {  usage( argv[0] ) ;
+      exit(EXIT_FAILURE);
+   }
+   Tuning_init( NULL ) ;
+   struct SequenceFile *file[2] = { SequenceFile_open( name[0] ), SequenceFile_open( name[1] ) } ;
+   enum Engine reference = Engine_available( ENGINE_BITPAR, -1 ) ? ENGINE_BITPAR
+                         : Engine_available( ENGINE_DIFF, -1 ) ? ENGINE_DIFF : ENGINE_LS ;
+   double cell_time[ENGINE_COUNT] = { 0 } ; /* median time per cell of the engine at the previous size */
+
+   if (json) printf( "[" ) ;
+   else
+   {  printf( "engine,size,bases_1,bases_2,threads,runs,time_min_s,time_median_s,gcups,peak_rss_kb,distance,expected,check" ) ;
+      for (int e = 0; counters && (e < PERF_EVENTS); ++e)
+      {  putchar( ',' ) ; Bench_Column( e, "_per_cell" ) ;
+         putchar( ',' ) ; Bench_Column( e, "_fill_per_cell" ) ;
+      }
+      printf( "\n" ) ;
+   }
+   int first = 1 ;
+   int mismatches = 0 ;
+   for (int s = 0; s < nsizes; ++s)
+   {  struct PackedSequence X, Y ;
+      long length[2] = { sizes[s], sizes[s] } ;
+      char *seq[2] ;
+      for (int i = 0; i < 2; ++i) seq[i] = SequenceFile_sequence( file[i], begin[i], &length[i], 0 ) ;
+      Packed_init( &X, seq[0], length[0] ) ;
+      Packed_init( &Y, seq[1], length[1] ) ;
+      struct Workspace ws = WORKSPACE_INITIALIZER ;
+      long expected = Engine_distance( reference, &X, &Y, -1, 1, &ws ) ;
+      Workspace_release( &ws ) ;
+      if ((max_distance >= 0) && (expected > max_distance)) expected = DISTANCE_ABOVE_MAX ;
+      double cells = (double) (X.length + 1) * (double) (Y.length + 1) ;
+
+      for (int e = ENGINE_AUTO + 1; e < ENGINE_COUNT; ++e)
+      {  if (! selected[e] || ! Engine_available( e, max_distance ) || (cell_time[e] * cells > budget)) continue ;
+         if (Engine_footprint( e, X.length, Y.length, max_distance ) > mem_limit) continue ;
+         int threads = ((e == ENGINE_TILED) || (e == ENGINE_CO_PAR) || (e == ENGINE_STRIPED)) ? nthreads : 1 ;
+         struct BenchResult res ;
+         if (Bench_Run( e, &X, &Y, max_distance, threads, warmup, repeat, counters, &res ) != 0)
+         {  fprintf( stderr, "%s: engine %s failed on size %ld\n", argv[0], Engine_name( e ), sizes[s] ) ;
+            cell_time[e] = budget ; /* not run on the larger sizes */
+            continue ;
+         }
+         double median = res.time[repeat / 2] ;
+         double gcups = cells / median * 1e-9 ;
+         cell_time[e] = median / cells ;
+         const char *status = (res.distance == expected) ? "ok" : "MISMATCH" ;
+         mismatches += (res.distance != expected) ;
+         if (json)
+            printf( "%s\n  { \"engine\": \"%s\", \"size\": %ld, \"bases_1\": %zu, \"bases_2\": %zu, \"threads\": %d, \"runs\": %d, "
+                    "\"time_min_s\": %.6f, \"time_median_s\": %.6f, \"gcups\": %.4f, \"peak_rss_kb\": %ld, "
+                    "\"distance\": %ld, \"expected\": %ld, \"check\": \"%s\"",
+                    first ? "" : ",", Engine_name( e ), sizes[s], X.length, Y.length, threads, repeat,
+                    res.time[0], median, gcups, res.peak_rss, res.distance, expected, status ) ;
+         else
+            printf( "%s,%ld,%zu,%zu,%d,%d,%.6f,%.6f,%.4f,%ld,%ld,%ld,%s",
+                    Engine_name( e ), sizes[s], X.length, Y.length, threads, repeat,
+                    res.time[0], median, gcups, res.peak_rss, res.distance, expected, status ) ;
+         for (int c = 0; counters && (c < PERF_EVENTS); ++c)
+         {  double value[2] = { res.per_cell[c], res.fill_per_cell[c] } ;
+            for (int k = 0; k < 2; ++k)
+               if (json)
+               {  printf( ", \"" ) ; Bench_Column( c, k ? "_fill_per_cell\": " : "_per_cell\": " ) ;
+                  if (value[k] < 0) printf( "null" ) ; else printf( "%.6g", value[k] ) ;
+               }
+               else if (value[k] < 0) printf( "," ) ;
+               else printf( ",%.6g", value[k] ) ;
+         }
+         printf( json ? " }" : "\n" ) ;
+         fflush( stdout ) ;
+         first = 0 ;
+      }
+      Packed_free( &X ) ;
+      Packed_free( &Y ) ;
+   }
+   if (json) printf( "\n]\n" ) ;
+   SequenceFile_close_all() ;
+   return (mismatches == 0) ? 0 : 1 ;
+}
@@ -44,19 +44,27 @@ EXAMPLE
  * \brief Primitives pour mapper en mémoire virtuelle une sous-séquence d'un fichier de caractères
  */
 
-// #include "Needleman-Wunsch-recmemo.h" // Recursive implementation of NeedlemanWunsch with memoization
-// #include "Needleman-Wunsch-itmemo.h"
-// #include "CacheAware.h"
-#include "CacheOblivious.h"
+#include "Pair.h" // engine chosen by the options (cf Pair_compute) and output line for a pair
+#include "Engine.h" // all the engines, chosen under a memory budget (--engine, --mem-limit)
+#include "PerfCounters.h" // hardware counters of the engines (--counters)
+#include "Batch.h" // pairs listed in a manifest (--batch)
+#include "Matrix.h" // all-vs-all distances between the records of FASTA files (--matrix)
+#include "SequenceFile.h" // files mapped in virtual memory
+#include "FastaIndex.h" // sequences given by record name and positions of bases (file:record:start-end)
+#include "SequenceStream.h" // sequences read from stdin or a pipe, packed while they are read
+#include "Tuning.h" // blocking parameters for the caches of the machine (--autotune, --profile)
+#include "Scoring.h" // costs of the operations chosen at run time (--scoring)
+#include "Checkpoint.h" // checkpoints of the linear space engines (--checkpoint)
+#include "Progress.h" // reports of the progress of the engine (--progress)
+#include "Striped.h" // pipeline of processes by stripes of columns (--engine=striped, --stripe)
+#include "Anchored.h" // DP between the anchors of similar sequences (--anchor)
+#include "ThreadPool.h"
 
 #include <stdio.h>  
 #include <stdlib.h> 
 #include <err.h> 
-#include <string.h> /* for strchr */
-#include <fcntl.h> /* for open */
-#include <unistd.h> /* for close */
-#include <sys/mman.h> /* for mmap and munmap */
-#include <sys/stat.h> /* for file length */
+#include <string.h> /* for strcmp and strchr */
+#include <getopt.h> /* for getopt_long */
 
 /******************************************************************************/
 
@@ -69,17 +77,23 @@ EXAMPLE
 void usage_and_spec(int argc, char *argv[]) // spécification du programme
 { fprintf ( stderr,
     "%s : bad number of arguments: 6 are required (but this execution is with %d instead).\n"
-    "Usage:   %s  file_1 begin_1 length_1 file_2 begin_2 length_2 \n\n"
+    "Usage:   %s  [options] file_1 begin_1 length_1 file_2 begin_2 length_2 \n"
+    "   or:   %s  [options] file_1:record_1[:start_1-end_1] file_2:record_2[:start_2-end_2] \n"
+    "   or:   %s  [options] --batch=manifest \n"
+    "   or:   %s  [options] --matrix[=phylip|binary] fasta_file [fasta_file] \n\n"
     "%s prints the edit distance between two genetic sequences seq[i] for i=1..2  where \n"
     "seq[i] denotes the sequence of <length_i> char in <file_i> from position <begin_i>." 
-    , argv[0], argc-1, argv[0], argv[0] 
+    , argv[0], argc-1, argv[0], argv[0], argv[0], argv[0], argv[0] 
   ) ;
   
   fprintf ( stderr, "\n"
 "\nNAME"
 "\n     distanceEdition - compute edit distance between two substrings, each from a file"
 "\nSYNOPSIS"
-"\n     distanceEdition file_1 b1 L_1 file_2 b_2 L_2"
+"\n     distanceEdition [options] file_1 b1 L_1 file_2 b_2 L_2"
+"\n     distanceEdition [options] file_1:record_1[:start_1-end_1] file_2:record_2[:start_2-end_2]"
+"\n     distanceEdition [options] --batch=manifest"
+"\n     distanceEdition [options] --matrix[=phylip|binary] fasta_file [fasta_file]"
 "\nDESCRIPTION"
 "\n     distanceEdition computes the edit distance between two arrays of"
 "\n     characters array_file_1[b_1, b_1+L_1( and array_file2[b_2,b_2+L_2( where:"
@@ -95,6 +109,123 @@ void usage_and_spec(int argc, char *argv[]) // spécification du programme
 "\n           editDistance( array_file_1 + b_1, L_1, array_file_2, + b_2, L_2 )"
 "\n        where the extern C function has prototype :"
 "\n           editDistance( char* A, size_t lengthA, char* B, size_t lengthB);"
+"\nOPTIONS"
+"\n     Instead of (file_i, b_i, L_i), a sequence may be given by a region file_i:record_i[:start_i-end_i]:"
+"\n     the bases start_i to end_i (numbered from 1, end_i included) of the record record_i (first word"
+"\n     of its header line) of the FASTA file file_i, or the whole record if start_i-end_i is omitted."
+"\n     The position of the bases in the file is computed from the index file_i.fai (same format as samtools"
+"\n     faidx), built by one pass on file_i and saved at the first use (or by --index)."
+"\n     A file_i may also be - (stdin), a named pipe or a process substitution, eg <(zcat file.fna.gz):"
+"\n     it is then read once, by a thread that reads ahead of the packing of the sequence (2 bits per base),"
+"\n     and only the sequence is kept in memory; two sequences of the same stream may not overlap."
+"\n     --align is not available with such a sequence."
+"\n     -t n, --threads=n"
+"\n        number of threads; by default, the number of processors online."
+"\n     -e engine, --engine=engine"
+"\n        engine of the distance: auto (default), rec, it, co, ca (full table: EditDistance_NW_Rec,"
+"\n        EditDistance_NW_It, EditDistance_CO, EditDistance_CA), co-par (parallel cache oblivious"
+"\n        EditDistance_CO_Par, full table, on the threads), tiled (parallel tiled wavefront"
+"\n        EditDistance_CA_Par, on the threads), ls, diff, bitpar (linear space: EditDistance_LS,"
+"\n        EditDistance_Diff if the costs fit in 8 bits, EditDistance_BitPar for unit costs) or banded"
+"\n        (EditDistance_Banded, with --max-distance), gotoh (affine gaps, EditDistance_Gotoh, linear space),"
+"\n        striped (EditDistance_Striped: one process per stripe of columns, --threads processes, cf --stripe),"
+"\n        wfa (EditDistance_WFA: wavefronts of the costs, O(s^2) for a distance s, for similar sequences);"
+"\n        with --scoring, only ls, banded, gotoh and, for unit costs, bitpar and wfa; with a gap open cost, only gotoh."
+"\n        auto chooses, once the number of bases of the sequences is known, the engine of least estimated time"
+"\n        among those whose memory fits in the limit, but first tries wfa up to the distance where it would be"
+"\n        slower than this engine: the engine only runs if the distance is above."
+"\n     -l size, --mem-limit=size"
+"\n        memory limit for the computation, in bytes or with a suffix K, M or G (powers of 1024);"
+"\n        by default, the physical memory. The program exits with an error instead of being killed"
+"\n        if the engine given by --engine does not fit. In batch and matrix modes, the limit is shared"
+"\n        by the threads."
+"\n     -k k, --max-distance=k"
+"\n        only checks whether the distance is at most k: prints the distance if it is, or \"> k\" else."
+"\n        The computation is restricted to a band around the diagonal (EditDistance_Banded, chosen by"
+"\n        auto unless the band is wider than the table) and is almost linear for similar sequences."
+"\n     -a, --align"
+"\n        prints an optimal alignment (computed in linear space by EditDistance_Align) instead of"
+"\n        the distance only, as one line of 8 fields separated by tabulations:"
+"\n           file_1  begin  end  file_2  begin  end  distance  CIGAR"
+"\n        where [begin, end( are the offsets in the file of the first base and following the last"
+"\n        base of the sequence (including the skipped chars, eg the header line and the '\\n')"
+"\n        and CIGAR is an extended CIGAR string on the bases ('=' match, 'X' substitution,"
+"\n        'I' base of seq 1 not in seq 2, 'D' base of seq 2 not in seq 1), eg 12=1X3I."
+"\n     -b manifest, --batch=manifest"
+"\n        batch mode: computes the pairs given by the lines of the file manifest (stdin if manifest is -),"
+"\n        each line being the 6 arguments file_1 b_1 L_1 file_2 b_2 L_2 (or the 2 regions file_1:record_1[:start_1-end_1]"
+"\n        file_2:record_2[:start_2-end_2]) separated by spaces;"
+"\n        empty lines and lines starting by '#' are ignored."
+"\n        Prints for each pair, in the order of the manifest, the line that would be printed for it"
+"\n        (the distance, \"> k\" or the alignment record) but nothing on stderr."
+"\n        Each file is mapped once; the pairs are computed in parallel by the threads (one thread per pair)"
+"\n        and the results are printed as soon as the previous ones are."
+"\n     -m[format], --matrix[=format]"
+"\n        all-vs-all mode: prints the matrix of the distances between all the records of one or two"
+"\n        multi-record FASTA files (a record is a line \">name ...\" followed by the lines of its sequence)."
+"\n        format is phylip (default: square matrix, one line per record with its name and its distances)"
+"\n        or binary (\"EDMATRIX\", n, the n names, then the n(n-1)/2 distances i < j as 64 bits integers, cf Matrix.h)."
+"\n        The pairs are computed in parallel, one thread per pair; with --max-distance=k, a distance above k is -1."
+"\n     -s scoring, --scoring=scoring"
+"\n        costs of the operations instead of the ones of Globals.h (substitution 1, N 1, insertion 2):"
+"\n        unit (all the costs 1, Levenshtein distance), transition (transitions A-G and C-T 1, transversions 2,"
+"\n        T-U 0, N 1, insertion 2), a list of changes key=value,... of the keys sub, transition, unknown, indel and"
+"\n        open (eg indel=3,transition=1, or open=4,indel=1 for affine gaps: a gap of k bases costs open + k indel),"
+"\n        or a file of lines \"indel k\", \"open k\" and \"x c_A c_C c_G c_T c_U c_N\" (the costs of"
+"\n        the substitutions of the base x, one of ACGTUN, by each base; the matrix must be symmetric)."
+"\n        Not available with --align."
+"\n     -A[k], --anchor[=k]"
+"\n        for similar sequences (eg two genomes of a species): computes the distance between the exact matches"
+"\n        of the k-mers (default 20, 8 .. 32) found once in each sequence, chained along the diagonals, then"
+"\n        checks it in the band of this bound (cf Anchored.h): the result stays exact, and only a small part of the"
+"\n        table is computed. If the anchors do not bound the distance well, the engine computes the whole table."
+"\n        With affine gaps or matches of cost > 0 (cf --scoring), the engine always computes the whole table."
+"\n        Not with --align, --checkpoint and --stripe."
+"\n     -c, --counters"
+"\n        prints on stderr, after the distance, the counts of cycles, instructions, L1D, LLC and dTLB misses"
+"\n        and page faults of the engine (read by perf_event_open), for each of its phases (allocation, fill"
+"\n        of the table, deallocation) and per cell of the table; \"n/a\" for the events that cannot be counted"
+"\n        (no hardware counters, eg in a virtual machine, or /proc/sys/kernel/perf_event_paranoid)."
+"\n        Not available with --align, --batch and --matrix."
+"\n     -C file, --checkpoint=file"
+"\n        saves the frontier of the computation (the row of ls, the differences of diff) in file every"
+"\n        interval seconds, by a thread (the computation does not wait for the disk), and on SIGTERM or SIGINT"
+"\n        before exiting; the file is removed when the distance is printed. Only with the engines ls and diff"
+"\n        (auto: diff if the costs allow it, else ls), not with --align, --batch and --matrix."
+"\n     -I interval, --checkpoint-interval=interval"
+"\n        seconds between two checkpoints (default 600)."
+"\n     -R, --resume"
+"\n        continues the computation from the file of --checkpoint (from the beginning if there is none);"
+"\n        exits with an error if it is the checkpoint of other sequences (compared by hashes), costs or engine."
+"\n     -P[interval], --progress[=interval]"
+"\n        reports on stderr, every interval seconds (default 10), the progress of the engine as a line"
+"\n           progress engine=ls cells=... total=... percent=... gcups=... eta_s=... elapsed_s=..."
+"\n        (the cells of the table computed, of all the table, the cells per ns in the last interval and"
+"\n        the estimated seconds to completion, -1 if unknown), and a last one when the distance is computed."
+"\n        Not available with --align, --batch and --matrix."
+"\n     -F file, --progress-file=file"
+"\n        same as --progress, the reports being written in file in the text format of Prometheus (metrics"
+"\n        distance_edition_cells_done, _cells_total, _progress_ratio, _gcups, _eta_seconds, _elapsed_seconds and _done)."
+"\n     -S s/k, --stripe=s/k"
+"\n        this process is the worker of the stripe s (0 .. k-1) of a pipeline of k distanceEdition --stripe on"
+"\n        several hosts, started with the same sequences (engine striped): it receives the boundary column of"
+"\n        the stripe s-1 on the address of --upstream and sends its own to the stripe s+1 at the address of"
+"\n        --downstream (unix:path for a Unix socket, host:port for TCP, :port to listen on all the interfaces)."
+"\n        Only the last stripe prints the distance. Not with --align, --batch, --matrix and --checkpoint."
+"\n     -U address, --upstream=address"
+"\n        address where the stripe s-1 connects (for s > 0)."
+"\n     -D address, --downstream=address"
+"\n        address of the stripe s+1 (for s < k-1), tried for 60 s."
+"\n     -i, --index"
+"\n        builds the index file.fai of each FASTA file given as argument (distanceEdition --index file...)."
+"\n     -T, --autotune"
+"\n        measures the side of the blocks of ca, of the leaf blocks of co and of the tiles of tiled for a few"
+"\n        candidates each on random sequences (a few seconds), prints the fastest ones on stdout and writes them"
+"\n        in the profile (distanceEdition --autotune [--profile=file] [--threads=n])."
+"\n     -p file, --profile=file"
+"\n        profile of the blocking parameters, read at startup if it was measured with the caches of the machine"
+"\n        (else the parameters are derived from the sizes of the caches), written by --autotune;"
+"\n        by default, $XDG_CACHE_HOME/distanceEdition/hostname.profile or ~/.cache/distanceEdition/hostname.profile."
 "\nEXIT STATUS"
 "\n     The program exits 0 on success, and >0 if an error occurs."
 "\nEXAMPLE"
@@ -110,6 +241,40 @@ void usage_and_spec(int argc, char *argv[]) // spécification du programme
 }    
 
 
+/********************************************************************************/
+
+/**
+ * \fn static int Main_Run(const struct PairOptions *options, const struct PackedSequence packed[2], struct SequenceFile *file[2], char *seq[2], long length[2], const char *checkpoint_path, double checkpoint_interval, int resume, int counters)
+ * \brief computes the distance (or the alignment) of the pair, packed[0] and packed[1] if packed is not NULL, else
+ * seq[0] and seq[1] of file, prints it on stdout (the last stripe only), then releases the checkpoint, the progress
+ * and the files; the packed sequences are left to the caller
+ * \param checkpoint_path : checkpoints every checkpoint_interval seconds if not NULL, from the last one if resume
+ * \param counters : prints the hardware counters of the engine on stderr if 1
+ * \return the exit status of main
+ */
+static int Main_Run(const struct PairOptions *options, const struct PackedSequence packed[2], struct SequenceFile *file[2], char *seq[2], long length[2],
+                    const char *checkpoint_path, double checkpoint_interval, int resume, int counters)
+{
+   struct Checkpoint checkpoint ;
+   if (checkpoint_path != NULL) 
+   {  Checkpoint_init( &checkpoint, checkpoint_path, checkpoint_interval, resume ) ;
+      _checkpoint = &checkpoint ;
+   }
+   struct Workspace ws = WORKSPACE_INITIALIZER ;
+   char *line = (packed != NULL) ? Pair_compute_packed( options, &packed[0], &packed[1], &ws ) 
+                                 : Pair_compute( options, file, seq, length, &ws ) ;
+   if (_checkpoint != NULL) { Checkpoint_free( _checkpoint ) ; _checkpoint = NULL ; } /* checkpoint is on this frame */
+   if (_progress_enabled) Progress_close() ;
+   Workspace_release( &ws ) ;
+   SequenceFile_close_all() ;
+
+   if ((_stripe == NULL) || (_stripe->index + 1 == _stripe->count)) // the last stripe only
+      fputs( line, stdout ) ; // print the distance (or the alignment) on stdout
+   free( line ) ;
+   if (counters) PerfCounters_report( stderr ) ;
+   return 0 ;
+}
+
 /********************************************************************************/
 
 /** \fn int main(int argc, char *argv[])
@@ -119,78 +284,297 @@ void usage_and_spec(int argc, char *argv[]) // spécification du programme
  */
 int main(int argc, char *argv[])
 {
-   if (argc != 7)
-   {   usage_and_spec(argc, argv) ;
-       exit(EXIT_FAILURE);
+   int nthreads = ThreadPool_default_size() ; // number of threads for the computation
+   struct PairOptions options = { -1, 0, 1, ENGINE_AUTO, 0, 0 } ; // distance only, without bound, engine chosen
+   const char *mem_limit = NULL ; // the physical memory if not given
+   char *manifest = NULL ; // batch mode if not NULL
+   int matrix = 0 ; // all-vs-all mode if 1
+   int index = 0 ; // only builds the index of the files if 1
+   int counters = 0 ; // prints the hardware counters of the engine if 1
+   int autotune = 0 ; // only measures the blocking parameters and writes the profile if 1
+   const char *profile = NULL ; // the profile of the host if not given
+   struct Scoring scoring ; // the costs of Globals.h if not given
+   Scoring_default( &scoring ) ;
+   const char *checkpoint_path = NULL ; // no checkpoint if not given
+   double checkpoint_interval = 600 ; // seconds between two checkpoints
+   int resume = 0 ; // continues from the checkpoint if 1
+   double progress = 0 ; // seconds between two reports of the progress, 0 for none
+   const char *progress_path = NULL ; // the reports on stderr if not given
+   struct Stripe stripe = { 0, 0, NULL, NULL } ; // a worker of a pipeline started on its own if count > 0
+   enum MatrixFormat matrix_format = MATRIX_PHYLIP ;
+   {  static struct option long_options[] = 
+      {  { "threads", required_argument, NULL, 't' },
+         { "max-distance", required_argument, NULL, 'k' },
+         { "align", no_argument, NULL, 'a' },
+         { "batch", required_argument, NULL, 'b' },
+         { "matrix", optional_argument, NULL, 'm' },
+         { "index", no_argument, NULL, 'i' },
+         { "engine", required_argument, NULL, 'e' },
+         { "mem-limit", required_argument, NULL, 'l' },
+         { "counters", no_argument, NULL, 'c' },
+         { "autotune", no_argument, NULL, 'T' },
+         { "profile", required_argument, NULL, 'p' },
+         { "scoring", required_argument, NULL, 's' },
+         { "checkpoint", required_argument, NULL, 'C' },
+         { "checkpoint-interval", required_argument, NULL, 'I' },
+         { "resume", no_argument, NULL, 'R' },
+         { "progress", optional_argument, NULL, 'P' },
+         { "progress-file", required_argument, NULL, 'F' },
+         { "stripe", required_argument, NULL, 'S' },
+         { "upstream", required_argument, NULL, 'U' },
+         { "downstream", required_argument, NULL, 'D' },
+         { "anchor", optional_argument, NULL, 'A' },
+         { NULL, 0, NULL, 0 }
+      } ;
+      int opt ;
+      while ((opt = getopt_long(argc, argv, "t:k:ab:m::ie:l:cTp:s:C:I:RP::F:S:U:D:A::", long_options, NULL)) != -1)
+      {  switch (opt)
+         {  case 't' : 
+               if ((sscanf( optarg, "%d", &nthreads ) != 1) || (nthreads < 1))
+                  errx(1, "invalid number of threads: %s", optarg) ;
+               break ;
+            case 'k' : 
+               if ((sscanf( optarg, "%ld", &options.max_distance ) != 1) || (options.max_distance < 0))
+                  errx(1, "invalid maximal distance: %s", optarg) ;
+               break ;
+            case 'a' : 
+               options.align = 1 ;
+               break ;
+            case 'b' : 
+               manifest = optarg ;
+               break ;
+            case 'm' : 
+               matrix = 1 ;
+               if ((optarg == NULL) || (strcmp( optarg, "phylip" ) == 0)) matrix_format = MATRIX_PHYLIP ;
+               else if (strcmp( optarg, "binary" ) == 0) matrix_format = MATRIX_BINARY ;
+               else errx(1, "invalid matrix format: %s (phylip or binary)", optarg) ;
+               break ;
+            case 'i' : 
+               index = 1 ;
+               break ;
+            case 'e' : 
+               options.engine = Engine_parse( optarg ) ;
+               if (options.engine == ENGINE_COUNT) errx(1, "invalid engine: %s", optarg) ;
+               break ;
+            case 'l' : 
+               mem_limit = optarg ;
+               break ;
+            case 'c' : 
+               counters = 1 ;
+               break ;
+            case 'T' : 
+               autotune = 1 ;
+               break ;
+            case 'p' : 
+               profile = optarg ;
+               break ;
+            case 's' : 
+               Scoring_parse( optarg, &scoring ) ;
+               break ;
+            case 'C' : 
+               checkpoint_path = optarg ;
+               break ;
+            case 'I' : 
+               if ((sscanf( optarg, "%lf", &checkpoint_interval ) != 1) || !(checkpoint_interval > 0))
+                  errx(1, "invalid checkpoint interval: %s", optarg) ;
+               break ;
+            case 'R' : 
+               resume = 1 ;
+               break ;
+            case 'P' : 
+               progress = 10 ;
+               if ((optarg != NULL) && ((sscanf( optarg, "%lf", &progress ) != 1) || !(progress > 0)))
+                  errx(1, "invalid progress interval: %s", optarg) ;
+               break ;
+            case 'F' : 
+               progress_path = optarg ;
+               if (progress == 0) progress = 10 ;
+               break ;
+            case 'S' : 
+               if (! Stripe_parse( optarg, &stripe )) errx(1, "invalid stripe: %s (s/k, 0 <= s < k)", optarg) ;
+               break ;
+            case 'U' : 
+               stripe.upstream = optarg ;
+               break ;
+            case 'D' : 
+               stripe.downstream = optarg ;
+               break ;
+            case 'A' : 
+               options.anchor = ANCHOR_K ;
+               if ((optarg != NULL) && ((sscanf( optarg, "%d", &options.anchor ) != 1) || (options.anchor < 8) || (options.anchor > ANCHOR_K_MAX)))
+                  errx(1, "invalid anchor length: %s (8 .. %d)", optarg, ANCHOR_K_MAX) ;
+               break ;
+            default : 
+               usage_and_spec(argc - optind + 1, argv) ;
+               exit(EXIT_FAILURE);
+         }
+      }
+   }
+   options.nthreads = nthreads ;
+   if (! Tuning_init( profile ) && (profile != NULL) && ! autotune)
+      warnx("profile %s not loaded (missing, invalid or measured with other caches)", profile) ;
+   if (autotune) 
+   {  if (argc != optind) 
+      {   usage_and_spec(argc - optind + 1, argv) ;
+          exit(EXIT_FAILURE);
+      }
+      struct CacheGeometry geometry ;
+      struct Tuning tuning ;
+      char *host = (profile == NULL) ? Tuning_profile_path() : NULL ;
+      const char *path = (profile != NULL) ? profile : host ;
+      if (path == NULL) errx(1, "no profile: give one by --profile") ;
+      Tuning_detect( &geometry ) ;
+      fprintf( stderr, "caches: line %zu, L1D %zu, L2 %zu, L3 %zu bytes\n", geometry.line, geometry.l1d, geometry.l2, geometry.l3 ) ;
+      Tuning_autotune( nthreads, &tuning, stderr ) ;
+      printf( "ca_block %zu\nco_leaf %zu\npar_tile %zu\n", tuning.ca_block, tuning.co_leaf, tuning.par_tile ) ;
+      if (Tuning_save( path, &geometry, &tuning ) != 0) err(1, "%s", path) ;
+      fprintf( stderr, "profile written in %s\n", path ) ;
+      free( host ) ;
+      return 0 ;
+   }
+   Scoring_set( &scoring ) ; /* after the autotuning, measured with the costs of Globals.h */
+   if (mem_limit != NULL) 
+   {  double size ; 
+      char unit = '\0' ;
+      if ((sscanf( mem_limit, "%lf%c", &size, &unit ) < 1) || (size < 1) || ((unit != '\0') && (strchr( "KMG", unit ) == NULL)))
+         errx(1, "invalid memory limit: %s", mem_limit) ;
+      for (const char *u = "KMG"; (unit != '\0') && (*u != '\0'); ++u) 
+      {  size *= 1024 ;
+         if (*u == unit) break ;
+      }
+      options.mem_limit = (size_t) size ;
+   }
+   else options.mem_limit = Engine_memory() ;
+   if ((options.engine != ENGINE_AUTO) && ! Engine_available( options.engine, options.max_distance ))
+      errx(1, "engine %s is not available %s", Engine_name( options.engine ), 
+              (options.engine == ENGINE_BANDED) ? "without --max-distance" : "with these costs") ;
+   if ((options.engine != ENGINE_AUTO) && options.align) errx(1, "--engine is not available with --align") ;
+   if ((_scoring.model != SCORING_DEFAULT) && options.align) errx(1, "--scoring is not available with --align") ;
+   if (counters && (options.align || matrix || (manifest != NULL))) 
+      errx(1, "--counters is not available with --align, --batch and --matrix") ;
+   if ((checkpoint_path == NULL) && resume) errx(1, "--resume needs --checkpoint") ;
+   if ((checkpoint_path != NULL) && (options.align || matrix || (manifest != NULL)))
+      errx(1, "--checkpoint is not available with --align, --batch and --matrix") ;
+   if (checkpoint_path != NULL)
+   {  if (options.engine == ENGINE_AUTO) 
+         options.engine = Engine_available( ENGINE_DIFF, options.max_distance ) ? ENGINE_DIFF : ENGINE_LS ;
+      if ((options.engine != ENGINE_LS) && (options.engine != ENGINE_DIFF))
+         errx(1, "--checkpoint is only available with the engines ls and diff") ;
    }
+   if (stripe.count > 0)
+   {  if (options.align || matrix || (manifest != NULL) || (checkpoint_path != NULL))
+         errx(1, "--stripe is not available with --align, --batch, --matrix and --checkpoint") ;
+      if ((options.engine != ENGINE_AUTO) && (options.engine != ENGINE_STRIPED)) errx(1, "--stripe is only available with the engine striped") ;
+      if ((stripe.index > 0) && (stripe.upstream == NULL)) errx(1, "--stripe=%d/%d needs --upstream", stripe.index, stripe.count) ;
+      if ((stripe.index + 1 < stripe.count) && (stripe.downstream == NULL)) errx(1, "--stripe=%d/%d needs --downstream", stripe.index, stripe.count) ;
+      options.engine = ENGINE_STRIPED ;
+      _stripe = &stripe ;
+   }
+   else if ((stripe.upstream != NULL) || (stripe.downstream != NULL)) errx(1, "--upstream and --downstream need --stripe") ;
+   if ((options.anchor > 0) && (options.align || (checkpoint_path != NULL) || (stripe.count > 0)))
+      errx(1, "--anchor is not available with --align, --checkpoint and --stripe") ;
+   if ((progress > 0) && (options.align || matrix || (manifest != NULL)))
+      errx(1, "--progress is not available with --align, --batch and --matrix") ;
+   if ((progress > 0) && ! index) Progress_open( progress, progress_path ) ;
+   if (counters && (PerfCounters_open() == 0)) 
+      warnx("no counter is available (cf /proc/sys/kernel/perf_event_paranoid)") ;
 
-   int fd[2]; // The 2 fles descriptor correspoding for file1 and file2 
-   char *mmap_fd[2] ; // adress in virtual memory of file fd[i] 
-   long mmap_length[2] ; // length of the mapping in virtual memory of file fd[i] 
-   char *seq[2] ; // corresponding genetic sequence to file[i]*/
-   long length[2] ; // the length of corresponding genetic sequence seq[i] */
+   if (index) 
+   {  for (int f = optind; f < argc; ++f) 
+      {  struct SequenceFile *file = SequenceFile_open( argv[f] ) ;
+         size_t size = strlen( argv[f] ) + 5 ;
+         char *name = (char *) malloc( size ) ;
+         if (name == NULL) { perror("malloc"); exit(EXIT_FAILURE); }
+         snprintf( name, size, "%s.fai", argv[f] ) ;
+         file->index = FastaIndex_build( file ) ;
+         if (FastaIndex_save( file->index, name ) != 0) err(1, "%s", name) ;
+         free( name ) ;
+      }
+      SequenceFile_close_all() ;
+      return 0 ;
+   }
 
-   for (int i=0 ; i < 2; ++i, argv+=3) // defines content and length of seq[i] for i=0..1 
-   {
-      fd[i] = open(argv[1], O_RDONLY);
-      if (fd[i] == -1) err(1,"open");
-      struct stat s;
-      if (fstat(fd[i], &s) == -1) err(1, "fstat") ;
-      mmap_fd[i] = (char *) mmap(NULL,  s.st_size, PROT_READ, MAP_PRIVATE, fd[i], 0);
-      if (mmap_fd[i] == MAP_FAILED) err(1, "mmap") ;
-      mmap_length[i] = (long) s.st_size ;
-   
-
-      {  // Assign seq[i] to the begining of the sequence, excluding comment lines starting by '<' 
-         long debut; sscanf( argv[2], "%ld", &debut ) ; 
-         seq[i] = mmap_fd[i] + debut ; // beginning of the sequence
-         long n_exceed = mmap_length[i] - debut; 
-         if ( n_exceed < 0) 
-         {  fprintf( stderr, "Error: given sequence beginning %ld exceeds end of file of %ld bytes.\n",
-                              debut, n_exceed ) ;
-            exit( 1 ) ;
-         }
-         if (*seq[i] == '>') /* Skip and print the first line starting by '<' */
-         {  char *endofline = strchr(seq[i], '\n' ) ;
-            fprintf( stderr, "Sequence comment in preamble: " ) ;
-            for( char* c = seq[i]; c <=  endofline; ++c) fprintf(stderr, "%c", *c );
-            if (*endofline == '\n') seq[i] = endofline + 1; // first character of next line
-         }
+   if (matrix) 
+   {  int nfiles = argc - optind ;
+      if ((nfiles < 1) || (nfiles > 2) || (manifest != NULL))
+      {   usage_and_spec(argc - optind + 1, argv) ;
+          exit(EXIT_FAILURE);
       }
- 
-      {  // assign length[i] to the given length for seq[i] 
-         sscanf( argv[3], "%ld", &length[i] ) ;
-         long n_exceed = mmap_fd[i] + mmap_length[i] -1 - ( seq[i] + length[i] )  ; 
-         if ( n_exceed < 0) 
-         {   fprintf( stderr, "Warning: given sequence length %ld exceeds end of file of %ld bytes; "
-                              "sequence length is truncated to %ld.\n",
-                              length[i], -n_exceed, length[i] + n_exceed ) ;
-             length[i] = length[i] + n_exceed ;
-         }
+      if (options.align) errx(1, "--align is not available with --matrix") ;
+      struct SequenceFile *file[2] ;
+      for (int f = 0; f < nfiles; ++f) file[f] = SequenceFile_open( argv[optind + f] ) ;
+      if ((nfiles == 2) && (file[0] == file[1])) nfiles = 1 ; /* the same file: its records only once */
+      Matrix_run( file, nfiles, &options, nthreads, matrix_format ) ;
+      SequenceFile_close_all() ;
+      return 0 ;
+   }
+
+   if (manifest != NULL) 
+   {  if (argc != optind) 
+      {   usage_and_spec(argc - optind + 1, argv) ;
+          exit(EXIT_FAILURE);
       }
+      FILE *f = (strcmp( manifest, "-" ) == 0) ? stdin : fopen( manifest, "r" ) ;
+      if (f == NULL) err(1, "%s", manifest) ;
+      Batch_run( f, manifest, &options, nthreads ) ;
+      if (f != stdin) fclose( f ) ;
+      SequenceFile_close_all() ;
+      return 0 ;
+   }
 
-      {  /* Print on stderr either the full sequence is length[i]<40 or the first twenty and last twenty characters of the sequence */ 
-         if (length[i] <= 40)
-         { for (char* c=seq[i]; (c < seq[i]+length[i]); ++c) fprintf(stderr, "%c", *c) ;
-         }
-         else
-         { { for (char* c=seq[i]; (c < seq[i]+20); ++c) fprintf(stderr, "%c", *c) ; }
-           fprintf(stderr, "..." );
-           { for (char* c=seq[i]+length[i]-20; (c < seq[i]+length[i]); ++c) fprintf(stderr, "%c", *c) ; }
+   if ((argc - optind != 6) && !((argc - optind == 2) && FastaIndex_is_region( argv[optind] ) && FastaIndex_is_region( argv[optind+1] )))
+   {   usage_and_spec(argc - optind + 1, argv) ;
+       exit(EXIT_FAILURE);
+   }
+
+   if ((argc - optind == 6) && (SequenceStream_is_stream( argv[optind] ) || SequenceStream_is_stream( argv[optind+3] )))
+   {  // at least one sequence from stdin or a pipe: packed while it is read, the chars are not kept
+      if (options.align) errx(1, "--align is not available with a sequence read from a stream") ;
+      argv += optind ; // argv[3*i .. 3*i+2] are the positional arguments of seq[i]
+      struct PackedSequence packed[2] ;
+      struct SequenceStream *stream[2] = { NULL, NULL } ;
+      long begin[2], length[2] ;
+      for (int i=0 ; i < 2; ++i)
+      {  if (SequenceStream_is_stream( argv[3*i] )) stream[i] = SequenceStream_open( argv[3*i] ) ;
+         sscanf( argv[3*i+1], "%ld", &begin[i] ) ; 
+         sscanf( argv[3*i+2], "%ld", &length[i] ) ;
+      }
+      // a stream is read once: two sequences of the same stream are read in the order of their positions
+      int swap = (stream[0] != NULL) && (stream[0] == stream[1]) && (begin[1] < begin[0]) ;
+      for (int k=0 ; k < 2; ++k)
+      {  int i = k ^ swap ;
+         if (stream[i] != NULL) SequenceStream_sequence( stream[i], begin[i], &length[i], 1, &packed[i] ) ;
+         else 
+         {  struct SequenceFile *file = SequenceFile_open( argv[3*i] ) ;
+            char *seq = SequenceFile_sequence( file, begin[i], &length[i], 1 ) ;
+            Packed_init( &packed[i], seq, length[i] ) ;
          }
-         fprintf(stderr, "\n" );
       }
-   } 
+      SequenceStream_close_all() ; // the rest of the streams is not read
 
-   long res = EditDistance_CO(seq[0], length[0], seq[1], length[1]);
+      int status = Main_Run( &options, packed, NULL, NULL, NULL, checkpoint_path, checkpoint_interval, resume, counters ) ;
+      Packed_free( &packed[0] ) ;
+      Packed_free( &packed[1] ) ;
+      return status ;
+   }
 
-   {  for( int i = 0; i < 2; ++i ) 
-      {  if (munmap( mmap_fd[i], (off_t) mmap_length[i]) != 0)  err(1, "munmap") ; 
-         if (close( fd[i] ) != 0)  err(1, "close") ; 
-      }
+   struct SequenceFile *file[2] ; // file[i] mapped in virtual memory (once if file_1 and file_2 are the same)
+   char *seq[2] ; // corresponding genetic sequence to file[i]*/
+   long length[2] ; // the length of corresponding genetic sequence seq[i] */
+
+   if (argc - optind == 2) // regions file:record[:start-end]
+   {  for (int i=0 ; i < 2; ++i) seq[i] = FastaIndex_region( argv[optind+i], &file[i], &length[i], 1 ) ;
+   }
+   else 
+   {  argv += optind - 1 ; // argv[1 .. 6] are the positional arguments
+      for (int i=0 ; i < 2; ++i, argv+=3) // defines content and length of seq[i] for i=0..1 
+      {  file[i] = SequenceFile_open( argv[1] ) ;
+         long debut; sscanf( argv[2], "%ld", &debut ) ; 
+         sscanf( argv[3], "%ld", &length[i] ) ;
+         seq[i] = SequenceFile_sequence( file[i], debut, &length[i], 1 ) ;
+      } 
    }
 
-   printf("%ld\n", res ) ; // print the distance on stdout
-   return 0 ;
+   return Main_Run( &options, NULL, file, seq, length, checkpoint_path, checkpoint_interval, resume, counters ) ;
 }
 
@@ -0,0 +1,8 @@
+# blocking parameters of distanceEdition, measured by distanceEdition --autotune
+line 64
+l1d 49152
+l2 2097152
+l3 110100480
+ca_block 32
+co_leaf 256
+par_tile 64